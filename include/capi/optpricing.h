@@ -0,0 +1,104 @@
+/* optpricing.h: Flat C ABI over the pricers (liboptpricing.so) for numpy / ByteBuffer callers */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define OP_API __declspec(dllexport)
+#else
+#define OP_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped on any incompatible change to the functions or structs below. */
+#define OP_ABI_VERSION 1
+
+/* Contract enums, passed as int32_t arrays */
+enum { OP_CALL = 0, OP_PUT = 1 };
+enum { OP_EUROPEAN = 0, OP_AMERICAN = 1 };
+
+/* American engine (European rows always use the Black-Scholes closed form) */
+enum {
+    OP_ENGINE_TREE = 0,         /* CRR tree with the row's N (or the context default) */
+    OP_ENGINE_ALO_FAST = 1,     /* Andersen-Lake-Offengelt, ~1e-4 for 2r/sigma^2 < 5 */
+    OP_ENGINE_ALO_ACCURATE = 2  /* Andersen-Lake-Offengelt, ~1e-8 for 2r/sigma^2 < 5, ~1e-3 near 10 */
+};
+
+/* Status codes: returned by every call, and written per row into op_outputs::status */
+enum {
+    OP_OK = 0,
+    OP_ERR_NULL_ARGUMENT = 1,   /* a required pointer is NULL */
+    OP_ERR_INVALID_INPUT = 2,   /* bad parameter or row (non-positive S0/K/T/sigma, unknown enum, ...) */
+    OP_ERR_NO_CONVERGENCE = 3,  /* implied vol could not bracket or converge */
+    OP_ERR_INTERNAL = 4,        /* unexpected failure (e.g. allocation) */
+    OP_ERR_ROWS_FAILED = 5,     /* call-level only: at least one row's status is not OP_OK */
+    OP_ERR_UNSUPPORTED = 6      /* valid row the engine cannot serve (Greeks of a truncated tree) */
+};
+
+/* Opaque pricing configuration. A context is read-only during op_price / op_implied_vol, so
+   one context may serve concurrent calls; setters must not race with them. */
+typedef struct op_context op_context;
+
+/* Structure-of-arrays view of n contracts. Every array is caller-owned, contiguous and read in
+   place. `steps` may be NULL (context default for every row); `sigma` is ignored by
+   op_implied_vol. */
+typedef struct {
+    const double* S0;
+    const double* K;
+    const double* T;
+    const double* r;
+    const double* q;
+    const double* sigma;
+    const int32_t* type;      /* OP_CALL / OP_PUT */
+    const int32_t* exercise;  /* OP_EUROPEAN / OP_AMERICAN */
+    const int32_t* steps;     /* tree steps N per row, <= 0 means context default */
+} op_inputs;
+
+/* Caller-owned output arrays of length n; any may be NULL and is then neither computed nor
+   written. Greeks are per 1.0 change (vega per 1.0 vol, rho per 1.0 rate, theta per year).
+   American rows follow the context's engine: on the tree, price and Greeks come from one
+   adjoint sweep of the row's lattice (gamma and theta from its step-2 nodes; a truncated
+   lattice with Greeks requested fails with OP_ERR_UNSUPPORTED); on ALO, Greeks are central
+   differences of the ALO price. A failed row has NaN in every requested output. */
+typedef struct {
+    double* price;
+    double* delta;
+    double* gamma;
+    double* vega;
+    double* theta;
+    double* rho;
+    int32_t* status;
+} op_outputs;
+
+OP_API int32_t op_abi_version(void);
+OP_API const char* op_status_string(int32_t status);
+
+/* Defaults: 1 thread, 200 tree steps, full lattice, OP_ENGINE_TREE, IV tolerance 1e-8.
+   Returns NULL on allocation failure. */
+OP_API op_context* op_context_create(void);
+OP_API void op_context_destroy(op_context* ctx);
+
+/* Rows are split across `threads` workers; 0 = hardware concurrency */
+OP_API int32_t op_context_set_threads(op_context* ctx, uint32_t threads);
+OP_API int32_t op_context_set_tree_steps(op_context* ctx, int32_t steps);
+/* Truncated lattice half-width in standard deviations (0 = full lattice), see TreeParams */
+OP_API int32_t op_context_set_truncation(op_context* ctx, double stddevs);
+OP_API int32_t op_context_set_american_engine(op_context* ctx, int32_t engine);
+/* Implied vol tolerance in sigma */
+OP_API int32_t op_context_set_iv_tolerance(op_context* ctx, double tol_sigma);
+
+/* Prices (and Greeks, if requested) n contracts. Returns OP_OK, OP_ERR_ROWS_FAILED (see
+   out->status), or a call-level error, in which case nothing is written. */
+OP_API int32_t op_price(const op_context* ctx, size_t n, const op_inputs* in, op_outputs* out);
+
+/* Implied vol of n quotes: European rows under Black-Scholes, American rows matched on the
+   CRR tree (row N or context default). `status` may be NULL. */
+OP_API int32_t op_implied_vol(const op_context* ctx, size_t n, const op_inputs* in,
+                              const double* target_price, double* iv, int32_t* status);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
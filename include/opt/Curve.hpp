@@ -0,0 +1,49 @@
+// Curve.hpp: Piecewise-flat / piecewise-linear rate curves with O(1) cumulative-integral lookup
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace opt {
+    enum class CurveInterp { PiecewiseFlat, PiecewiseLinear };
+
+    // Instantaneous rate r(t) (short rate, or dividend yield) given at knots 0 < t_0 < ... < t_n.
+    // PiecewiseFlat: r(t) = r_i on (t_{i-1}, t_i] (r_0 from 0), PiecewiseLinear: linear between
+    // knots, r_0 before t_0. Both hold the last rate beyond t_n. The integral of r up to each knot
+    // is precomputed, so integral(T), and with it discount and forward factors, costs a bucket
+    // lookup and a few flops.
+    class Curve {
+    public:
+        Curve() : Curve(0.0) {}
+        explicit Curve(double flat_rate);
+        Curve(std::vector<double> times, std::vector<double> rates, CurveInterp interp = CurveInterp::PiecewiseFlat);
+
+        double rate(double t) const;            // r(t)
+        double integral(double T) const;        // int_0^T r(t) dt
+        double zero_rate(double T) const;       // integral(T) / T, r(0) at T = 0
+        double discount(double T) const;        // exp(-integral(T)), from the knot discount factors
+
+        // Single-maturity lookups throw on a negative or non-finite T.
+        // One pass over n maturities; no input validation (T >= 0 expected, NaN gives NaN)
+        void integral_batch(std::size_t n, const double* T, double* out) const;
+        void discount_batch(std::size_t n, const double* T, double* out) const;
+
+        bool flat() const { return t_.size() == 1; }
+        const std::vector<double>& times() const { return t_; }
+        const std::vector<double>& rates() const { return r_; }
+
+    private:
+        std::size_t segment(double T) const; // first knot index j with T <= t_j (n if past the end or NaN)
+        double integral_unchecked(double T) const;
+        double tail(std::size_t j, double T) const; // int_{t_{j-1}}^T r, 0 < j < n
+        // Discount factor of the knot at or below T; `increment` gets the integral from there to T
+        double discount_base(double T, double& increment) const;
+        static void check_time(double T);
+
+        CurveInterp interp_ = CurveInterp::PiecewiseFlat;
+        std::vector<double> t_, r_;
+        std::vector<double> I_;          // integral up to each knot
+        std::vector<double> D_;          // exp(-I_)
+        double bucket_scale_ = 0.0;      // buckets per unit time over [0, t_n]
+        std::vector<std::size_t> bucket_; // first knot of each bucket, plus one past the last
+    };
+} // namespace opt
@@ -0,0 +1,66 @@
+// LocalVol.hpp: Local volatility sigma(S, t) on a grid, given directly or derived from an implied-vol surface (Dupire)
+#pragma once
+#include "opt/VolSurface.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace opt {
+    // Grid for LocalVolSurface::from_implied. Times: the surface's expiries up to t_max, plus t_max,
+    // with about time_nodes rows shared out between the gaps in proportion to their length. Spots:
+    // uniform in ln(S / F(t)), F(t) = S0 e^{(r - q) t}, over [y_lo, y_hi] at t_max (narrower at
+    // earlier t, in proportion to sqrt(t / t_max), but never below min_width either side).
+    struct LocalVolGridParams {
+        double t_max = 0.0;       // 0 = the surface's last expiry
+        std::size_t time_nodes = 40;
+        double y_lo = -2.0;
+        double y_hi = 2.0;
+        double min_width = 0.25;
+        std::size_t spot_nodes = 121;
+        double vol_floor = 0.01;  // local vols are clamped to [vol_floor, vol_cap]
+        double vol_cap = 3.0;
+    };
+
+    // sigma(S, t) tabulated in rows: row i applies for t in (t_{i-1}, t_i] (row 0 from t = 0, the
+    // last row past the end), and is read linearly in ln S, flat past its ends. Piecewise constant
+    // in t keeps the jumps in local vol at the expiries of a surface that is linear in T between
+    // them. Spot nodes may differ per row (from_implied follows the forward), so each row carries
+    // its own spot axis.
+    class LocalVolSurface {
+    public:
+        // times increasing and positive; spots[i] increasing and positive with vols[i] the
+        // same length (one row per time)
+        LocalVolSurface(std::vector<double> times,
+                        std::vector<std::vector<double>> spots,
+                        std::vector<std::vector<double>> vols);
+
+        static LocalVolSurface flat(double sigma);
+
+        // Dupire's formula on the surface's total variance w(y, T), y = ln(K / F(T)):
+        //   sigma^2 = w_T / (1 - y w_y / w + (-1/4 - 1/w + y^2 / w^2) w_y^2 / 4 + w_yy / 2)
+        // with the derivatives taken by central differences at the middle of each row's interval.
+        // F uses the market r and q, so the local vol is consistent with a PDE driven by the same
+        // rates. Where the surface admits arbitrage (w_T <= 0 or a non-positive denominator) the
+        // local vol is clamped.
+        static LocalVolSurface from_implied(const VolSurface& iv,
+                                            double S0,
+                                            double r,
+                                            double q,
+                                            const LocalVolGridParams& p = {});
+
+        double sigma(double S, double t) const;
+
+        const std::vector<double>& times() const { return t_; }
+
+        // Nodes of the last from_implied build that hit vol_floor or vol_cap
+        std::size_t clamped() const { return clamped_; }
+
+    private:
+        double row_sigma(std::size_t i, double lnS) const;
+
+        std::vector<double> t_;
+        std::vector<std::vector<double>> lnS_;  // per time row
+        std::vector<std::vector<double>> vol_;
+        std::size_t clamped_ = 0;
+    };
+} // namespace opt
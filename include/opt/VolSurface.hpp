@@ -0,0 +1,105 @@
+// VolSurface.hpp: SVI smile calibration per expiry and a cached implied-vol surface sigma(K, T)
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace opt {
+    // Raw SVI total variance in log-forward-moneyness k = ln(K/F):
+    //   w(k) = a + b (rho (k - m) + sqrt((k - m)^2 + s^2))
+    struct SVIParams {
+        double a = 0.0;
+        double b = 0.0;
+        double rho = 0.0;
+        double m = 0.0;
+        double s = 0.1;
+
+        double w(double k) const;
+        double dw(double k) const; // dw/dk
+    };
+
+    // One expiry of an implied-vol chain. Empty weights means equal weights.
+    struct SmileSlice {
+        double T = 0.0;
+        double forward = 0.0;
+        std::vector<double> strikes;
+        std::vector<double> ivs;
+        std::vector<double> weights;
+    };
+
+    struct SVIFit {
+        SVIParams params;
+        double rmse_vol = 0.0; // root mean square implied-vol error over the slice
+        int iterations = 0;
+    };
+
+    struct SVICalibrationParams {
+        int max_iter = 100;
+        double tol = 1e-14;    // stop when the relative drop in squared error is below this
+        unsigned threads = 0;  // expiries fitted in parallel; 0 = hardware concurrency
+    };
+
+    // Lookup grid in k. Each expiry's smile is cached as total variance and its k-derivative at
+    // uniform nodes and read back by cubic Hermite interpolation, linearly extrapolated past the
+    // ends (SVI wings are linear in k).
+    struct VolGridParams {
+        double k_lo = -2.0;
+        double k_hi = 2.0;
+        std::size_t nodes = 161;
+    };
+
+    // Calibrated surface. Between expiries total variance is interpolated linearly in T at fixed
+    // k; the cached nodes are made non-decreasing in T (a slice lying below the previous one is
+    // lifted onto it), so the surface is free of calendar arbitrage at the nodes. Before the
+    // first expiry and after the last, total variance scales in proportion to T. Forwards are
+    // interpolated log-linearly in T between the slice forwards.
+    class VolSurface {
+    public:
+        // Levenberg-Marquardt on the weighted total-variance residuals with the analytic SVI
+        // Jacobian. Parameters are projected after every step onto b >= 0, |rho| < 1, s > 0,
+        // a + b s sqrt(1 - rho^2) >= 0 (non-negative variance) and b (1 + |rho|) <= 4 / T
+        // (Lee's wing bound). With no guess the start comes from the chain's minimum and wing slopes.
+        static SVIFit fit_svi(const SmileSlice& slice,
+                              const SVICalibrationParams& p = {},
+                              const SVIParams* guess = nullptr);
+
+        // Fits every slice (in parallel) and builds the lookup cache. Slices need not be sorted.
+        static VolSurface calibrate(const std::vector<SmileSlice>& slices,
+                                    const SVICalibrationParams& p = {},
+                                    const VolGridParams& grid = {});
+
+        // Refits a new snapshot of the same expiries, starting each slice from its current fit
+        void recalibrate(const std::vector<SmileSlice>& slices, const SVICalibrationParams& p = {});
+
+        double forward(double T) const;
+        double total_variance(double K, double T) const;
+        double sigma(double K, double T) const;
+
+        // sigma for n (K, T) pairs, e.g. into AnalyticBS::price_batch
+        void sigma_batch(std::size_t n, const double* K, const double* T, double* out) const;
+
+        const std::vector<double>& expiries() const { return T_; }
+        const std::vector<SVIFit>& fits() const { return fits_; }
+
+        // Nodes lifted to remove calendar arbitrage in the last build
+        std::size_t calendar_repairs() const { return repairs_; }
+
+    private:
+        void build_cache();
+        void fit_all(const std::vector<SmileSlice>& slices, const SVICalibrationParams& p, bool warm);
+        std::size_t bracket(double T) const;
+        double slice_w(std::size_t i, double k) const;
+
+        VolGridParams grid_;
+        double dk_ = 0.0;
+        std::vector<double> T_;        // sorted expiries
+        std::vector<double> lnF_;      // ln forward per expiry
+        std::vector<SVIFit> fits_;
+        std::vector<double> w_, dw_;   // [expiry][node] cached total variance and slope
+        std::size_t repairs_ = 0;
+
+        // Uniform buckets over [T_front, T_back] holding the slice at or below the bucket start,
+        // so bracket() is a table read plus at most a step or two forward
+        double bucket_scale_ = 0.0;
+        std::vector<std::size_t> bucket_;
+    };
+} // namespace opt
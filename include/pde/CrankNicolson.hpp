@@ -0,0 +1,69 @@
+// CrankNicolson.hpp: Crank-Nicolson local-volatility pricer with precomputed per-step coefficient tables
+#pragma once
+#include "opt/LocalVol.hpp"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace pde {
+
+struct CrankNicolsonParams {
+    int space_nodes = 400;  // intervals in x = ln S (backward) or ln K (forward)
+    int time_steps = 200;   // over [0, T_max], shared out between maturities (at least 2 each)
+    double width = 4.0;     // grid spans ln S0 +- width * sigma_ref sqrt(T_max), sigma_ref the
+                            // largest local vol at S0 over the grid's times
+    bool damping = true;    // Rannacher: the first step of each solve as two implicit half steps
+    unsigned threads = 1;   // backward solves in price_all are split over this many threads
+};
+
+// Prices under dS = (r - q) S dt + sigma(S, t) S dW on one uniform grid in ln S and one time grid
+// whose nodes include every maturity in the set. The constructor evaluates the local vol once per
+// node and step and stores, per step, the bands of the explicit half (I + dt/2 L) and the LU
+// factors of the implicit half (I - dt/2 L) in one contiguous block, for the backward operator
+//   L V = sigma^2/2 V_xx + (r - q - sigma^2/2) V_x - r V                 (x = ln S)
+// and for the forward (Dupire) operator on call prices
+//   L C = sigma^2/2 C_yy - (r - q + sigma^2/2) C_y - q C                 (y = ln K).
+// A time step is then a fused explicit product and forward sweep followed by a back sweep,
+// with no vol lookups. Market::sigma is unused.
+class LocalVolPDE {
+public:
+    LocalVolPDE(const opt::LocalVolSurface& lv,
+                const opt::Market& m,
+                std::vector<double> maturities,
+                const CrankNicolsonParams& p = CrankNicolsonParams{});
+
+    // Backward solve from opt.T (one of the maturities) to today, interpolated at S0. American
+    // options are projected onto the payoff after every step.
+    double price(const opt::Option& opt) const;
+
+    // Every European contract from one forward Dupire solve (calls directly, puts by parity),
+    // and each American contract from its own backward solve. Results follow the input order.
+    std::vector<double> price_all(const std::vector<opt::Option>& contracts) const;
+
+    // Call prices on the grid's strikes at every maturity: calls[i * strikes().size() + j] is
+    // maturity i, strike j
+    std::vector<double> forward_calls() const;
+
+    const std::vector<double>& maturities() const { return maturities_; }
+    const std::vector<double>& times() const { return t_; }
+    std::vector<double> strikes() const;
+
+private:
+    static void check_inputs(const opt::Market& m, const std::vector<double>& maturities, const CrankNicolsonParams& p);
+    std::size_t maturity_index(double T) const;
+    void build_table(const opt::LocalVolSurface& lv, bool forward, std::vector<double>& table) const;
+    double interpolate(const double* u, double x) const;
+
+    opt::Market m_;
+    CrankNicolsonParams p_;
+    std::vector<double> maturities_;       // sorted, distinct
+    std::vector<std::size_t> mat_step_;    // time node of each maturity
+    std::vector<double> t_;                // time nodes, t_[0] = 0
+    double x0_ = 0.0, dx_ = 0.0;           // x_i = x0_ + i dx_
+    // [step][band][node], bands: explicit lower, diag, upper; implicit multiplier, 1 / pivot, upper
+    std::vector<double> backward_, forward_;
+};
+
+} // namespace pde
@@ -0,0 +1,32 @@
+// Tridiagonal.hpp: Factored tridiagonal systems (Thomas algorithm) for implicit finite-difference steps
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace pde {
+
+// LU factors of the n x n matrix with rows lower[i] x[i-1] + diag[i] x[i] + upper[i] x[i+1]
+// (lower[0] and upper[n-1] are ignored). Factoring once and solving many right-hand sides is
+// what ADI needs: every time step solves the same matrices again. There is no pivoting, so the
+// matrix should be diagonally dominant, as I - theta dt A is for the schemes in this directory.
+class Tridiagonal {
+public:
+    Tridiagonal() = default;
+    Tridiagonal(const std::vector<double>& lower, const std::vector<double>& diag, const std::vector<double>& upper);
+
+    std::size_t size() const { return inv_pivot_.size(); }
+
+    // In place: x holds the right-hand side on entry and the solution on return
+    void solve(double* x) const;
+
+    // In place on `count` right-hand sides side by side: element i of system k is at
+    // x[i * stride + k]. The inner loop runs over k, so contiguous systems vectorize.
+    void solve_many(double* x, std::size_t stride, std::size_t count) const;
+
+private:
+    std::vector<double> mult_;      // elimination multipliers lower[i] / pivot[i-1]
+    std::vector<double> inv_pivot_;
+    std::vector<double> upper_;
+};
+
+} // namespace pde
@@ -0,0 +1,18 @@
+// AdjointGreeks.hpp: Sensitivities produced by a single adjoint (reverse-mode) sweep
+#pragma once
+#include <limits>
+
+namespace pricers {
+    struct AdjointGreeks {
+        double price = 0.0; // Value of the contract
+        double delta = 0.0; // dV/dS0
+        double vega = 0.0;  // dV/dsigma (per unit vol)
+        double rho = 0.0;   // dV/dr (per 1.0 rate change)
+        double rho_q = 0.0; // dV/dq, dividend rho (per 1.0 yield change)
+
+        // Second-order and time sensitivities are not adjoint outputs; engines that can read
+        // them off their own pricing pass fill them in, others leave NaN
+        double gamma = std::numeric_limits<double>::quiet_NaN(); // d2V/dS0^2
+        double theta = std::numeric_limits<double>::quiet_NaN(); // dV/dt (per year)
+    };
+} // namespace pricers
@@ -1,8 +1,11 @@
 // AnalyticBS.hpp: Black-Scholes European Analytic Pricer
 #pragma once
+#include "opt/Curve.hpp"
 #include "opt/Market.hpp"
 #include "opt/Option.hpp"
 
+#include <cstddef>
+
 namespace pricers {
     struct Greeks {
         double delta = 0.0; // Sensitivity to underlying price
@@ -16,6 +19,38 @@ namespace pricers {
     public:
         static double price(const opt::Market& m, const opt::Option& opt);
         static Greeks greeks(const opt::Market& m, const opt::Option& opt);
+
+        // Price evaluated entirely in Real arithmetic (float or double)
+        template <typename Real>
+        static Real price_as(const opt::Market& m, const opt::Option& opt);
+
+        // Batch kernel over contiguous arrays (float or double); no input validation,
+        // callers are expected to pass positive S0, K, T, sigma.
+        template <typename Real>
+        static void price_batch(std::size_t n,
+                                const Real* S0, const Real* K, const Real* T,
+                                const Real* r, const Real* q, const Real* sigma,
+                                const opt::OptionType* type,
+                                Real* out);
+
+        // Term-structure rates: m.r and m.q are ignored and the discount factors come from the
+        // curves (a European price depends only on the integrated rates to expiry)
+        static double price(const opt::Market& m, const opt::Option& opt,
+                            const opt::Curve& r, const opt::Curve& q);
+
+        // Batch kernel on precomputed discount factors Dr = e^{-int r}, Dq = e^{-int q}; no validation
+        static void price_batch_discounted(std::size_t n,
+                                           const double* S0, const double* K, const double* T,
+                                           const double* Dr, const double* Dq, const double* sigma,
+                                           const opt::OptionType* type,
+                                           double* out);
+
+        // Batch over curves: one discount pass per curve, then the discounted kernel
+        static void price_batch(std::size_t n,
+                                const double* S0, const double* K, const double* T,
+                                const opt::Curve& r, const opt::Curve& q, const double* sigma,
+                                const opt::OptionType* type,
+                                double* out);
     
     private:
         static void check_inputs(const opt::Market& m, const opt::Option& opt);
@@ -0,0 +1,54 @@
+// AndersenLakeOffengelt.hpp: High-accuracy American pricer (Andersen-Lake-Offengelt 2016)
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <vector>
+
+namespace pricers {
+
+struct ALOParams {
+    int collocation_nodes = 24; // n: Chebyshev nodes for the exercise boundary (in sqrt(tau))
+    int iterations = 8;         // m: fixed-point (FP-B) iterations on the boundary
+    int quadrature_nodes = 32;  // l: Gauss-Legendre nodes for the boundary integrals
+    int pricing_nodes = 48;     // p: Gauss-Legendre nodes for the final premium integral
+
+    // Accuracies below are for kappa = 2 r / sigma^2 (2 q / sigma^2 for calls) under 5, with
+    // S0 and K near 100. The boundary steepens near expiry as kappa grows, and both presets lose
+    // accuracy: accurate() is off by up to ~1e-3 at kappa 10 and ~5e-3 beyond, fast() by a few
+    // times that. Pass more nodes for such contracts.
+
+    // Screening preset: ~1e-4 or better at under a tenth of the cost
+    static ALOParams fast() { return ALOParams{8, 4, 12, 24}; }
+    // Production preset: ~1e-8 accuracy
+    static ALOParams accurate() { return ALOParams{24, 8, 32, 48}; }
+    // Reference preset for validating other engines: converged at every kappa surveyed (to
+    // ~1e-5 of a fine Crank-Nicolson solve up to kappa 40), at tens of times the cost
+    static ALOParams reference() { return ALOParams{64, 32, 128, 256}; }
+};
+
+// Solves the integral equation for the early-exercise boundary B(tau) by spectral
+// collocation: H(sqrt(tau)) = ln(B/X)^2 is Chebyshev-interpolated, refined by FP-B
+// fixed-point iterations from a QD initial guess, and the American premium is then a
+// one-dimensional integral over the boundary.
+class AndersenLakeOffengelt {
+public:
+    static double price(const opt::Market& m,
+                        const opt::Option& opt,
+                        const ALOParams& p = ALOParams{});
+
+    // Exercise boundary B(tau) at the requested times to maturity (same units as S0/K)
+    static std::vector<double> exercise_boundary(const opt::Market& m,
+                                                 const opt::Option& opt,
+                                                 const std::vector<double>& taus,
+                                                 const ALOParams& p = ALOParams{});
+
+private:
+    static void check_inputs(const opt::Market& m, const opt::Option& opt, const ALOParams& p);
+
+    // American put (calls are mapped through put-call symmetry)
+    static double put_price(double S, double K, double T, double r, double q, double sigma,
+                            const ALOParams& p);
+};
+
+} // namespace pricers
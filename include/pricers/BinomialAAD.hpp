@@ -0,0 +1,51 @@
+// BinomialAAD.hpp: Adjoint Greeks for the CRR tree (backward induction + reverse sweep)
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AdjointGreeks.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <vector>
+
+namespace pricers {
+
+struct AADParams {
+    // Store one value layer every `checkpoint_every` steps during the pricing sweep and
+    // recompute the layers in between during the reverse sweep.
+    // 0 => ceil(sqrt(N)), which keeps memory at O(N^1.5) instead of O(N^2).
+    int checkpoint_every = 0;
+};
+
+class BinomialAAD {
+public:
+    // Price plus delta, vega, rho and dividend rho from one reverse sweep of the
+    // CRR induction. Handles European and American exercise (opt.exercise). Gamma and theta
+    // are the usual lattice estimates from the three step-2 nodes of the pricing sweep
+    // (NaN for N < 2). Full lattice and serial: TreeParams::threads and exercise_region are
+    // ignored, and a non-zero truncation_stddevs is rejected.
+    static AdjointGreeks greeks(const opt::Market& m,
+                                const opt::Option& opt,
+                                const TreeParams& p,
+                                const AADParams& ap = AADParams{});
+
+private:
+    struct Coefs {
+        double sqrt_dt = 0.0;
+        double dt = 0.0;
+        double u = 0.0;
+        double d = 0.0;
+        double g = 0.0;    // exp((r-q)*dt), one-step forward growth
+        double pu = 0.0;
+        double pd = 0.0;
+        double disc = 0.0; // exp(-r*dt)
+    };
+
+    static Coefs make_coefs(const opt::Market& m, const opt::Option& opt, const TreeParams& p);
+
+    // Roll the layer at step+1 (size step+2) back to step (size step+1). S is the tree's node-price
+    // table (BinomialCRR::node_prices) for N steps.
+    static void roll_back(const Coefs& c, const double* S, int N, const opt::Option& opt, int step,
+                          const std::vector<double>& next, std::vector<double>& out);
+};
+
+} // namespace pricers
@@ -1,12 +1,48 @@
 // BinonialCRR.hpp: Binomial Cox-Ross-Rubinstein (CRR) option pricing model
 #pragma once
+#include "opt/Curve.hpp"
 #include "opt/Market.hpp"
 #include "opt/Option.hpp"
 
+#include <vector>
+
 namespace pricers {
 
 struct TreeParams {
     int steps = 200;   // N
+
+    // Truncated lattice: only nodes within +/- k standard deviations of spot (in log-price over
+    // the full maturity) are rolled back; nodes on the band edges are set analytically
+    // (0 out of the money, forward/intrinsic value in the money). 0 disables truncation.
+    // The band holds ~2k*sqrt(N) nodes, so work drops from O(N^2) to O(k N^1.5).
+    double truncation_stddevs = 0.0;
+
+    // > 1: run the backward induction on this many threads as a wavefront over cache-sized tiles
+    // (full lattice only; a truncated lattice stays serial), capped at the hardware thread count
+    // and the number of tile columns. Prices are bit-identical to the serial induction for any
+    // thread count.
+    unsigned threads = 1;
+
+    // American inductions track the early-exercise boundary from step to step instead of taking
+    // max(exercise, hold) at every node: each row runs the plain continuation recurrence, the
+    // boundary index is moved by comparing only the nodes next to it, and the exercise run is
+    // filled with intrinsic values. Same prices as the max() induction up to rounding (nodes
+    // where exercise and hold tie may go either way); serial only (ignores threads).
+    bool exercise_region = false;
+};
+
+// Early-exercise boundary of an American tree. At step k (time t[k] = k dt) a put is exercised
+// at every node priced at or below S[k], a call at every node at or above it. NaN where no
+// node of the step is exercised.
+struct ExerciseBoundary {
+    std::vector<double> t;
+    std::vector<double> S;
+};
+
+// Scratch storage for repeated tree evaluations (e.g. inside a root finder). The value layer
+// only grows, so a solver that reprices at the same or smaller N allocates once.
+struct TreeWorkspace {
+    std::vector<double> values;
 };
 
 class BinomialCRR {
@@ -21,11 +57,118 @@ public:
                                  const opt::Option& opt,
                                  const TreeParams& p);
 
+    // Same as above with the value layer taken from (and left in) `ws`
+    static double price_european(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p,
+                                 TreeWorkspace& ws);
+
+    static double price_american(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p,
+                                 TreeWorkspace& ws);
+
+    // American price plus the exercise boundary (N entries, steps 0..N-1); always runs the
+    // exercise-region induction
+    static double price_american(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p,
+                                 ExerciseBoundary& boundary);
+
+    // Same inductions with the value layer stored and rolled back in Real (float or double).
+    // Node prices and payoffs are always generated in double and rounded once into the
+    // layer, so the float variants only lose precision in the rollback itself.
+    template <typename Real>
+    static Real price_european_as(const opt::Market& m,
+                                  const opt::Option& opt,
+                                  const TreeParams& p);
+
+    template <typename Real>
+    static Real price_american_as(const opt::Market& m,
+                                  const opt::Option& opt,
+                                  const TreeParams& p);
+
+    // Time-dependent rates: m.r and m.q are ignored and each step takes its own discount and
+    // up-probability from the curves. The lattice spacing still comes from m.sigma, so nodes do
+    // not move; only the probabilities change from step to step.
+    static double price_european(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p,
+                                 const opt::Curve& r,
+                                 const opt::Curve& q);
+
+    static double price_american(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p,
+                                 const opt::Curve& r,
+                                 const opt::Curve& q);
+
+    // American rollback stopped at step `stop` (0 <= stop <= N) of the full lattice: `layer`
+    // receives the stop + 1 node values of that step in money of that time, node i at spot
+    // S0 u^(2i - stop). stop = 0 gives price_american on the full lattice. Serial; threads,
+    // truncation and exercise_region are not used.
+    static void price_american_layer(const opt::Market& m,
+                                     const opt::Option& opt,
+                                     const TreeParams& p,
+                                     int stop,
+                                     std::vector<double>& layer);
+
+    // Node prices S0 u^j for j = -N..N, stored at out[j + N]: node (step, i) is out[2i - step + N].
+    // Every induction over an N-step lattice with spacing u, d = 1/u reads its node prices from
+    // this table, so a node's price does not depend on which row segment computes it.
+    static void node_prices(double S0, double u, double d, int N, std::vector<double>& out);
+
 private:
+    friend class LeisenReimer; // shares induct_row
+
     static void check_inputs(const opt::Market& m,
                              const opt::Option& opt,
                              const TreeParams& p);
 
+    // Inductions on a caller-owned value layer (resized to at least N + 1). `Steps` supplies the
+    // per-step rates (see BinomialCRR.cpp): constant for flat r and q, arrays for curves.
+    template <typename Real, typename Steps>
+    static Real rollback_european(const opt::Market& m,
+                                  const opt::Option& opt,
+                                  const TreeParams& p,
+                                  const Steps& steps,
+                                  std::vector<Real>& values);
+
+    template <typename Real, typename Steps>
+    static Real rollback_american(const opt::Market& m,
+                                  const opt::Option& opt,
+                                  const TreeParams& p,
+                                  const Steps& steps,
+                                  std::vector<Real>& values);
+
+    // Exercise-region American induction (TreeParams::exercise_region). If `boundary` is not
+    // null it receives the boundary node price of each step 0..N-1 (NaN without exercise).
+    template <typename Real, typename Steps>
+    static Real rollback_american_region(const opt::Market& m,
+                                         const opt::Option& opt,
+                                         const TreeParams& p,
+                                         const Steps& steps,
+                                         std::vector<Real>& values,
+                                         double* boundary);
+
+    // Multithreaded full-lattice induction. In skewed columns c = i + (N - step) node (step, i)
+    // depends on columns c - 1 and c of step + 1, so tiles of a band of steps by a block of
+    // columns only depend on their left and upper neighbours and run as anti-diagonal wavefronts.
+    template <typename Real, bool American, typename Steps>
+    static Real rollback_wavefront(const opt::Market& m,
+                                   const opt::Option& opt,
+                                   const TreeParams& p,
+                                   const Steps& steps,
+                                   std::vector<Real>& values);
+
+    // One row of the induction over nodes [lo, hi) of `step`, shared by the serial and wavefront
+    // paths so both execute the same arithmetic. S holds node prices: node (step, i) is
+    // S[2i - step + N].
+    template <typename Real, bool American>
+    static void induct_row(Real* values, int lo, int hi, int step, int N,
+                           Real pu, Real pd, double growth,
+                           const double* S, const opt::Option& opt);
+
     // Helper to compute u,d,p,dt and discount factors
     struct CRRCoefs {
         double dt = 0.0;
@@ -40,6 +183,20 @@ private:
                                const opt::Option& opt,
                                const TreeParams& p);
 
+    // Half-width J of the node band |2i - step| <= J (J >= N means no truncation)
+    static int band_halfwidth(const TreeParams& p);
+
+    // Nodes [lo, hi] of `step` that lie inside the band
+    static void band(int step, int J, int& lo, int& hi);
+
+    // Value at node (step, i) just outside the band, in maturity units (V / disc^(N-step)).
+    // carry = e^{int (r - q)} and growth = e^{int r} over the remaining time t_step..T.
+    static double far_node_value(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const CRRCoefs& c,
+                                 int step, int i,
+                                 double carry, double growth);
+
     // payoff at stock price S (vanilla only for now)
     static double payoff(double S, const opt::Option& opt);
 };
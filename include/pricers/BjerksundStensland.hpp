@@ -0,0 +1,27 @@
+// BjerksundStensland.hpp: Bjerksund-Stensland (2002) closed-form American approximation
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+namespace pricers {
+
+// Two-step flat exercise boundary approximation. Cheap (a handful of bivariate normal
+// evaluations) and typically within a few 1e-3 of the true price: meant for screening.
+class BjerksundStensland {
+public:
+    static double price(const opt::Market& m, const opt::Option& opt);
+
+private:
+    static void check_inputs(const opt::Market& m, const opt::Option& opt);
+
+    // American call with cost of carry b = r - q (puts use the put-call transformation)
+    static double call_price(double S, double K, double T, double r, double b, double sigma);
+
+    static double phi(double S, double T, double gamma, double H, double I,
+                      double r, double b, double sigma);
+
+    static double psi(double S, double T2, double gamma, double H, double I2, double I1,
+                      double t1, double r, double b, double sigma);
+};
+
+} // namespace pricers
@@ -0,0 +1,41 @@
+// COSPricer.hpp: Fang-Oosterlee COS pricer with coefficients cached across strikes
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Types.hpp"
+#include "pricers/CharacteristicFunction.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace pricers {
+
+struct COSParams {
+    std::size_t terms = 256;  // cosine terms N
+    double L = 10.0;          // truncation [a, b] = c1 -/+ L sqrt(c2 + sqrt(c4)) on ln(S_T / F)
+};
+
+// Prices European options of one maturity. The constructor evaluates the characteristic function
+// at the N cosine frequencies once and folds it with the put payoff coefficients, so each strike
+// afterwards costs N complex multiply-adds and no transcendental calls. Puts are priced directly
+// (bounded payoff, insensitive to the truncation range) and calls follow from put-call parity.
+// Strikes should keep ln(F/K) well inside the truncation half-width L sqrt(c2).
+class COSPricer {
+public:
+    COSPricer(const CharacteristicFunction& cf, const opt::Market& m, double T, const COSParams& p = {});
+
+    double price(double K, opt::OptionType type) const;
+    std::vector<double> price_chain(const std::vector<double>& strikes, opt::OptionType type) const;
+
+    double lower() const { return a_; }
+    double upper() const { return b_; }
+
+private:
+    double finish(double K, double put_sum, opt::OptionType type) const;
+
+    double S0_, df_r_, df_q_, fwd_;
+    double a_ = 0.0, b_ = 0.0, du_ = 0.0;
+    std::vector<std::complex<double>> coef_; // phi(u_k) e^{-i u_k a} U_k, first term halved
+};
+
+} // namespace pricers
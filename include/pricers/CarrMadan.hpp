@@ -0,0 +1,48 @@
+// CarrMadan.hpp: Carr-Madan FFT pricer for a full strike grid from a characteristic function
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Types.hpp"
+#include "pricers/CharacteristicFunction.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace pricers {
+
+// n frequency nodes spaced eta apart; the log-strike grid spacing is lambda = 2 pi / (n eta).
+// alpha damps the call price in log-strike so its transform exists: E[S_T^{alpha+1}] must be
+// finite, which bounds alpha for Heston at long maturities.
+struct CarrMadanParams {
+    std::size_t n = 4096;   // power of two
+    double eta = 0.25;
+    double alpha = 1.5;
+};
+
+// Call prices at n log-strikes ln(K/F) = -n lambda / 2 + j lambda from one radix-2 FFT of the
+// damped, Simpson-weighted characteristic function. Market::sigma is ignored; the model lives
+// in the characteristic function.
+class CarrMadan {
+public:
+    // Whole FFT grid: strikes[j] and call prices[j], j = 0..n-1. Deep wings are dominated by
+    // FFT rounding and can come out slightly negative.
+    static void price_grid(const CharacteristicFunction& cf,
+                           const opt::Market& m,
+                           double T,
+                           std::vector<double>& strikes,
+                           std::vector<double>& calls,
+                           const CarrMadanParams& p = {});
+
+    // Arbitrary strikes: cubic Lagrange interpolation of the grid in log-strike. Puts follow
+    // from put-call parity.
+    static std::vector<double> price_chain(const CharacteristicFunction& cf,
+                                           const opt::Market& m,
+                                           double T,
+                                           const std::vector<double>& strikes,
+                                           opt::OptionType type,
+                                           const CarrMadanParams& p = {});
+
+private:
+    static void check_inputs(const opt::Market& m, double T, const CarrMadanParams& p);
+};
+
+} // namespace pricers
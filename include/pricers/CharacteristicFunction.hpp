@@ -0,0 +1,56 @@
+// CharacteristicFunction.hpp: Log-price characteristic functions (Black-Scholes, Heston) for Fourier pricing
+#pragma once
+#include <complex>
+
+namespace pricers {
+
+// Heston stochastic volatility: dv = kappa (theta - v) dt + xi sqrt(v) dW_v, d<W_S, W_v> = rho dt
+struct HestonParams {
+    double v0 = 0.04;     // initial variance
+    double kappa = 1.5;   // mean reversion speed
+    double theta = 0.04;  // long-run variance
+    double xi = 0.5;      // vol of variance
+    double rho = -0.7;    // spot/variance correlation
+};
+
+// Characteristic function of X_T = ln(S_T / F_T), the log-price relative to the forward
+// F_T = S0 e^{(r-q)T}. Working relative to the forward keeps S0, r and q out of the models:
+// the Fourier pricers add them back.
+class CharacteristicFunction {
+public:
+    virtual ~CharacteristicFunction() = default;
+
+    // E[exp(i u X_T)] for complex u (Carr-Madan evaluates it off the real axis)
+    virtual std::complex<double> operator()(std::complex<double> u, double T) const = 0;
+
+    // First, second and fourth cumulants of X_T (COS truncation range)
+    virtual void cumulants(double T, double& c1, double& c2, double& c4) const = 0;
+};
+
+class BlackScholesCF : public CharacteristicFunction {
+public:
+    explicit BlackScholesCF(double sigma);
+
+    std::complex<double> operator()(std::complex<double> u, double T) const override;
+    void cumulants(double T, double& c1, double& c2, double& c4) const override;
+
+private:
+    double sigma_;
+};
+
+// Uses the "little Heston trap" form (Albrecher et al. 2007), which keeps the complex logarithm
+// on its principal branch for long maturities and large |u|.
+class HestonCF : public CharacteristicFunction {
+public:
+    explicit HestonCF(const HestonParams& p);
+
+    std::complex<double> operator()(std::complex<double> u, double T) const override;
+    void cumulants(double T, double& c1, double& c2, double& c4) const override;
+
+    const HestonParams& params() const { return p_; }
+
+private:
+    HestonParams p_;
+};
+
+} // namespace pricers
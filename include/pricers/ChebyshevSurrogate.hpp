@@ -0,0 +1,152 @@
+// ChebyshevSurrogate.hpp: Tensor Chebyshev interpolant of an expensive pricer, stored in mmap-able tables
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace pricers {
+
+using PricerFn = std::function<double(const opt::Market&, const opt::Option&)>;
+
+// One interpolation axis, split into `pieces` equal tiles (in the interpolation coordinate) that
+// each carry a degree-`degree` interpolant. degree = 0 pins the axis at lo (which must then equal
+// hi); requests off a pinned value are outside the domain.
+struct SurrogateAxis {
+    double lo = 0.0;
+    double hi = 0.0;
+    int degree = 0;
+    int pieces = 1;
+};
+
+// Domain in natural units. Moneyness is S/K; the moneyness axis is interpolated in ln(S/K) and
+// the maturity axis in sqrt(T), where prices are smoother. The default spans r in [2%, 10%] so
+// an American put table carries an early-exercise premium everywhere (at r = 0 the put boundary
+// is 0, and ln B steepens as r approaches it, hence the 2% floor); q is pinned at 0 (one table
+// per dividend scenario), so an American call table must set it. An American build throws if
+// the early-exercise rate (r for puts, q for calls) is never positive on the domain.
+struct SurrogateDomain {
+    SurrogateAxis moneyness{0.7, 1.4, 6, 8};
+    SurrogateAxis sigma{0.10, 0.60, 4, 6};
+    SurrogateAxis T{0.05, 2.0, 4, 6};
+    SurrogateAxis r{0.02, 0.10, 6, 1};
+    SurrogateAxis q{0.0, 0.0, 0, 1};
+};
+
+struct SurrogateBuildParams {
+    unsigned threads = 0;          // 0 = hardware concurrency
+    int validation_points = 256;   // random in-domain points re-priced to measure the error
+    unsigned long seed = 42;
+
+    // Tabulate the pricer minus the Black-Scholes European price of the same contract and add
+    // the analytic price back on evaluation. The European part carries most of the curvature
+    // near the strike at short maturities, leaving the smaller early-exercise premium.
+    bool european_control = true;
+
+    // Optional, American only: critical S/K at the contract's maturity (unit strike in, e.g.
+    // AndersenLakeOffengelt::exercise_boundary at tau = T). American prices are only C1 across
+    // the boundary, which caps Chebyshev convergence at a low algebraic rate; with a boundary
+    // the moneyness axis is measured from it (ln(S/B) for puts, ln(B/S) for calls), the
+    // exercise region returns intrinsic value exactly and the continuation region is smooth.
+    // ln B is tabulated on the (sigma, T, r, q) tiles of the price table.
+    PricerFn exercise_boundary;
+};
+
+// Evaluates a pricer at the tensor Chebyshev extrema of every tile of the domain (in parallel),
+// converts the samples to Chebyshev coefficients along each axis and serves prices as a plain
+// sum of c_k T_k over the tile holding the request. Prices are stored per unit strike
+// (S0 = S/K, K = 1), so the payoff must be homogeneous in (S, K), which holds for vanilla
+// calls and puts.
+//
+// Evaluation touches one tile, prod(degree_i + 1) coefficients, however many pieces there are:
+// accuracy is bought with pieces (table size) rather than degree (latency).
+//
+// Interpolation error is against the source pricer, not the true price, so the source should be
+// smooth in its inputs: AndersenLakeOffengelt or Leisen-Reimer rather than CRR, whose odd/even
+// oscillation in the strike/spot position would be fitted as noise.
+class ChebyshevSurrogate {
+public:
+    static ChebyshevSurrogate build(const PricerFn& pricer,
+                                    opt::OptionType type,
+                                    opt::Exercise exercise,
+                                    const SurrogateDomain& domain = SurrogateDomain{},
+                                    const SurrogateBuildParams& params = SurrogateBuildParams{});
+
+    // Versioned binary file: fixed header followed by the coefficients in native byte order.
+    // load() maps the file read-only; the coefficients are used in place.
+    void save(const std::string& path) const;
+    static ChebyshevSurrogate load(const std::string& path);
+
+    // Type, exercise and every (S/K, sigma, T, r, q) inside the domain
+    bool in_domain(const opt::Market& m, const opt::Option& opt) const;
+
+    // Unit-strike price at (S/K, sigma, T, r, q); no domain check, extrapolates outside it
+    double eval(double moneyness, double sigma, double T, double r, double q) const;
+
+    // Surrogate price inside the domain, fallback pricer outside it (throws std::out_of_range if
+    // there is none). build() installs the source pricer; load() installs none.
+    double price(const opt::Market& m, const opt::Option& opt) const;
+    void set_fallback(PricerFn fallback) { fallback_ = std::move(fallback); }
+
+    opt::OptionType type() const { return type_; }
+    opt::Exercise exercise() const { return exercise_; }
+    const SurrogateDomain& domain() const { return domain_; }
+    bool front_fixed() const { return front_fixed_; }
+    std::size_t coefficient_count() const { return price_.count() + boundary_.count(); }
+
+    // Error estimates per unit strike (multiply by K for a price): the largest deviation from the
+    // source pricer at the validation points, and the size of the highest-order coefficients
+    double validation_error() const { return validation_error_; }
+    double tail_estimate() const { return tail_estimate_; }
+    double error_bound() const { return validation_error_ > tail_estimate_ ? validation_error_ : tail_estimate_; }
+
+private:
+    static constexpr int AXES = 5;
+
+    // Tile layout of one tabulated function, in interpolation coordinates
+    struct Layout {
+        double lo[AXES] = {};
+        double width[AXES] = {};   // tile width (0 on pinned axes)
+        int size[AXES] = {};       // degree + 1 (1 = pinned)
+        int pieces[AXES] = {};
+        std::size_t tile_size = 0;
+        std::size_t n_tiles = 0;
+        std::size_t count() const { return tile_size * n_tiles; }
+    };
+
+    ChebyshevSurrogate() = default;
+
+    static void check_domain(const SurrogateDomain& d);
+
+    // Price layout over domain_ with moneyness coordinate range [lo0, hi0]; the boundary layout
+    // (moneyness pinned) when front-fixed
+    void set_layout(double lo0, double hi0);
+
+    // Tabulated value at coordinates c; requests beyond the domain use the edge tiles
+    static double eval_table(const Layout& L, const double* coefs, const double c[AXES]);
+
+    // Samples -> per-tile Chebyshev coefficients in place; returns the tail estimate
+    static double to_coefficients(const Layout& L, double* values, unsigned threads);
+
+    opt::OptionType type_ = opt::OptionType::Call;
+    opt::Exercise exercise_ = opt::Exercise::European;
+    SurrogateDomain domain_;
+    bool european_control_ = false;
+    bool front_fixed_ = false;
+    double front_hi_ = 0.0;    // front-fixed moneyness coordinate range is [0, front_hi_]
+    Layout price_;
+    Layout boundary_;          // empty unless front-fixed
+    double validation_error_ = 0.0;
+    double tail_estimate_ = 0.0;
+
+    // Price tiles then boundary tiles, each tile a row-major tensor (moneyness slowest, q
+    // fastest). Owned either by a vector (build) or by a read-only mapping (load); copies share it.
+    std::shared_ptr<const double> coefs_;
+    PricerFn fallback_;
+};
+
+} // namespace pricers
@@ -0,0 +1,56 @@
+// ConvergenceStudy.hpp: Parallel tree-convergence sweeps over step counts and engines
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <string>
+#include <vector>
+
+namespace pricers {
+
+enum class TreeEngine { CRR, CRRTruncated, LeisenReimer };
+
+struct ConvergenceParams {
+    std::vector<int> steps;                           // N values to price
+    std::vector<TreeEngine> engines{TreeEngine::CRR};
+    unsigned threads = 0;                             // workers for the sweep (0 = hardware concurrency)
+    int repeats = 1;                                  // wall time is the best of this many pricings
+    double truncation_stddevs = 8.0;                  // band for TreeEngine::CRRTruncated
+};
+
+struct ConvergencePoint {
+    TreeEngine engine = TreeEngine::CRR;
+    int steps = 0;        // requested N
+    int steps_used = 0;   // N actually rolled back (LR rounds up to odd)
+    double price = 0.0;
+    double error = 0.0;   // price - reference
+    double seconds = 0.0; // best wall time of one pricing
+};
+
+struct ConvergenceResult {
+    double reference = 0.0;
+    std::string reference_name;           // "AnalyticBS" (European) or "ALO(64,32,128,256)" (American, ALOParams::reference())
+    std::vector<ConvergencePoint> points; // engine-major, steps in ConvergenceParams order
+};
+
+// Prices one contract at every (engine, N) pair. The pairs are spread over worker threads,
+// largest N first so the long trees do not end up last, and each worker reuses one
+// TreeWorkspace across its CRR pricings.
+class ConvergenceStudy {
+public:
+    static ConvergenceResult run(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const ConvergenceParams& p);
+
+    // One row per point: engine,steps,steps_used,price,reference,error,abs_error,seconds,reference_name
+    static std::string to_csv(const ConvergenceResult& r);
+    static std::string to_json(const ConvergenceResult& r);
+
+    static const char* engine_name(TreeEngine e);         // "crr", "crr-trunc", "lr"
+    static TreeEngine parse_engine(const std::string& name);
+
+    // lo, lo + stride, ... up to hi inclusive
+    static std::vector<int> step_range(int lo, int hi, int stride);
+};
+
+} // namespace pricers
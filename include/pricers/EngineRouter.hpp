@@ -0,0 +1,81 @@
+// EngineRouter.hpp: Picks the cheapest engine predicted to meet a target accuracy for each contract
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/RequestLog.hpp"
+
+namespace pricers {
+
+// Measured cost of each engine on this machine, from EngineRouter::calibrate()
+struct RouterCostModel {
+    double bs_us = 0.0;        // AnalyticBS::price
+    double bs02_us = 0.0;      // BjerksundStensland::price
+    double alo_fast_us = 0.0;  // AndersenLakeOffengelt::price with ALOParams::fast()
+    double alo_us = 0.0;       // AndersenLakeOffengelt::price, default (accurate) params
+    // American trees: cost(N) = fixed + node * N^2
+    double crr_fixed_us = 0.0;
+    double crr_node_ns = 0.0;
+    double lr_fixed_us = 0.0;
+    double lr_node_ns = 0.0;
+};
+
+struct RouterParams {
+    int min_steps = 25;     // smallest tree the router will pick
+    int max_steps = 20000;  // trees needing more steps than this are not considered
+};
+
+struct RouteDecision {
+    RequestEngine engine = RequestEngine::AnalyticBS;
+    int steps = 0;                   // N for tree engines, 0 otherwise
+    double predicted_error = 0.0;    // absolute price error bound from the error model
+    double predicted_cost_us = 0.0;  // from the calibrated cost model
+    bool meets_target = true;        // false: nothing was predicted to reach the target, so
+                                     // this is the most accurate candidate instead
+};
+
+struct RoutedPrice {
+    double price = 0.0;
+    RouteDecision decision;
+};
+
+// European contracts, and American contracts that are never exercised early (calls with
+// q <= 0, puts with r <= 0), go to the closed form. Other American contracts choose between
+// Bjerksund-Stensland, ALO (fast or accurate) and the CRR and Leisen-Reimer trees at the
+// smallest N whose predicted error meets the target, whichever is predicted cheapest.
+//
+// Errors are bounds in units of S0 sigma sqrt(T): the worst case of each engine, with some
+// margin, over a survey grid (calls and puts, S0 80-120, K 100, sigma 0.08-0.5, T 0.05-3,
+// r and q 0-12%) against ALO at (64, 32, 128, 256) nodes, which a fine Crank-Nicolson solve
+// confirms to ~1e-5. Trees are 0.15 / N (CRR) and 0.13 / N (LR). Bjerksund-Stensland and ALO
+// are banded by kappa = 2 r / sigma^2 (2 q / sigma^2 for calls) at 2, 5, 7 and 10, as both
+// lose accuracy when the exercise boundary steepens near expiry.
+class EngineRouter {
+public:
+    // Runs the calibration micro-benchmark (a few tens of ms)
+    explicit EngineRouter(const RouterParams& p = RouterParams{});
+    explicit EngineRouter(const RouterCostModel& model, const RouterParams& p = RouterParams{});
+
+    // Times each engine on a reference American put and fits the tree cost curves
+    static RouterCostModel calibrate();
+
+    // tol is the acceptable absolute price error
+    RouteDecision route(const opt::Market& m, const opt::Option& opt, double tol) const;
+
+    // route() then RequestLog::execute on the chosen engine
+    RoutedPrice price(const opt::Market& m, const opt::Option& opt, double tol) const;
+
+    // Error model bound for one engine (steps used by the trees only)
+    static double predicted_error(const opt::Market& m, const opt::Option& opt, RequestEngine e, int steps);
+
+    double predicted_cost_us(RequestEngine e, int steps) const;
+
+    const RouterCostModel& cost_model() const { return model_; }
+
+private:
+    static void check_inputs(const opt::Market& m, const opt::Option& opt, double tol);
+
+    RouterCostModel model_;
+    RouterParams params_;
+};
+
+} // namespace pricers
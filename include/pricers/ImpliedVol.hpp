@@ -12,6 +12,24 @@ struct ImpliedVolParams {
     int max_iter = 200;
 };
 
+struct AmericanIVParams {
+    int steps = 2000;                 // tree resolution the quote is matched on
+    double truncation_stddevs = 8.0;  // truncated lattice for every tree evaluation (0 = full tree)
+    bool fast_seed = true;            // seed from Andersen-Lake-Offengelt; false = coarse-to-fine trees
+    int coarse_steps = 125;           // first rung of the coarse-to-fine schedule (doubled up to steps)
+    double sigma_lo = 1e-4;
+    double sigma_hi = 5.0;
+    double tol_sigma = 1e-7;
+    double tol_price = 1e-9;
+    int max_iter = 50;                // evaluations per stage
+};
+
+struct AmericanIVResult {
+    double sigma = 0.0;
+    int tree_evals = 0;   // BinomialCRR::price_american calls, all rungs
+    int fast_evals = 0;   // AndersenLakeOffengelt::price calls (seed and vega)
+};
+
 class ImpliedVol {
 public:
     static double solve_bs(const opt::Market& m,
@@ -19,6 +37,29 @@ public:
                            double target_price,
                            const ImpliedVolParams& params = ImpliedVolParams{});
 
+    // Bracketing + bisection with every BS evaluation done in Real arithmetic. Tolerances are
+    // floored at what Real can resolve (about 1e-7 relative for float).
+    template <typename Real>
+    static Real solve_bs_as(const opt::Market& m,
+                            const opt::Option& opt,
+                            double target_price,
+                            const ImpliedVolParams& params = ImpliedVolParams{});
+
+    // Mixed precision: float bisection to ~1e-4 in sigma, then Newton steps on the double
+    // price to the requested tolerance. Falls back to solve_bs if the polish fails.
+    static double solve_bs_mixed(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 double target_price,
+                                 const ImpliedVolParams& params = ImpliedVolParams{});
+
+    // Implied vol of an American quote, matched on a CRR tree with AmericanIVParams::steps.
+    // A fast pricer (or a schedule of coarser trees) supplies the starting point and vega,
+    // then safeguarded Newton/secant steps on the tree finish in a handful of evaluations.
+    static AmericanIVResult solve_american(const opt::Market& m,
+                                           const opt::Option& opt,
+                                           double target_price,
+                                           const AmericanIVParams& params = AmericanIVParams{});
+
 private:
     static void check_inputs(const opt::Market& m,
                              const opt::Option& opt,
@@ -0,0 +1,93 @@
+// ImpliedVolChain.hpp: Live implied vols for one expiry's quotes, re-solved incrementally on updates
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Types.hpp"
+#include "pricers/ImpliedVol.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace pricers {
+
+struct ImpliedVolChainParams {
+    ImpliedVolParams solve;      // tolerances, and the full solve used when a step fails
+    double max_step = 0.5;       // largest sigma move trusted to the warm step
+    double change_tol = 1e-8;    // a re-solve that moves sigma by more lands in changed()
+};
+
+struct ImpliedVolChainStats {
+    std::size_t warm = 0;     // quotes re-solved by the warm step
+    std::size_t full = 0;     // quotes that needed ImpliedVol::solve_bs
+    std::size_t failed = 0;   // quotes with no implied vol (sigma() is NaN)
+};
+
+// European quotes on one underlying and expiry. Each quote keeps its solved sigma with the
+// model price, vega and volga there. On a price update the Halley step from the previous sigma
+// needs no pricing at all (the price gap is the residual), and one BS evaluation then checks
+// the step and supplies the new vega and a final Newton polish. A market update re-prices each
+// quote once at its old sigma before the same step. Only when the check fails is the quote
+// solved from scratch with ImpliedVol::solve_bs.
+class ImpliedVolChain {
+public:
+    // m.sigma is unused
+    ImpliedVolChain(const opt::Market& m, double T, const ImpliedVolChainParams& p = ImpliedVolChainParams{});
+
+    // Adds a quote and solves it from scratch; returns its index
+    std::size_t add(double K, opt::OptionType type, double price);
+
+    // New quote price for one quote; re-solves it
+    void update(std::size_t i, double price);
+
+    // New spot / rates for the whole chain; re-solves every quote
+    void on_market(const opt::Market& m);
+
+    std::size_t size() const { return quotes_.size(); }
+    double sigma(std::size_t i) const;  // NaN if the quote has no implied vol
+    double vega(std::size_t i) const;
+    double quote(std::size_t i) const;
+
+    // Quotes re-solved since the last clear_dirty(), and the subset whose sigma has moved more
+    // than change_tol from its value at that clear (or became / stopped being NaN); new quotes are in
+    // both. Each listed once, in update order.
+    const std::vector<std::size_t>& dirty() const { return dirty_; }
+    const std::vector<std::size_t>& changed() const { return changed_; }
+    void clear_dirty();
+
+    const ImpliedVolChainStats& stats() const { return stats_; }
+
+private:
+    struct Quote {
+        double K = 0.0;
+        opt::OptionType type = opt::OptionType::Call;
+        double price = 0.0;   // quoted
+        double sigma = 0.0;
+        double model = 0.0;   // BS price at sigma under the current market
+        double vega = 0.0;
+        double volga = 0.0;   // d vega / d sigma
+        double cleared = 0.0; // sigma at the last clear_dirty()
+        bool dirty = false;
+        bool changed = false;
+    };
+
+    void evaluate(Quote& q, double sigma) const;
+    bool warm_step(Quote& q) const;
+    void full_solve(Quote& q);
+    void resolve(std::size_t i, bool reprice);
+    Quote& at(std::size_t i);
+    const Quote& at(std::size_t i) const;
+
+    void set_market(const opt::Market& m);
+
+    opt::Market m_;
+    double T_;
+    double sqrtT_ = 0.0;
+    double Fq_ = 0.0;  // S0 e^{-qT}, refreshed with the market
+    double Dr_ = 0.0;  // e^{-rT}
+    ImpliedVolChainParams params_;
+    std::vector<Quote> quotes_;
+    std::vector<std::size_t> dirty_;
+    std::vector<std::size_t> changed_;
+    ImpliedVolChainStats stats_;
+};
+
+} // namespace pricers
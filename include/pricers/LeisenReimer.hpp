@@ -0,0 +1,67 @@
+// LeisenReimer.hpp: Leisen-Reimer binomial tree (Peizer-Pratt inversion) option pricing model
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+namespace pricers {
+
+// The tree is centred on the strike so European prices converge at second order in N.
+// The Peizer-Pratt inversion needs an odd step count: an even TreeParams::steps is rounded
+// up to the next odd number. Rows run through BinomialCRR's induct_row kernel on a full lattice,
+// serially: TreeParams::threads and exercise_region (speed settings of the CRR lattice) are
+// ignored, and a non-zero truncation_stddevs is rejected since the CRR band and its far-node
+// values do not apply to the strike-centred lattice.
+class LeisenReimer {
+public:
+    // European via backward induction (no early exercise)
+    static double price_european(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p);
+
+    // American via backward induction + early exercise max()
+    static double price_american(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const TreeParams& p);
+
+    // American error is smooth and close to first order in N for LR (no CRR-style
+    // oscillation), so a two-point Richardson step on N and 2N+1 removes most of it.
+    static double price_american_richardson(const opt::Market& m,
+                                            const opt::Option& opt,
+                                            const TreeParams& p);
+
+    // Step count actually used for a requested N (next odd number)
+    static int odd_steps(int steps) { return (steps % 2 == 0) ? steps + 1 : steps; }
+
+private:
+    static void check_inputs(const opt::Market& m,
+                             const opt::Option& opt,
+                             const TreeParams& p);
+
+    struct LRCoefs {
+        int steps = 0;
+        double dt = 0.0;
+        double u  = 0.0;
+        double d  = 0.0;
+        double pu = 0.0;
+        double pd = 0.0;
+        double disc = 0.0; // exp(-r*dt)
+    };
+
+    static LRCoefs make_coefs(const opt::Market& m,
+                              const opt::Option& opt,
+                              const TreeParams& p);
+
+    // Full-lattice induction, with early exercise if American
+    template <bool American>
+    static double rollback(const opt::Market& m,
+                           const opt::Option& opt,
+                           const LRCoefs& c);
+
+    // Peizer-Pratt method 2 inversion of the normal CDF onto a binomial probability
+    static double peizer_pratt(double z, int n);
+
+    static double payoff(double S, const opt::Option& opt);
+};
+
+} // namespace pricers
@@ -0,0 +1,67 @@
+// MertonJumpDiffusion.hpp: Merton (1976) jump-diffusion European pricer as an adaptive Poisson series of BS terms
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+
+#include <cstddef>
+
+namespace pricers {
+
+// Log-normal jumps: at rate lambda, ln S jumps by N(mu_j, sigma_j^2)
+struct MertonParams {
+    double lambda = 0.1;    // jumps per year
+    double mu_j = -0.1;     // mean log jump
+    double sigma_j = 0.15;  // log jump volatility
+};
+
+struct MertonSeriesParams {
+    // The series stops once the Poisson tail it drops is provably below this (per unit of
+    // discounted strike, so the absolute put error is at most tolerance * K e^{-rT})
+    double tolerance = 1e-12;
+};
+
+struct MertonResult {
+    double price = 0.0;
+    Greeks greeks;  // Market::sigma is the diffusion volatility for vega
+    int terms = 0;  // BS terms summed
+};
+
+// Conditional on n jumps the price is Black-Scholes with forward F (1+k)^n e^{-lambda k T} and
+// total variance sigma^2 T + n sigma_j^2, weighted by Poisson(lambda T), k = E[e^J] - 1.
+// The term count comes from a tail bound on the Poisson weights before any term is evaluated;
+// the terms are then filled in one pass over arrays from a handful of per-contract constants
+// (no log or exp per term), and the Greeks are sums over the same arrays. Puts are summed
+// directly (each term is bounded by the discounted strike) and calls follow from parity.
+class MertonJumpDiffusion {
+public:
+    static double price(const opt::Market& m,
+                        const opt::Option& opt,
+                        const MertonParams& jumps,
+                        const MertonSeriesParams& p = MertonSeriesParams{});
+
+    // Price and Greeks from the same terms
+    static MertonResult price_greeks(const opt::Market& m,
+                                     const opt::Option& opt,
+                                     const MertonParams& jumps,
+                                     const MertonSeriesParams& p = MertonSeriesParams{});
+
+    // Batch kernel over contiguous arrays with one set of jump parameters; no input
+    // validation beyond the jump parameters, like AnalyticBS::price_batch
+    static void price_batch(std::size_t n,
+                            const double* S0, const double* K, const double* T,
+                            const double* r, const double* q, const double* sigma,
+                            const opt::OptionType* type,
+                            const MertonParams& jumps,
+                            double* out,
+                            const MertonSeriesParams& p = MertonSeriesParams{});
+
+    // Most terms a series may need; beyond this lambda (1+k) T is too large for the series
+    static constexpr int max_terms = 256;
+
+private:
+    static void check_inputs(const opt::Market& m, const opt::Option& opt);
+    static void check_jumps(const MertonParams& jumps, const MertonSeriesParams& p);
+};
+
+} // namespace pricers
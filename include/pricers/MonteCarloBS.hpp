@@ -0,0 +1,35 @@
+// MonteCarloBS.hpp: Monte Carlo pricer for European options under Black-Scholes dynamics
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AdjointGreeks.hpp"
+
+#include <cstdint>
+
+namespace pricers {
+
+struct MCParams {
+    int paths = 100000;           // number of (antithetic pairs count as two) paths
+    std::uint64_t seed = 42;
+    bool antithetic = true;
+};
+
+class MonteCarloBS {
+public:
+    static double price(const opt::Market& m,
+                        const opt::Option& opt,
+                        const MCParams& p = MCParams{});
+
+    // Pathwise adjoint: each path is priced and then swept backward once,
+    // giving delta, vega, rho and dividend rho alongside the price.
+    static AdjointGreeks greeks(const opt::Market& m,
+                                const opt::Option& opt,
+                                const MCParams& p = MCParams{});
+
+private:
+    static void check_inputs(const opt::Market& m,
+                             const opt::Option& opt,
+                             const MCParams& p);
+};
+
+} // namespace pricers
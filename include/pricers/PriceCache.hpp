@@ -0,0 +1,95 @@
+// PriceCache.hpp: Sharded, bounded memo cache of tree prices keyed on quantized contract inputs
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pricers {
+
+struct PriceCacheParams {
+    std::size_t capacity = 1 << 16; // entries across all shards (rounded up to a multiple of shards)
+    unsigned shards = 16;           // independent locks; a key's shard comes from its hash
+
+    // Quantization steps. Each input is rounded to the nearest multiple of its step, and a miss
+    // prices the rounded contract, so a hit returns exactly the price its key stands for no
+    // matter which request filled it. 0 keys on the exact value.
+    double spot_step = 0.0;
+    double strike_step = 0.0;
+    double time_step = 0.0;
+    double rate_step = 0.0;   // r and q
+    double vol_step = 0.0;
+};
+
+struct PriceCacheStats {
+    std::uint64_t hits = 0;      // served from a finished entry
+    std::uint64_t joins = 0;     // waited on a computation already in flight for the same key
+    std::uint64_t misses = 0;    // ran the pricer
+    std::uint64_t evictions = 0;
+    std::size_t size = 0;        // entries currently held
+};
+
+// Memoizes (S0, K, T, r, q, sigma, type, exercise, N) -> price in front of a pricer (by default
+// the CRR tree). Each shard holds a fixed slot array evicted in CLOCK order: a hit sets the
+// slot's reference bit, and the hand clears bits until it finds an unreferenced slot, so
+// recently used contracts survive a sweep. Concurrent misses on one key run the pricer once;
+// the others wait on its shared_future. A pricer exception reaches every waiter and is not cached.
+class PriceCache {
+public:
+    using Pricer = std::function<double(const opt::Market&, const opt::Option&, int steps)>;
+
+    explicit PriceCache(const PriceCacheParams& p = PriceCacheParams{}, Pricer pricer = tree_pricer());
+
+    double price(const opt::Market& m, const opt::Option& opt, int steps);
+
+    PriceCacheStats stats() const;
+    void clear(); // drops finished entries; counters are kept
+
+    // BinomialCRR::price_european / price_american by exercise style
+    static Pricer tree_pricer();
+
+private:
+    struct Key {
+        std::int64_t q[6] = {};  // quantized S0, K, T, r, q, sigma
+        std::int32_t steps = 0;
+        std::int8_t type = 0;
+        std::int8_t exercise = 0;
+        bool operator==(const Key& o) const;
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const;
+    };
+    struct Slot {
+        Key key;
+        std::shared_future<double> value;
+        std::uint64_t id = 0;     // distinguishes reuses of the slot
+        bool live = false;        // reachable through the index
+        bool referenced = false;  // CLOCK bit
+        bool pending = false;     // pricer still running; not evicted while others are available
+    };
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, std::size_t, KeyHash> index;
+        std::vector<Slot> slots;
+        std::size_t used = 0;
+        std::size_t hand = 0;
+        std::uint64_t next_id = 0;
+        PriceCacheStats stats;
+    };
+
+    std::int64_t quantize(double x, double step, double& snapped) const;
+    std::size_t claim_slot(Shard& s);
+
+    PriceCacheParams params_;
+    Pricer pricer_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace pricers
@@ -0,0 +1,48 @@
+// Replay.hpp: Replays captured pricing requests and reports throughput and latency per engine
+#pragma once
+#include "pricers/RequestLog.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace pricers {
+
+struct ReplayParams {
+    // Arrival times are the capture offsets divided by speed (1 = original timing, 10 = ten
+    // times faster); 0 replays flat-out, each request arriving when a worker is free for it
+    double speed = 1.0;
+
+    // 0 = in-process on the calling thread. Otherwise a daemon stand-in: this many worker
+    // threads serving one FIFO queue of arrivals, like a pricing service with a thread pool.
+    unsigned workers = 0;
+};
+
+struct ReplayEngineStats {
+    RequestEngine engine = RequestEngine::AnalyticBS;
+    std::size_t count = 0;
+    std::size_t failed = 0;    // requests whose pricer threw
+    double throughput = 0.0;   // count per second of replay wall time
+    // Arrival to completion, in microseconds (queueing behind earlier requests included)
+    double mean_us = 0.0;
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+};
+
+struct ReplayResult {
+    double seconds = 0.0;                   // wall time of the whole replay
+    std::vector<ReplayEngineStats> engines; // engines present in the capture, in enum order
+    ReplayEngineStats all;                  // every request together (engine field unused)
+};
+
+class Replay {
+public:
+    static ReplayResult run(const std::vector<Request>& reqs, const ReplayParams& p = ReplayParams{});
+
+    // One row per engine plus "all": engine,count,failed,throughput,mean_us,p50_us,p90_us,p99_us,max_us
+    static std::string to_csv(const ReplayResult& r);
+};
+
+} // namespace pricers
@@ -0,0 +1,78 @@
+// RequestLog.hpp: Binary capture of pricing requests for offline replay
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pricers {
+
+// The pricer a request went to. Values are part of the file format; append only.
+enum class RequestEngine : std::uint8_t {
+    AnalyticBS = 0,
+    CRR = 1,               // price_european / price_american by exercise, N steps
+    LeisenReimer = 2,
+    ALO = 3,
+    BjerksundStensland = 4,
+    ImpliedVolBS = 5,      // target is the quote
+    ImpliedVolCRR = 6,     // target is the quote, matched on an N-step tree
+    ALOFast = 7,           // ALOParams::fast()
+};
+
+constexpr int request_engine_count = 8;
+
+struct Request {
+    std::int64_t t_ns = 0;  // wall clock at capture, ns since the Unix epoch
+    RequestEngine engine = RequestEngine::AnalyticBS;
+    opt::Market market;     // sigma unused by the implied-vol engines
+    opt::Option option;
+    int steps = 0;          // N for the tree engines
+    double target = 0.0;    // quote for the implied-vol engines
+};
+
+// File layout, host byte order (little-endian on every supported target):
+//   header  8-byte magic "OPTREQ\0\0", u32 format version, u32 record size
+//   records i64 t_ns, f64 S0, r, q, sigma, K, T, target, i32 steps,
+//           u8 engine, u8 type, u8 exercise, u8 reserved            (72 bytes)
+class RequestLog {
+public:
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t header_size = 16;
+    static constexpr std::size_t record_size = 72;
+
+    // Whole file; throws std::runtime_error on a missing, foreign or truncated file
+    static std::vector<Request> read(const std::string& path);
+
+    // Runs the request on its engine and returns the price (or implied vol)
+    static double execute(const Request& req);
+
+    static const char* engine_name(RequestEngine e);  // "bs", "crr", "lr", "alo", "bs02", "iv-bs", "iv-crr", "alo-fast"
+    static RequestEngine parse_engine(const std::string& name);
+
+    static void encode(const Request& req, unsigned char* out);      // record_size bytes
+    static Request decode(const unsigned char* in);
+};
+
+// Appends requests to a capture file, writing the header if the file is new. Thread-safe;
+// each record is one write of record_size bytes.
+class RequestRecorder {
+public:
+    explicit RequestRecorder(const std::string& path);
+
+    // Stamps the request with the current wall clock and appends it
+    void record(Request req);
+
+    std::size_t recorded() const { return recorded_; }
+
+private:
+    std::mutex mutex_;
+    std::ofstream out_;
+    std::size_t recorded_ = 0;
+};
+
+} // namespace pricers
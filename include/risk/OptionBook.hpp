@@ -0,0 +1,83 @@
+// OptionBook.hpp: European contracts in SoA form, repriced incrementally on spot/vol ticks
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace risk {
+
+// Contracts are grouped per underlying, and each group stores its contract terms column-wise
+// with the contract-static Black-Scholes terms (ln K, sqrt T, K e^{-rT}, e^{-qT}) precomputed.
+// A spot tick then costs one log for the underlying plus two CDFs (and one PDF for Greeks) per
+// contract. Rows are numbered in insertion order across the whole book.
+class OptionBook {
+public:
+    // with_greeks = false reprices prices only; greeks() then returns zeros
+    explicit OptionBook(bool with_greeks = true);
+
+    // Adds a European contract and prices it. The first contract on an underlying sets its spot
+    // to m.S0; later contracts must quote the same spot. m.r, m.q and m.sigma are per contract.
+    std::size_t add(const std::string& underlying, const opt::Market& m, const opt::Option& o);
+
+    // Underlying handle for the tick methods (avoids a string lookup per tick)
+    std::size_t underlying_id(const std::string& underlying) const;
+
+    // Tick updates; each returns the number of rows repriced
+    std::size_t on_spot(std::size_t underlying, double S0);
+    std::size_t on_spot(const std::string& underlying, double S0);
+    std::size_t on_vol(std::size_t underlying, double sigma); // flat vol for every contract on it
+    std::size_t on_vol(const std::string& underlying, double sigma);
+    std::size_t on_row_vol(std::size_t row, double sigma);    // a single contract
+
+    std::size_t size() const { return row_block_.size(); }
+    double spot(std::size_t underlying) const;
+    double price(std::size_t row) const;
+    pricers::Greeks greeks(std::size_t row) const;
+
+    // Rows repriced since the last clear_dirty(), each listed once, in repricing order
+    const std::vector<std::size_t>& dirty_rows() const { return dirty_; }
+    void clear_dirty();
+
+private:
+    struct Block {
+        double S0 = 0.0;
+        double lnS = 0.0;
+        std::vector<std::size_t> rows; // slot -> book row
+
+        // Contract-static terms
+        std::vector<double> K, T, r, q;
+        std::vector<double> w;        // +1 call, -1 put
+        std::vector<double> lnK;
+        std::vector<double> sqrtT;
+        std::vector<double> KDr;      // K e^{-rT}
+        std::vector<double> Dq;       // e^{-qT}
+
+        // Vol-dependent terms: d1 = (ln S + shift) / sig_sqrtT
+        std::vector<double> sigma;
+        std::vector<double> sig_sqrtT;
+        std::vector<double> shift;    // (r - q + sigma^2/2) T - ln K
+
+        // Outputs
+        std::vector<double> price, delta, gamma, vega, theta, rho;
+    };
+
+    static void set_vol(Block& b, std::size_t slot, double sigma);
+    void reprice(Block& b, std::size_t begin, std::size_t end);
+    void mark_dirty(std::size_t row);
+    void check_row(std::size_t row) const;
+
+    bool with_greeks_;
+    std::vector<Block> blocks_;
+    std::unordered_map<std::string, std::size_t> underlying_ids_;
+    std::vector<std::size_t> row_block_; // row -> block
+    std::vector<std::size_t> row_slot_;  // row -> slot within the block
+    std::vector<unsigned char> is_dirty_;
+    std::vector<std::size_t> dirty_;
+};
+
+} // namespace risk
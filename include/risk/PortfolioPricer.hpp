@@ -0,0 +1,48 @@
+// PortfolioPricer.hpp: Book pricing that prices each distinct contract once and scatters to positions
+#pragma once
+#include "pricers/AnalyticBS.hpp"
+#include "risk/Position.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace risk {
+
+struct PortfolioParams {
+    int tree_steps = 2000;  // N for American contracts (at least 2 with greeks)
+    bool with_greeks = true;
+    unsigned threads = 0;   // 0 = hardware concurrency
+
+    // American calls with q <= 0 and r >= 0 are never exercised early; price them as the
+    // European call (closed form, and shared with any European listing of the same terms)
+    bool merge_american_calls = true;
+};
+
+struct PortfolioResult {
+    // Per position, per unit of quantity, in book order
+    std::vector<double> price;
+    std::vector<pricers::Greeks> greeks;  // American: adjoint delta, vega, rho; lattice gamma, theta
+    std::vector<std::size_t> contract;    // position -> index of its distinct contract
+
+    // Quantity-weighted sums over the book
+    double value = 0.0;
+    pricers::Greeks total;
+
+    std::size_t unique_contracts = 0;
+};
+
+// Many positions (accounts, books) hold the same contract. Each position's market and contract
+// are canonicalized (signed zeros cleared, never-exercised American calls made European),
+// hashed, and grouped; the distinct contracts are priced once each in parallel (American
+// contracts first, as they are the long jobs) and the results are scattered back to positions.
+class PortfolioPricer {
+public:
+    explicit PortfolioPricer(const PortfolioParams& p = PortfolioParams{});
+
+    PortfolioResult price(const std::vector<Position>& book) const;
+
+private:
+    PortfolioParams params_;
+};
+
+} // namespace risk
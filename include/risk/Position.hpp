@@ -0,0 +1,15 @@
+// Position.hpp: A quantity held in a single option contract
+#pragma once
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+
+#include <string>
+
+namespace risk {
+    struct Position {
+        std::string id;      // Unique position identifier (used to track changes between runs)
+        opt::Market market;  // Market inputs for the contract's underlying
+        opt::Option option;  // Contract terms
+        double quantity = 1.0;
+    };
+} // namespace risk
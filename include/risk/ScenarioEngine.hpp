@@ -0,0 +1,72 @@
+// ScenarioEngine.hpp: Spot/vol scenario grid P&L with work shared across grid cells
+#pragma once
+#include "risk/Position.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace risk {
+
+struct ShockGrid {
+    std::vector<double> spot_shocks; // relative: shocked S0 = S0 * (1 + s)
+    std::vector<double> vol_shocks;  // absolute: shocked sigma = sigma + v
+};
+
+struct ScenarioParams {
+    int tree_steps = 2000; // N for American contracts
+};
+
+// P&L cube laid out [position][vol shock][spot shock]
+struct PnLCube {
+    std::size_t n_positions = 0;
+    std::size_t n_vol = 0;
+    std::size_t n_spot = 0;
+    std::vector<double> pnl;
+
+    double at(std::size_t pos, std::size_t vol, std::size_t spot) const {
+        return pnl[(pos * n_vol + vol) * n_spot + spot];
+    }
+};
+
+struct ScenarioRunStats {
+    std::size_t repriced = 0; // positions whose scenario prices were recomputed
+    std::size_t reused = 0;   // positions served from the previous run
+};
+
+class ScenarioEngine {
+public:
+    explicit ScenarioEngine(const ShockGrid& grid, const ScenarioParams& p = ScenarioParams{});
+
+    // Price every position under every (vol, spot) shock. Positions whose id, market and
+    // contract are unchanged since the previous run reuse their cached scenario values.
+    const PnLCube& run(const std::vector<Position>& book);
+
+    const PnLCube& cube() const { return cube_; }
+    const ScenarioRunStats& last_run_stats() const { return stats_; }
+
+    // Per-unit P&L for one contract on the grid, [vol][spot], no caching
+    std::vector<double> unit_pnl(const opt::Market& m, const opt::Option& o) const;
+
+private:
+    struct Entry {
+        opt::Market market;
+        opt::Option option;
+        std::vector<double> unit_pnl; // [vol][spot], per unit quantity
+    };
+
+    static void check_grid(const ShockGrid& grid);
+    static bool same_contract(const Entry& e, const Position& pos);
+
+    void bs_scenarios(const opt::Market& m, const opt::Option& o, double* out) const;
+    void tree_scenarios(const opt::Market& m, const opt::Option& o, double* out) const;
+
+    ShockGrid grid_;
+    ScenarioParams params_;
+    PnLCube cube_;
+    ScenarioRunStats stats_;
+    std::unordered_map<std::string, Entry> cache_;
+};
+
+} // namespace risk
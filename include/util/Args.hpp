@@ -0,0 +1,29 @@
+// Args.hpp: Minimal --key value command-line parser shared by the command-line tools
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+    class Args {
+    public:
+        // Every argument must start with "--". Flags listed in `switches` take no value; every
+        // other flag consumes the next argument as its value.
+        Args(int argc, char** argv, const std::vector<std::string>& switches);
+
+        bool has(const std::string& key) const;
+
+        // Without a default the flag is required and a missing one throws std::invalid_argument
+        std::string get_str(const std::string& key) const;
+        std::string get_str(const std::string& key, const std::string& def) const;
+        double get_double(const std::string& key) const;
+        double get_double(const std::string& key, double def) const;
+        int get_int(const std::string& key) const;
+        int get_int(const std::string& key, int def) const;
+
+        bool empty() const { return kv_.empty(); }
+
+    private:
+        std::unordered_map<std::string, std::string> kv_;
+    };
+} // namespace util
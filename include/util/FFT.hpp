@@ -0,0 +1,51 @@
+// FFT.hpp: In-place iterative radix-2 complex FFT
+#pragma once
+#include "util/Math.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace util {
+    inline bool is_power_of_two(std::size_t n) {
+        return n != 0 && (n & (n - 1)) == 0;
+    }
+
+    // X_k = sum_j x_j exp(-2 pi i j k / n) (inverse: +i and divided by n). n must be a power of two.
+    inline void fft(std::vector<std::complex<double>>& x, bool inverse = false) {
+        const std::size_t n = x.size();
+        if (!is_power_of_two(n)) throw std::invalid_argument("FFT length must be a power of two.");
+
+        // Bit-reversal permutation
+        for (std::size_t i = 1, j = 0; i < n; ++i) {
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(x[i], x[j]);
+        }
+
+        // Butterflies. Twiddles are read from one table of exact polar values rather than formed
+        // by a running product, so rounding does not accumulate along a stage.
+        std::vector<std::complex<double>> w(n / 2);
+        const double sign = inverse ? 1.0 : -1.0;
+        for (std::size_t k = 0; k < n / 2; ++k) w[k] = std::polar(1.0, sign * 2.0 * PI * k / n);
+        for (std::size_t len = 2; len <= n; len <<= 1) {
+            const std::size_t half = len / 2;
+            const std::size_t step = n / len;
+            for (std::size_t i = 0; i < n; i += len) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    const std::complex<double> t = w[j * step] * x[i + j + half];
+                    x[i + j + half] = x[i + j] - t;
+                    x[i + j] += t;
+                }
+            }
+        }
+
+        if (inverse) {
+            const double scale = 1.0 / n;
+            for (auto& v : x) v *= scale;
+        }
+    }
+} // namespace util
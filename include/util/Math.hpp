@@ -4,6 +4,8 @@
 #include <algorithm>
 
 namespace util {
+    inline constexpr double PI = 3.141592653589793238462643383280;
+
     // Normal PDF 
     inline double normal_pdf(double x) {
         static constexpr double INV_SQRT_2PI = 0.398942280401432677939946059934; // 1/sqrt(2pi)
@@ -14,7 +16,45 @@ namespace util {
     inline double normal_cdf(double x) {
         return 0.5 * std::erfc(-x / std::sqrt(2.0));
     }
+
+    // Single-precision overloads (used by the float pricing kernels)
+    inline float normal_pdf(float x) {
+        static constexpr float INV_SQRT_2PI = 0.398942280401432677939946059934f;
+        return INV_SQRT_2PI * std::exp(-0.5f * x * x);
+    }
+
+    inline float normal_cdf(float x) {
+        return 0.5f * std::erfc(-x / std::sqrt(2.0f));
+    }
     
+    // Bivariate standard normal CDF P(X <= a, Y <= b) with correlation rho, from
+    // M = N(a)N(b) + 1/(2pi) * int_0^{asin rho} exp(-(a^2 + b^2 - 2ab sin t) / (2 cos^2 t)) dt
+    // (20-point Gauss-Legendre; accurate to ~1e-12 for |rho| <= 0.9)
+    inline double bivariate_normal_cdf(double a, double b, double rho) {
+        static constexpr double X[10] = {0.0765265211334973, 0.2277858511416451, 0.3737060887154195,
+                                         0.5108670019508271, 0.6360536807265150, 0.7463319064601508,
+                                         0.8391169718222188, 0.9122344282513259, 0.9639719272779138,
+                                         0.9931285991850949};
+        static constexpr double W[10] = {0.1527533871307258, 0.1491729864726037, 0.1420961093183820,
+                                         0.1316886384491766, 0.1181945319615184, 0.1019301198172404,
+                                         0.0832767415767048, 0.0626720483341091, 0.0406014298003869,
+                                         0.0176140071391521};
+        static constexpr double INV_2PI = 0.159154943091895335768883763373;
+
+        const double hs = 0.5 * (a * a + b * b);
+        const double half = 0.5 * std::asin(rho);
+        double sum = 0.0;
+        for (int k = 0; k < 10; ++k) {
+            for (int sgn = -1; sgn <= 1; sgn += 2) {
+                const double t = half * (1.0 + sgn * X[k]);
+                const double st = std::sin(t);
+                const double ct2 = 1.0 - st * st;
+                sum += W[k] * std::exp((a * b * st - hs) / ct2);
+            }
+        }
+        return normal_cdf(a) * normal_cdf(b) + INV_2PI * half * sum;
+    }
+
     // Clamp Function 
     inline double clamp(double x, double lo, double hi) {
         return std::max(lo, std::min(x, hi));
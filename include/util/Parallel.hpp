@@ -0,0 +1,85 @@
+// Parallel.hpp: Minimal fork-join parallel loop over std::thread
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+    inline unsigned hardware_threads() {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1u : n;
+    }
+
+    // Calls fn(i) for i in [0, n) on up to `threads` workers (0 = hardware concurrency).
+    // Indices are handed out in chunks from a shared counter, so uneven work balances itself.
+    // The first exception thrown by fn is rethrown on the calling thread after all workers join.
+    template <typename Fn>
+    void parallel_for(std::size_t n, Fn&& fn, unsigned threads = 0, std::size_t chunk = 1) {
+        if (n == 0) return;
+        if (threads == 0) threads = hardware_threads();
+        chunk = std::max<std::size_t>(chunk, 1);
+        const std::size_t n_chunks = (n + chunk - 1) / chunk;
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, n_chunks));
+
+        if (threads <= 1) {
+            for (std::size_t i = 0; i < n; ++i) fn(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&]() {
+            for (;;) {
+                const std::size_t begin = next.fetch_add(chunk);
+                if (begin >= n) return;
+                const std::size_t end = std::min(n, begin + chunk);
+                try {
+                    for (std::size_t i = begin; i < end; ++i) fn(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next.store(n); // stop handing out work
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Reusable barrier for a fixed number of threads. Waiters spin briefly and then yield, which
+    // keeps a phase switch cheap on dedicated cores without starving an oversubscribed machine.
+    class SpinBarrier {
+    public:
+        explicit SpinBarrier(unsigned parties) : parties_(parties) {}
+
+        void arrive_and_wait() {
+            const unsigned gen = generation_.load(std::memory_order_acquire);
+            if (count_.fetch_add(1, std::memory_order_acq_rel) + 1 == parties_) {
+                count_.store(0, std::memory_order_relaxed);
+                generation_.fetch_add(1, std::memory_order_release);
+                return;
+            }
+            for (unsigned spins = 0; generation_.load(std::memory_order_acquire) == gen; ++spins) {
+                if (spins >= 1024) std::this_thread::yield();
+            }
+        }
+
+    private:
+        const unsigned parties_;
+        std::atomic<unsigned> count_{0};
+        std::atomic<unsigned> generation_{0};
+    };
+} // namespace util
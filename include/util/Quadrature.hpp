@@ -0,0 +1,66 @@
+// Quadrature.hpp: Gauss-Legendre rules and Chebyshev interpolation helpers
+#pragma once
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace util {
+    // Gauss-Legendre nodes/weights on [-1, 1] (Newton iteration on P_n)
+    inline void gauss_legendre(int n, std::vector<double>& x, std::vector<double>& w) {
+        x.assign(n, 0.0);
+        w.assign(n, 0.0);
+        for (int i = 0; i < (n + 1) / 2; ++i) {
+            double z = std::cos(PI * (i + 0.75) / (n + 0.5));
+            double dp = 0.0;
+            for (int it = 0; it < 100; ++it) {
+                double p0 = 1.0, p1 = 0.0;
+                for (int k = 1; k <= n; ++k) {
+                    const double p2 = p1;
+                    p1 = p0;
+                    p0 = ((2.0 * k - 1.0) * z * p1 - (k - 1.0) * p2) / k;
+                }
+                dp = n * (z * p0 - p1) / (z * z - 1.0);
+                const double dz = p0 / dp;
+                z -= dz;
+                if (std::fabs(dz) < 1e-14) break;
+            }
+            x[i] = -z;
+            x[n - 1 - i] = z;
+            w[i] = w[n - 1 - i] = 2.0 / ((1.0 - z * z) * dp * dp);
+        }
+    }
+
+    // Chebyshev extrema z_i = cos(i*pi/n), i = 0..n (z_0 = 1, z_n = -1)
+    inline double chebyshev_node(int i, int n) {
+        return std::cos(PI * i / n);
+    }
+
+    // Coefficients a_k of sum'' a_k T_k(z) interpolating f at the n+1 Chebyshev extrema
+    inline void chebyshev_coefficients(const std::vector<double>& f, std::vector<double>& a) {
+        const int n = static_cast<int>(f.size()) - 1;
+        a.assign(n + 1, 0.0);
+        // cos(pi*i*k/n) only takes 2n distinct values
+        std::vector<double> c(2 * n);
+        for (int j = 0; j < 2 * n; ++j) c[j] = std::cos(PI * j / n);
+        for (int k = 0; k <= n; ++k) {
+            double s = 0.5 * (f[0] + ((k % 2 == 0) ? f[n] : -f[n]));
+            for (int i = 1; i < n; ++i) s += f[i] * c[(i * k) % (2 * n)];
+            a[k] = 2.0 * s / n;
+        }
+    }
+
+    // Evaluate sum'' a_k T_k(z) (first and last terms halved) by Clenshaw recurrence
+    inline double chebyshev_eval(const std::vector<double>& a, double z) {
+        const int n = static_cast<int>(a.size()) - 1;
+        double b1 = 0.0, b2 = 0.0;
+        const double last = 0.5 * a[n];
+        for (int k = n; k >= 1; --k) {
+            const double ak = (k == n) ? last : a[k];
+            const double b0 = ak + 2.0 * z * b1 - b2;
+            b2 = b1;
+            b1 = b0;
+        }
+        return 0.5 * a[0] + z * b1 - b2;
+    }
+} // namespace util
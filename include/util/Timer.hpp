@@ -0,0 +1,17 @@
+// Timer.hpp: Monotonic wall-clock stopwatch for benchmarks and convergence studies
+#pragma once
+#include <chrono>
+
+namespace util {
+    class Timer {
+    public:
+        Timer() { reset(); }
+
+        void reset();
+        double seconds() const; // wall time since construction or the last reset()
+        double millis() const { return 1e3 * seconds(); }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+} // namespace util
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Plot tree convergence sweeps written by `optcli --convergence`.
+
+Reads the CSV (or JSON, by extension) and draws two panels per engine:
+|error| against N (log-log) and wall time per pricing against N (log-log).
+
+    ./build/optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 \
+        --sigma 0.25 --convergence --Nmin 10 --Nmax 2000 --Nstep 10 --engines crr,lr --out conv.csv
+    python3 scripts/plot_convergence.py conv.csv -o conv.png
+"""
+import argparse
+import csv
+import json
+import sys
+from collections import defaultdict
+
+
+def load(path):
+    """Returns (reference name, {engine: [(steps_used, abs_error, seconds), ...]})."""
+    series = defaultdict(list)
+    if path.endswith(".json"):
+        with open(path) as f:
+            data = json.load(f)
+        ref_name = data.get("reference_name", "reference")
+        for p in data["points"]:
+            series[p["engine"]].append((p["steps_used"], abs(p["error"]), p["seconds"]))
+    else:
+        ref_name = "reference"
+        with open(path, newline="") as f:
+            for row in csv.DictReader(f):
+                ref_name = row.get("reference_name", ref_name)
+                series[row["engine"]].append(
+                    (int(row["steps_used"]), float(row["abs_error"]), float(row["seconds"])))
+    for points in series.values():
+        points.sort()
+    return ref_name, series
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="CSV or JSON file from optcli --convergence")
+    ap.add_argument("-o", "--output", help="image file to write (default: show a window)")
+    ap.add_argument("--tol", type=float, help="draw a horizontal error tolerance line")
+    args = ap.parse_args()
+
+    try:
+        import matplotlib
+        if args.output:
+            matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        sys.exit("plot_convergence.py needs matplotlib (pip install matplotlib)")
+
+    ref_name, series = load(args.input)
+    if not series:
+        sys.exit("no points in " + args.input)
+
+    fig, (ax_err, ax_time) = plt.subplots(1, 2, figsize=(12, 4.5))
+    for engine, points in sorted(series.items()):
+        n = [p[0] for p in points]
+        # Exact hits (error 0) cannot be drawn on a log axis
+        err = [(p[0], p[1]) for p in points if p[1] > 0.0]
+        ax_err.loglog([e[0] for e in err], [e[1] for e in err], ".-", ms=3, lw=0.8, label=engine)
+        ax_time.loglog(n, [1e3 * p[2] for p in points], ".-", ms=3, lw=0.8, label=engine)
+
+    if args.tol:
+        ax_err.axhline(args.tol, color="grey", ls="--", lw=0.8, label="tol %g" % args.tol)
+    ax_err.set_xlabel("steps N")
+    ax_err.set_ylabel("|price - %s|" % ref_name)
+    ax_err.set_title("Error")
+    ax_time.set_xlabel("steps N")
+    ax_time.set_ylabel("wall time per pricing [ms]")
+    ax_time.set_title("Cost")
+    for ax in (ax_err, ax_time):
+        ax.grid(True, which="both", alpha=0.3)
+        ax.legend()
+    fig.tight_layout()
+
+    if args.output:
+        fig.savefig(args.output, dpi=150)
+    else:
+        plt.show()
+
+
+if __name__ == "__main__":
+    main()
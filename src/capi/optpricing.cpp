@@ -0,0 +1,286 @@
+// optpricing.cpp: C ABI over the pricers; exceptions are mapped to status codes at the boundary
+#include "capi/optpricing.h"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/ImpliedVol.hpp"
+#include "util/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+struct op_context {
+    unsigned threads = 1;
+    int steps = 200;
+    double truncation_stddevs = 0.0;
+    int32_t engine = OP_ENGINE_TREE;
+    double iv_tol = 1e-8;
+};
+
+namespace {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr std::size_t ROWS_PER_CHUNK = 256; // rows handed to a worker at a time
+
+    // A valid row asking for something the context's engine cannot produce
+    struct unsupported : std::logic_error {
+        using std::logic_error::logic_error;
+    };
+
+    // Runs fn and maps the library's exceptions onto status codes
+    template <typename Fn>
+    int32_t guarded(Fn&& fn) {
+        try {
+            fn();
+            return OP_OK;
+        } catch (const unsupported&) {
+            return OP_ERR_UNSUPPORTED;
+        } catch (const std::invalid_argument&) {
+            return OP_ERR_INVALID_INPUT;
+        } catch (const std::runtime_error&) {
+            return OP_ERR_NO_CONVERGENCE;
+        } catch (...) {
+            return OP_ERR_INTERNAL;
+        }
+    }
+
+    void load_row(const op_inputs& in, std::size_t i, bool with_sigma, opt::Market& m, opt::Option& o) {
+        const int32_t type = in.type[i];
+        const int32_t exercise = in.exercise[i];
+        if (type != OP_CALL && type != OP_PUT) throw std::invalid_argument("Option type must be OP_CALL or OP_PUT.");
+        if (exercise != OP_EUROPEAN && exercise != OP_AMERICAN) throw std::invalid_argument("Exercise must be OP_EUROPEAN or OP_AMERICAN.");
+        m = opt::Market{in.S0[i], in.r[i], in.q[i], with_sigma ? in.sigma[i] : 0.0};
+        o = opt::Option{in.K[i], in.T[i],
+                        (type == OP_CALL) ? opt::OptionType::Call : opt::OptionType::Put,
+                        (exercise == OP_AMERICAN) ? opt::Exercise::American : opt::Exercise::European};
+    }
+
+    pricers::TreeParams tree_params(const op_context& ctx, const op_inputs& in, std::size_t i) {
+        pricers::TreeParams tp;
+        tp.steps = (in.steps != nullptr && in.steps[i] > 0) ? in.steps[i] : ctx.steps;
+        tp.truncation_stddevs = ctx.truncation_stddevs;
+        return tp;
+    }
+
+    void set(double* out, std::size_t i, double v) {
+        if (out != nullptr) out[i] = v;
+    }
+
+    // Central differences of an engine's own price, for engines without an adjoint. Step sizes
+    // as in tests/test_greeks.cpp; ALO's boundary does not depend on S0, so its price is smooth
+    // in every bumped input.
+    template <typename Price>
+    void bumped_greeks(Price&& price, const opt::Market& m, const opt::Option& o, double p0,
+                       const op_outputs& out, std::size_t i) {
+        if (out.delta || out.gamma) {
+            const double h = 1e-4 * m.S0;
+            opt::Market up = m, dn = m;
+            up.S0 += h;
+            dn.S0 -= h;
+            const double p_up = price(up, o), p_dn = price(dn, o);
+            set(out.delta, i, (p_up - p_dn) / (2.0 * h));
+            set(out.gamma, i, (p_up - 2.0 * p0 + p_dn) / (h * h));
+        }
+        if (out.vega) {
+            const double h = 1e-4;
+            opt::Market up = m, dn = m;
+            up.sigma += h;
+            dn.sigma -= h;
+            out.vega[i] = (price(up, o) - price(dn, o)) / (2.0 * h);
+        }
+        if (out.rho) {
+            const double h = 1e-5;
+            opt::Market up = m, dn = m;
+            up.r += h;
+            dn.r -= h;
+            out.rho[i] = (price(up, o) - price(dn, o)) / (2.0 * h);
+        }
+        if (out.theta) {
+            // Per year of calendar time, which shortens the contract
+            const double h = std::min(1e-5, 0.5 * o.T);
+            opt::Option shorter = o, longer = o;
+            shorter.T -= h;
+            longer.T += h;
+            out.theta[i] = (price(m, shorter) - price(m, longer)) / (2.0 * h);
+        }
+    }
+
+    void price_row(const op_context& ctx, const op_inputs& in, const op_outputs& out, std::size_t i) {
+        opt::Market m;
+        opt::Option o;
+        load_row(in, i, true, m, o);
+
+        if (o.exercise == opt::Exercise::European) {
+            set(out.price, i, pricers::AnalyticBS::price(m, o));
+            if (out.delta || out.gamma || out.vega || out.theta || out.rho) {
+                const pricers::Greeks g = pricers::AnalyticBS::greeks(m, o);
+                set(out.delta, i, g.delta);
+                set(out.gamma, i, g.gamma);
+                set(out.vega, i, g.vega);
+                set(out.theta, i, g.theta);
+                set(out.rho, i, g.rho);
+            }
+            return;
+        }
+
+        const bool greeks = out.delta || out.gamma || out.vega || out.theta || out.rho;
+        if (ctx.engine == OP_ENGINE_TREE) {
+            const pricers::TreeParams tp = tree_params(ctx, in, i);
+            if (!greeks) {
+                set(out.price, i, pricers::BinomialCRR::price_american(m, o, tp));
+                return;
+            }
+            if (tp.truncation_stddevs > 0.0) throw unsupported("The tree adjoint runs on the full lattice only.");
+            // One sweep prices the tree and gives all five Greeks
+            const pricers::AdjointGreeks g = pricers::BinomialAAD::greeks(m, o, tp);
+            set(out.price, i, g.price);
+            set(out.delta, i, g.delta);
+            set(out.gamma, i, g.gamma);
+            set(out.vega, i, g.vega);
+            set(out.theta, i, g.theta);
+            set(out.rho, i, g.rho);
+            return;
+        }
+
+        const pricers::ALOParams ap = (ctx.engine == OP_ENGINE_ALO_FAST) ? pricers::ALOParams::fast()
+                                                                        : pricers::ALOParams::accurate();
+        auto alo = [&](const opt::Market& mm, const opt::Option& oo) { return pricers::AndersenLakeOffengelt::price(mm, oo, ap); };
+        const double p0 = alo(m, o);
+        set(out.price, i, p0);
+        if (greeks) bumped_greeks(alo, m, o, p0, out, i);
+    }
+
+    double implied_vol_row(const op_context& ctx, const op_inputs& in, double target, std::size_t i) {
+        opt::Market m;
+        opt::Option o;
+        load_row(in, i, false, m, o);
+
+        if (o.exercise == opt::Exercise::European) {
+            pricers::ImpliedVolParams p;
+            p.tol_sigma = ctx.iv_tol;
+            return pricers::ImpliedVol::solve_bs(m, o, target, p);
+        }
+        const pricers::TreeParams tp = tree_params(ctx, in, i);
+        pricers::AmericanIVParams p;
+        p.steps = tp.steps;
+        p.truncation_stddevs = tp.truncation_stddevs;
+        p.tol_sigma = ctx.iv_tol;
+        return pricers::ImpliedVol::solve_american(m, o, target, p).sigma;
+    }
+
+    bool has_contracts(const op_inputs& in, bool with_sigma) {
+        return in.S0 && in.K && in.T && in.r && in.q && in.type && in.exercise && (!with_sigma || in.sigma);
+    }
+
+    // Calls row(i) for every row on the context's threads and records per-row status
+    template <typename Row, typename OnFail>
+    int32_t run_rows(const op_context& ctx, std::size_t n, int32_t* status, Row&& row, OnFail&& on_fail) {
+        std::atomic<bool> any_failed{false};
+        try {
+            util::parallel_for(n, [&](std::size_t i) {
+                const int32_t s = guarded([&] { row(i); });
+                if (s != OP_OK) {
+                    on_fail(i);
+                    any_failed.store(true, std::memory_order_relaxed);
+                }
+                if (status != nullptr) status[i] = s;
+            }, ctx.threads, ROWS_PER_CHUNK);
+        } catch (...) {
+            return OP_ERR_INTERNAL; // e.g. a worker thread could not be started
+        }
+        return any_failed.load() ? OP_ERR_ROWS_FAILED : OP_OK;
+    }
+} // namespace
+
+extern "C" {
+
+int32_t op_abi_version(void) {
+    return OP_ABI_VERSION;
+}
+
+const char* op_status_string(int32_t status) {
+    switch (status) {
+        case OP_OK: return "ok";
+        case OP_ERR_NULL_ARGUMENT: return "required pointer is null";
+        case OP_ERR_INVALID_INPUT: return "invalid input";
+        case OP_ERR_NO_CONVERGENCE: return "solver did not converge";
+        case OP_ERR_INTERNAL: return "internal error";
+        case OP_ERR_ROWS_FAILED: return "one or more rows failed";
+        case OP_ERR_UNSUPPORTED: return "not supported by the engine";
+        default: return "unknown status";
+    }
+}
+
+op_context* op_context_create(void) {
+    return new (std::nothrow) op_context();
+}
+
+void op_context_destroy(op_context* ctx) {
+    delete ctx;
+}
+
+int32_t op_context_set_threads(op_context* ctx, uint32_t threads) {
+    if (ctx == nullptr) return OP_ERR_NULL_ARGUMENT;
+    ctx->threads = threads; // 0 is resolved by parallel_for
+    return OP_OK;
+}
+
+int32_t op_context_set_tree_steps(op_context* ctx, int32_t steps) {
+    if (ctx == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (steps <= 0) return OP_ERR_INVALID_INPUT;
+    ctx->steps = steps;
+    return OP_OK;
+}
+
+int32_t op_context_set_truncation(op_context* ctx, double stddevs) {
+    if (ctx == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (!(stddevs >= 0.0)) return OP_ERR_INVALID_INPUT;
+    ctx->truncation_stddevs = stddevs;
+    return OP_OK;
+}
+
+int32_t op_context_set_american_engine(op_context* ctx, int32_t engine) {
+    if (ctx == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (engine != OP_ENGINE_TREE && engine != OP_ENGINE_ALO_FAST && engine != OP_ENGINE_ALO_ACCURATE) return OP_ERR_INVALID_INPUT;
+    ctx->engine = engine;
+    return OP_OK;
+}
+
+int32_t op_context_set_iv_tolerance(op_context* ctx, double tol_sigma) {
+    if (ctx == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (!(tol_sigma > 0.0)) return OP_ERR_INVALID_INPUT;
+    ctx->iv_tol = tol_sigma;
+    return OP_OK;
+}
+
+int32_t op_price(const op_context* ctx, size_t n, const op_inputs* in, op_outputs* out) {
+    if (ctx == nullptr || in == nullptr || out == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (n == 0) return OP_OK;
+    if (!has_contracts(*in, true)) return OP_ERR_NULL_ARGUMENT;
+
+    const op_outputs o = *out;
+    return run_rows(*ctx, n, o.status,
+        [&](std::size_t i) { price_row(*ctx, *in, o, i); },
+        [&](std::size_t i) {
+            for (double* a : {o.price, o.delta, o.gamma, o.vega, o.theta, o.rho}) set(a, i, NaN);
+        });
+}
+
+int32_t op_implied_vol(const op_context* ctx, size_t n, const op_inputs* in,
+                       const double* target_price, double* iv, int32_t* status) {
+    if (ctx == nullptr || in == nullptr || target_price == nullptr || iv == nullptr) return OP_ERR_NULL_ARGUMENT;
+    if (n == 0) return OP_OK;
+    if (!has_contracts(*in, false)) return OP_ERR_NULL_ARGUMENT;
+
+    return run_rows(*ctx, n, status,
+        [&](std::size_t i) { iv[i] = implied_vol_row(*ctx, *in, target_price[i], i); },
+        [&](std::size_t i) { iv[i] = NaN; });
+}
+
+} // extern "C"
@@ -3,89 +3,96 @@
 #include "pricers/AnalyticBS.hpp"
 #include "pricers/BinomialCRR.hpp"
 #include "pricers/ImpliedVol.hpp"
+#include "pricers/ConvergenceStudy.hpp"
+#include "pricers/EngineRouter.hpp"
+#include "pricers/RequestLog.hpp"
+#include "util/Args.hpp"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <stdexcept>
 #include <cstdlib>
+#include <vector>
 
 static void print_usage() {
     std::cout <<
     R"(Usage:
     optcli --style [euro|amer] --type [call|put] --S0 <spot> --K <strike> --T <years>
             --r <rate> --q <div_yield> [--sigma <vol>] [--N <steps>]
-            [--greeks] [--iv --price <target_price>]
+            [--greeks] [--compare-tree] [--iv --price <target_price>] [--tol <abs_error>]
+            [--record <capture.bin>]
+            [--convergence [--Nmin <n>] [--Nmax <n>] [--Nstep <n>] [--engines crr,crr-trunc,lr]
+                           [--threads <n>] [--repeats <n>] [--out <file.csv|file.json>]]
 
     Examples:
-    optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 --sigma 0.25 --N 2000 --greeks
+    optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 --sigma 0.25 --greeks
+    optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 --sigma 0.25 --compare-tree --N 2000
     optcli --style amer --type put  --S0 100 --K 105 --T 1.0 --r 0.05 --q 0.02 --sigma 0.20 --N 2000
     optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 --iv --price 12.34
+    optcli --style amer --type put  --S0 100 --K 105 --T 1.0 --r 0.05 --q 0.02 --iv --price 9.38 --N 2000
+    optcli --style amer --type put  --S0 100 --K 105 --T 1.0 --r 0.05 --q 0.02 --sigma 0.20 --tol 1e-3
+    optcli --style euro --type call --S0 100 --K 105 --T 1.5 --r 0.03 --q 0.01 --sigma 0.25 --convergence --Nmin 10 --Nmax 2000 --Nstep 10 --engines crr,lr --out conv.csv
 
     Notes:
-    - European: prints BS analytic + CRR tree price.
-    - American: prints CRR tree price only.
+    - European: prints the BS analytic price. --compare-tree also prices the contract on an
+      N-step CRR tree and prints both.
+    - American: prints the CRR tree price (--tol routes to the fastest accurate engine).
     - --greeks uses BS analytic Greeks (European only).
-    - --iv solves BS implied volatility from --price (European only).
+    - --iv solves BS implied volatility from --price (European), or the vol that
+      reproduces --price on an N-step CRR tree (American).
+    - --convergence prices the contract at every N in [Nmin, Nmax] (step Nstep) for each engine,
+      in parallel, and writes price, error against BS (European) or ALO (American) and wall
+      time per N as CSV (default, stdout) or JSON (--out *.json). Plot it with
+      scripts/plot_convergence.py.
+    - --tol prices with the single cheapest engine predicted to be within the given absolute
+      error (closed form, ALO, Bjerksund-Stensland, or a CRR/LR tree at the smallest N that suffices),
+      using a cost model measured at startup, and prints the engine with its predicted error
+      and cost. --N is ignored.
+    - --record appends each pricer call (engine, contract, N, IV target, timestamp) to a
+      binary capture file; replay it with optreplay.
     )";
 }
 
-static std::unordered_map<std::string, std::string> parse_kv(int argc, char** argv) {
-    std::unordered_map<std::string, std::string> kv;
-    for (int i = 1; i < argc; ++i) {
-        std::string key = argv[i];
-        if (key.rfind("--", 0) != 0) {
-            throw std::invalid_argument("Expected flag starting with --, got: " + key);
-        }
-        // boolean flags
-        if (key == "--greeks" || key == "--iv" || key == "--help") {
-            kv[key] = "1";
-            continue;
-        }
-        if (i + 1 >= argc) throw std::invalid_argument("Missing value after: " + key);
-        kv[key] = argv[++i];
-    }
-    return kv;
-}
-
-static bool has(const std::unordered_map<std::string, std::string>& kv, const std::string& k) {
-    return kv.find(k) != kv.end();
-}
-
-static std::string get_str(const std::unordered_map<std::string, std::string>& kv,
-                           const std::string& k,
-                           const std::string& def = "") {
-    auto it = kv.find(k);
-    if (it == kv.end()) {
-        if (def != "") return def;
-        throw std::invalid_argument("Missing required flag: " + k);
-    }
-    return it->second;
-}
-
-static double get_d(const std::unordered_map<std::string, std::string>& kv,
-                    const std::string& k,
-                    bool required = true,
-                    double def = 0.0) {
-    auto it = kv.find(k);
-    if (it == kv.end()) {
-        if (required) throw std::invalid_argument("Missing required flag: " + k);
-        return def;
+static std::vector<pricers::TreeEngine> parse_engines(const std::string& list) {
+    std::vector<pricers::TreeEngine> engines;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const std::size_t end = std::min(list.find(',', begin), list.size());
+        engines.push_back(pricers::ConvergenceStudy::parse_engine(list.substr(begin, end - begin)));
+        begin = end + 1;
     }
-    return std::stod(it->second);
+    return engines;
 }
 
-static int get_i(const std::unordered_map<std::string, std::string>& kv,
-                 const std::string& k,
-                 bool required = true,
-                 int def = 0) {
-    auto it = kv.find(k);
-    if (it == kv.end()) {
-        if (required) throw std::invalid_argument("Missing required flag: " + k);
-        return def;
+static int run_convergence(const util::Args& args,
+                           const opt::Market& m,
+                           const opt::Option& o) {
+    pricers::ConvergenceParams cp;
+    cp.steps = pricers::ConvergenceStudy::step_range(args.get_int("--Nmin", 10),
+                                                     args.get_int("--Nmax", 1000),
+                                                     args.get_int("--Nstep", 10));
+    cp.engines = parse_engines(args.get_str("--engines", "crr"));
+    cp.threads = static_cast<unsigned>(args.get_int("--threads", 0));
+    cp.repeats = args.get_int("--repeats", 1);
+
+    const auto result = pricers::ConvergenceStudy::run(m, o, cp);
+
+    const std::string path = args.get_str("--out", "-");
+    const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    const std::string text = json ? pricers::ConvergenceStudy::to_json(result) : pricers::ConvergenceStudy::to_csv(result);
+    if (path == "-") {
+        std::cout << text;
+        return 0;
     }
-    return std::stoi(it->second);
+    std::ofstream out(path);
+    if (!out) throw std::invalid_argument("Cannot open output file: " + path);
+    out << text;
+    std::cerr << "Wrote " << result.points.size() << " points to " << path << "\n";
+    return 0;
 }
 
 static opt::OptionType parse_type(const std::string& s) {
@@ -102,64 +109,117 @@ static opt::Exercise parse_style(const std::string& s) {
 
 int main(int argc, char** argv) {
     try {
-        auto kv = parse_kv(argc, argv);
+        const util::Args args(argc, argv, {"--greeks", "--iv", "--convergence", "--compare-tree", "--help"});
 
-        if (argc == 1 || has(kv, "--help")) {
+        if (argc == 1 || args.has("--help")) {
             print_usage();
             return 0;
         }
 
-        const auto style = parse_style(get_str(kv, "--style"));
-        const auto type  = parse_type(get_str(kv, "--type"));
+        const auto style = parse_style(args.get_str("--style"));
+        const auto type  = parse_type(args.get_str("--type"));
 
-        const double S0 = get_d(kv, "--S0");
-        const double K  = get_d(kv, "--K");
-        const double T  = get_d(kv, "--T");
-        const double r  = get_d(kv, "--r");
-        const double q  = get_d(kv, "--q");
+        const double S0 = args.get_double("--S0");
+        const double K  = args.get_double("--K");
+        const double T  = args.get_double("--T");
+        const double r  = args.get_double("--r");
+        const double q  = args.get_double("--q");
 
-        const int N = get_i(kv, "--N", /*required=*/false, /*def=*/2000);
+        const int N = args.get_int("--N", 2000);
 
-        const bool want_greeks = has(kv, "--greeks");
-        const bool want_iv     = has(kv, "--iv");
+        const bool want_greeks = args.has("--greeks");
+        const bool want_iv     = args.has("--iv");
 
         // sigma is required unless we are doing implied vol
-        const double sigma = want_iv ? get_d(kv, "--sigma", /*required=*/false, /*def=*/0.20)
-                                     : get_d(kv, "--sigma", /*required=*/true);
+        const double sigma = want_iv ? args.get_double("--sigma", 0.20)
+                                     : args.get_double("--sigma");
 
         opt::Market m{S0, r, q, sigma};
         opt::Option o{K, T, type, style};
 
+        if (args.has("--convergence")) return run_convergence(args, m, o);
+
+        // --record appends every pricer call below to a capture file for optreplay
+        std::unique_ptr<pricers::RequestRecorder> recorder;
+        if (args.has("--record")) recorder.reset(new pricers::RequestRecorder(args.get_str("--record")));
+        auto record = [&](pricers::RequestEngine engine, double target = 0.0, int steps = -1) {
+            if (!recorder) return;
+            pricers::Request req;
+            req.engine = engine;
+            req.market = m;
+            req.option = o;
+            req.steps = steps < 0 ? N : steps;
+            // The router sends never-exercised American contracts to the closed form
+            if (engine == pricers::RequestEngine::AnalyticBS) req.option.exercise = opt::Exercise::European;
+            req.target = target;
+            recorder->record(req);
+        };
+
         std::cout << std::fixed << std::setprecision(6);
 
-        // ---- Implied vol path (European only) ----
+        // ---- Implied vol path ----
         if (want_iv) {
-            if (style != opt::Exercise::European) {
-                throw std::invalid_argument("--iv is only supported for European options (BS).");
-            }
-            if (!has(kv, "--price")) {
+            if (!args.has("--price")) {
                 throw std::invalid_argument("--iv requires --price <target_price>.");
             }
-            const double target = get_d(kv, "--price");
+            const double target = args.get_double("--price");
+
+            if (style == opt::Exercise::American) {
+                pricers::AmericanIVParams ap;
+                ap.steps = N;
+                const auto res = pricers::ImpliedVol::solve_american(m, o, target, ap);
+                record(pricers::RequestEngine::ImpliedVolCRR, target);
+
+                std::cout << "Implied vol (CRR, N=" << N << "): " << res.sigma << "\n";
+                std::cout << "Tree evaluations: " << res.tree_evals
+                          << " (+" << res.fast_evals << " ALO)\n";
+                return 0;
+            }
 
             pricers::ImpliedVolParams p; // defaults ok
             const double iv = pricers::ImpliedVol::solve_bs(m, o, target, p);
+            record(pricers::RequestEngine::ImpliedVolBS, target);
 
             std::cout << "Implied vol (BS): " << iv << "\n";
             return 0;
         }
 
+        // ---- Routed pricing: one engine, picked for the target accuracy ----
+        if (args.has("--tol")) {
+            const pricers::EngineRouter router;
+            const auto res = router.price(m, o, args.get_double("--tol"));
+            const auto& d = res.decision;
+            record(d.engine, 0.0, d.steps);
+
+            std::cout << (style == opt::Exercise::European ? "European " : "American ")
+                      << (type == opt::OptionType::Call ? "Call" : "Put") << "\n";
+            std::cout << "Price:  " << res.price << "\n";
+            std::cout << "Engine: " << pricers::RequestLog::engine_name(d.engine);
+            if (d.steps > 0) std::cout << " (N=" << d.steps << ")";
+            std::cout << "\n" << std::scientific << std::setprecision(2)
+                      << "Predicted error: " << d.predicted_error
+                      << (d.meets_target ? "" : " (target not reachable; most accurate engine used)") << "\n"
+                      << "Predicted cost:  " << d.predicted_cost_us << " us\n";
+            return 0;
+        }
+
         // ---- Pricing ----
         pricers::TreeParams tp;
         tp.steps = N;
 
         if (style == opt::Exercise::European) {
-            const double bs   = pricers::AnalyticBS::price(m, o);
-            const double tree = pricers::BinomialCRR::price_european(m, o, tp);
+            const double bs = pricers::AnalyticBS::price(m, o);
+            record(pricers::RequestEngine::AnalyticBS);
 
             std::cout << "European " << (type == opt::OptionType::Call ? "Call" : "Put") << "\n";
-            std::cout << "BS price:   " << bs   << "\n";
-            std::cout << "Tree price: " << tree << " (N=" << N << ")\n";
+            std::cout << "BS price:   " << bs << "\n";
+
+            // The tree is only a cross-check against the closed form; price it on request
+            if (args.has("--compare-tree")) {
+                const double tree = pricers::BinomialCRR::price_european(m, o, tp);
+                record(pricers::RequestEngine::CRR);
+                std::cout << "Tree price: " << tree << " (N=" << N << ")\n";
+            }
 
             if (want_greeks) {
                 const auto g = pricers::AnalyticBS::greeks(m, o);
@@ -172,6 +232,7 @@ int main(int argc, char** argv) {
             }
         } else {
             const double amer = pricers::BinomialCRR::price_american(m, o, tp);
+            record(pricers::RequestEngine::CRR);
 
             std::cout << "American " << (type == opt::OptionType::Call ? "Call" : "Put") << "\n";
             std::cout << "Tree price: " << amer << " (N=" << N << ")\n";
@@ -0,0 +1,137 @@
+// Curve.cpp: Piecewise-flat / piecewise-linear rate curves with O(1) cumulative-integral lookup
+#include "opt/Curve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace opt {
+    Curve::Curve(double flat_rate) : Curve(std::vector<double>{1.0}, std::vector<double>{flat_rate}) {}
+
+    Curve::Curve(std::vector<double> times, std::vector<double> rates, CurveInterp interp)
+        : interp_(interp), t_(std::move(times)), r_(std::move(rates)) {
+        if (t_.empty()) throw std::invalid_argument("A curve needs at least one knot.");
+        if (t_.size() != r_.size()) throw std::invalid_argument("Curve knot and rate counts must match.");
+        if (t_[0] <= 0.0) throw std::invalid_argument("Curve knot times must be positive.");
+        for (std::size_t i = 1; i < t_.size(); ++i) {
+            if (!(t_[i] > t_[i - 1])) throw std::invalid_argument("Curve knot times must be increasing.");
+        }
+
+        const std::size_t n = t_.size();
+        I_.resize(n);
+        D_.resize(n);
+        I_[0] = r_[0] * t_[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            const double h = t_[i] - t_[i - 1];
+            I_[i] = I_[i - 1] + ((interp_ == CurveInterp::PiecewiseFlat) ? r_[i] * h : 0.5 * (r_[i - 1] + r_[i]) * h);
+        }
+        for (std::size_t i = 0; i < n; ++i) D_[i] = std::exp(-I_[i]);
+
+        // Buckets over [0, t_n]: bucket b holds the first knot with t * bucket_scale_ >= b, the
+        // same product a lookup floors, so the knot for T lies between the first knots of its
+        // bucket and of the next one
+        const std::size_t nb = 4 * n;
+        bucket_scale_ = nb / t_.back();
+        bucket_.resize(nb + 1);
+        std::size_t j = 0;
+        for (std::size_t b = 0; b <= nb; ++b) {
+            while (j < n && t_[j] * bucket_scale_ < static_cast<double>(b)) ++j;
+            bucket_[b] = std::min(j, n - 1);
+        }
+    }
+
+    std::size_t Curve::segment(double T) const {
+        const std::size_t n = t_.size();
+        if (!(T <= t_.back())) return n; // past the end, or NaN
+        const double pos = T * bucket_scale_;
+        const std::size_t b = pos <= 0.0 ? 0 : std::min(bucket_.size() - 2, static_cast<std::size_t>(pos));
+        // Bisect the bucket's knots: clustered knots cost log2 of the cluster, not its length
+        return std::lower_bound(t_.begin() + bucket_[b], t_.begin() + bucket_[b + 1] + 1, T) - t_.begin();
+    }
+
+    double Curve::tail(std::size_t j, double T) const {
+        const double h = T - t_[j - 1];
+        if (interp_ == CurveInterp::PiecewiseFlat) return r_[j] * h;
+        const double slope = (r_[j] - r_[j - 1]) / (t_[j] - t_[j - 1]);
+        return h * (r_[j - 1] + 0.5 * slope * h);
+    }
+
+    void Curve::check_time(double T) {
+        if (!(T >= 0.0) || !std::isfinite(T)) throw std::invalid_argument("Curve time must be finite and non-negative.");
+    }
+
+    double Curve::rate(double t) const {
+        check_time(t);
+        const std::size_t n = t_.size();
+        const std::size_t j = segment(t);
+        if (j == n) return r_.back();
+        if (interp_ == CurveInterp::PiecewiseFlat || j == 0) return r_[j];
+        const double u = (t - t_[j - 1]) / (t_[j] - t_[j - 1]);
+        return r_[j - 1] + u * (r_[j] - r_[j - 1]);
+    }
+
+    double Curve::integral_unchecked(double T) const {
+        const std::size_t n = t_.size();
+        const std::size_t j = segment(T);
+        if (j == n) return I_[n - 1] + r_[n - 1] * (T - t_[n - 1]);
+        if (j == 0) return r_[0] * T;
+        return I_[j - 1] + tail(j, T);
+    }
+
+    double Curve::integral(double T) const {
+        check_time(T);
+        return integral_unchecked(T);
+    }
+
+    double Curve::zero_rate(double T) const {
+        check_time(T);
+        return (T == 0.0) ? rate(0.0) : integral_unchecked(T) / T;
+    }
+
+    // Log-space from the knot below: D(T) = D_{j-1} exp(-int_{t_{j-1}}^T r). A knot's own factor
+    // is read from the table (exp(0) = 1 leaves it exact), and the exp only sees the increment
+    // within one segment.
+    double Curve::discount_base(double T, double& increment) const {
+        const std::size_t n = t_.size();
+        const std::size_t j = segment(T);
+        if (j == n) {
+            increment = r_[n - 1] * (T - t_[n - 1]);
+            return D_[n - 1];
+        }
+        if (T == t_[j]) {
+            increment = 0.0;
+            return D_[j];
+        }
+        if (j == 0) {
+            increment = r_[0] * T;
+            return 1.0;
+        }
+        increment = tail(j, T);
+        return D_[j - 1];
+    }
+
+    double Curve::discount(double T) const {
+        check_time(T);
+        double increment;
+        const double base = discount_base(T, increment);
+        return base * std::exp(-increment);
+    }
+
+    void Curve::integral_batch(std::size_t n, const double* T, double* out) const {
+        for (std::size_t i = 0; i < n; ++i) out[i] = integral_unchecked(T[i]);
+    }
+
+    // Lookups first, then a separate exp loop the compiler can vectorise, in chunks that stay
+    // on the stack
+    void Curve::discount_batch(std::size_t n, const double* T, double* out) const {
+        constexpr std::size_t CHUNK = 64;
+        double base[CHUNK];
+        for (std::size_t i0 = 0; i0 < n; i0 += CHUNK) {
+            const std::size_t m = std::min(CHUNK, n - i0);
+            for (std::size_t k = 0; k < m; ++k) base[k] = discount_base(T[i0 + k], out[i0 + k]);
+            for (std::size_t k = 0; k < m; ++k) out[i0 + k] = std::exp(-out[i0 + k]);
+            for (std::size_t k = 0; k < m; ++k) out[i0 + k] *= base[k];
+        }
+    }
+} // namespace opt
@@ -0,0 +1,108 @@
+// LocalVol.cpp: Local volatility sigma(S, t) on a grid, given directly or derived from an implied-vol surface (Dupire)
+#include "opt/LocalVol.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace opt {
+    LocalVolSurface::LocalVolSurface(std::vector<double> times,
+                                     std::vector<std::vector<double>> spots,
+                                     std::vector<std::vector<double>> vols)
+        : t_(std::move(times)), vol_(std::move(vols)) {
+        if (t_.empty()) throw std::invalid_argument("A local vol surface needs at least one time.");
+        if (spots.size() != t_.size() || vol_.size() != t_.size()) throw std::invalid_argument("Local vol grid needs one spot row and one vol row per time.");
+        lnS_.resize(t_.size());
+        for (std::size_t i = 0; i < t_.size(); ++i) {
+            if (!(t_[i] > 0.0) || (i > 0 && !(t_[i] > t_[i - 1]))) throw std::invalid_argument("Local vol times must be positive and increasing.");
+            if (spots[i].empty() || spots[i].size() != vol_[i].size()) throw std::invalid_argument("Local vol rows must be non-empty and match their spots.");
+            lnS_[i].resize(spots[i].size());
+            for (std::size_t j = 0; j < spots[i].size(); ++j) {
+                if (!(spots[i][j] > 0.0) || (j > 0 && !(spots[i][j] > spots[i][j - 1]))) throw std::invalid_argument("Local vol spots must be positive and increasing.");
+                if (!(vol_[i][j] > 0.0) || !std::isfinite(vol_[i][j])) throw std::invalid_argument("Local volatility must be positive.");
+                lnS_[i][j] = std::log(spots[i][j]);
+            }
+        }
+    }
+
+    LocalVolSurface LocalVolSurface::flat(double sigma) {
+        return LocalVolSurface({1.0}, {{1.0}}, {{sigma}});
+    }
+
+    LocalVolSurface LocalVolSurface::from_implied(const VolSurface& iv,
+                                                  double S0,
+                                                  double r,
+                                                  double q,
+                                                  const LocalVolGridParams& p) {
+        if (S0 <= 0.0) throw std::invalid_argument("Spot price must be positive.");
+        if (p.time_nodes < 1 || p.spot_nodes < 3) throw std::invalid_argument("Local vol grid needs at least 1 time and 3 spot nodes.");
+        if (!(p.y_hi > p.y_lo) || p.y_lo > 0.0 || p.y_hi < 0.0 || !(p.min_width > 0.0)) throw std::invalid_argument("Local vol grid must span the forward.");
+        if (!(p.vol_floor > 0.0) || !(p.vol_cap > p.vol_floor)) throw std::invalid_argument("Local vol floor must be positive and below the cap.");
+        const double t_max = (p.t_max > 0.0) ? p.t_max : iv.expiries().back();
+
+        // Total variance at forward log-moneyness y and maturity T
+        auto w = [&](double y, double T) { return iv.total_variance(S0 * std::exp((r - q) * T + y), T); };
+        constexpr double hy = 1e-2;
+
+        // Row ends: each gap between expiries (and t_max) gets its share of the rows
+        std::vector<double> ends;
+        for (double T : iv.expiries()) {
+            if (T < t_max) ends.push_back(T);
+        }
+        ends.push_back(t_max);
+        std::vector<double> times;
+        double t0 = 0.0;
+        for (double T : ends) {
+            const std::size_t rows = std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(p.time_nodes * (T - t0) / t_max)));
+            for (std::size_t k = 1; k <= rows; ++k) times.push_back(t0 + (T - t0) * k / rows);
+            t0 = T;
+        }
+
+        std::vector<std::vector<double>> spots(times.size()), vols(times.size());
+        std::size_t clamped = 0;
+        for (std::size_t i = 0; i < times.size(); ++i) {
+            const double start = (i == 0) ? 0.0 : times[i - 1];
+            const double t = 0.5 * (start + times[i]);
+            const double ht = 0.25 * (times[i] - start);
+            const double scale = std::sqrt(t / t_max);
+            const double lo = std::min(p.y_lo * scale, -p.min_width), hi = std::max(p.y_hi * scale, p.min_width);
+            const double lnF = std::log(S0) + (r - q) * t;
+            spots[i].resize(p.spot_nodes);
+            vols[i].resize(p.spot_nodes);
+            for (std::size_t j = 0; j < p.spot_nodes; ++j) {
+                const double y = lo + (hi - lo) * j / (p.spot_nodes - 1);
+                const double w0 = w(y, t), wm = w(y - hy, t), wp = w(y + hy, t);
+                const double wy = (wp - wm) / (2.0 * hy), wyy = (wp - 2.0 * w0 + wm) / (hy * hy);
+                const double wt = (w(y, t + ht) - w(y, t - ht)) / (2.0 * ht);
+                const double den = 1.0 - y * wy / w0 + 0.25 * (-0.25 - 1.0 / w0 + y * y / (w0 * w0)) * wy * wy + 0.5 * wyy;
+                double v = (w0 > 0.0 && wt > 0.0 && den > 0.0) ? std::sqrt(wt / den) : p.vol_floor;
+                if (!(v > p.vol_floor) || !(v < p.vol_cap)) {
+                    v = std::clamp(std::isfinite(v) ? v : p.vol_cap, p.vol_floor, p.vol_cap);
+                    ++clamped;
+                }
+                spots[i][j] = std::exp(lnF + y);
+                vols[i][j] = v;
+            }
+        }
+        LocalVolSurface s(std::move(times), std::move(spots), std::move(vols));
+        s.clamped_ = clamped;
+        return s;
+    }
+
+    double LocalVolSurface::row_sigma(std::size_t i, double lnS) const {
+        const std::vector<double>& x = lnS_[i];
+        const std::vector<double>& v = vol_[i];
+        if (lnS <= x.front()) return v.front();
+        if (lnS >= x.back()) return v.back();
+        const std::size_t j = std::upper_bound(x.begin(), x.end(), lnS) - x.begin();
+        const double u = (lnS - x[j - 1]) / (x[j] - x[j - 1]);
+        return v[j - 1] + u * (v[j] - v[j - 1]);
+    }
+
+    double LocalVolSurface::sigma(double S, double t) const {
+        if (S <= 0.0) throw std::invalid_argument("Spot price must be positive.");
+        const double lnS = std::log(S);
+        const std::size_t i = std::lower_bound(t_.begin(), t_.end(), t) - t_.begin();
+        return row_sigma(std::min(i, t_.size() - 1), lnS);
+    }
+} // namespace opt
@@ -0,0 +1,311 @@
+// VolSurface.cpp: SVI smile calibration per expiry and a cached implied-vol surface sigma(K, T)
+#include "opt/VolSurface.hpp"
+#include "util/Parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace opt {
+    namespace {
+        constexpr int NP = 5; // a, b, rho, m, s
+
+        void to_array(const SVIParams& p, double x[NP]) {
+            x[0] = p.a; x[1] = p.b; x[2] = p.rho; x[3] = p.m; x[4] = p.s;
+        }
+
+        SVIParams from_array(const double x[NP]) {
+            return SVIParams{x[0], x[1], x[2], x[3], x[4]};
+        }
+
+        // Feasible set (see VolSurface::fit_svi); a is projected last since its bound depends on
+        // the others
+        void project(double x[NP], double T) {
+            x[2] = std::clamp(x[2], -0.999, 0.999);
+            x[4] = std::max(x[4], 1e-4);
+            x[1] = std::clamp(x[1], 0.0, 4.0 / (T * (1.0 + std::fabs(x[2]))));
+            x[0] = std::max(x[0], -x[1] * x[4] * std::sqrt(1.0 - x[2] * x[2]));
+        }
+
+        // Solves A x = rhs for a small dense system by Gaussian elimination with partial pivoting.
+        // Returns false if A is singular to working precision.
+        bool solve(double A[NP][NP], double rhs[NP], double x[NP]) {
+            for (int c = 0; c < NP; ++c) {
+                int piv = c;
+                for (int r = c + 1; r < NP; ++r) if (std::fabs(A[r][c]) > std::fabs(A[piv][c])) piv = r;
+                if (std::fabs(A[piv][c]) < 1e-300) return false;
+                if (piv != c) {
+                    for (int j = 0; j < NP; ++j) std::swap(A[c][j], A[piv][j]);
+                    std::swap(rhs[c], rhs[piv]);
+                }
+                for (int r = c + 1; r < NP; ++r) {
+                    const double f = A[r][c] / A[c][c];
+                    for (int j = c; j < NP; ++j) A[r][j] -= f * A[c][j];
+                    rhs[r] -= f * rhs[c];
+                }
+            }
+            for (int c = NP - 1; c >= 0; --c) {
+                double s = rhs[c];
+                for (int j = c + 1; j < NP; ++j) s -= A[c][j] * x[j];
+                x[c] = s / A[c][c];
+            }
+            return true;
+        }
+
+        // Start from the chain: vertex at the lowest total variance, b and rho from the slopes
+        // out to each end of the chain
+        SVIParams initial_guess(const std::vector<double>& k, const std::vector<double>& w) {
+            const std::size_t lo = std::min_element(k.begin(), k.end()) - k.begin();
+            const std::size_t hi = std::max_element(k.begin(), k.end()) - k.begin();
+            const std::size_t vx = std::min_element(w.begin(), w.end()) - w.begin();
+            double sL = (k[vx] > k[lo]) ? (w[lo] - w[vx]) / (k[lo] - k[vx]) : -0.1;
+            double sR = (k[hi] > k[vx]) ? (w[hi] - w[vx]) / (k[hi] - k[vx]) : 0.1;
+            sL = std::min(sL, -1e-3);
+            sR = std::max(sR, 1e-3);
+            SVIParams g;
+            g.b = 0.5 * (sR - sL);
+            g.rho = (sR + sL) / (sR - sL);
+            g.m = k[vx];
+            g.s = 0.1;
+            g.a = w[vx] - g.b * g.s * std::sqrt(1.0 - g.rho * g.rho);
+            return g;
+        }
+    } // namespace
+
+    double SVIParams::w(double k) const {
+        const double d = k - m;
+        return a + b * (rho * d + std::sqrt(d * d + s * s));
+    }
+
+    double SVIParams::dw(double k) const {
+        const double d = k - m;
+        return b * (rho + d / std::sqrt(d * d + s * s));
+    }
+
+    SVIFit VolSurface::fit_svi(const SmileSlice& slice, const SVICalibrationParams& p, const SVIParams* guess) {
+        const std::size_t n = slice.strikes.size();
+        if (slice.T <= 0.0) throw std::invalid_argument("Time to maturity must be positive.");
+        if (slice.forward <= 0.0) throw std::invalid_argument("Forward must be positive.");
+        if (slice.ivs.size() != n) throw std::invalid_argument("Strike and implied vol counts must match.");
+        if (!slice.weights.empty() && slice.weights.size() != n) throw std::invalid_argument("Weight count must match the strike count.");
+        if (n < static_cast<std::size_t>(NP)) throw std::invalid_argument("An SVI slice needs at least five quotes.");
+        if (p.max_iter <= 0) throw std::invalid_argument("Iteration limit must be positive.");
+
+        const double T = slice.T;
+        std::vector<double> k(n), wm(n), sw(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (slice.strikes[i] <= 0.0) throw std::invalid_argument("Strike price must be positive.");
+            if (slice.ivs[i] <= 0.0) throw std::invalid_argument("Implied volatility must be positive.");
+            const double wt = slice.weights.empty() ? 1.0 : slice.weights[i];
+            if (wt < 0.0) throw std::invalid_argument("Weights must be non-negative.");
+            k[i] = std::log(slice.strikes[i] / slice.forward);
+            wm[i] = slice.ivs[i] * slice.ivs[i] * T;
+            sw[i] = std::sqrt(wt);
+        }
+
+        double x[NP];
+        to_array(guess ? *guess : initial_guess(k, wm), x);
+        project(x, T);
+
+        // Weighted residuals sw_i (w(k_i) - wm_i) and, with J, the normal equations J^T J, J^T r.
+        // dw/da = 1, dw/db = rho d + R, dw/drho = b d, dw/dm = -b (rho + d / R), dw/ds = b s / R,
+        // d = k - m, R = sqrt(d^2 + s^2).
+        auto cost = [&](const double* y) {
+            double c = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const double d = k[i] - y[3];
+                const double r = sw[i] * (y[0] + y[1] * (y[2] * d + std::sqrt(d * d + y[4] * y[4])) - wm[i]);
+                c += r * r;
+            }
+            return c;
+        };
+
+        double c = cost(x);
+        double lambda = 1e-3;
+        int it = 0;
+        for (; it < p.max_iter && c > 1e-30; ++it) {
+            double JtJ[NP][NP] = {}, Jtr[NP] = {};
+            for (std::size_t i = 0; i < n; ++i) {
+                const double d = k[i] - x[3];
+                const double R = std::sqrt(d * d + x[4] * x[4]);
+                const double r = sw[i] * (x[0] + x[1] * (x[2] * d + R) - wm[i]);
+                const double J[NP] = {sw[i],
+                                      sw[i] * (x[2] * d + R),
+                                      sw[i] * x[1] * d,
+                                      -sw[i] * x[1] * (x[2] + d / R),
+                                      sw[i] * x[1] * x[4] / R};
+                for (int a = 0; a < NP; ++a) {
+                    Jtr[a] += J[a] * r;
+                    for (int b = 0; b <= a; ++b) JtJ[a][b] += J[a] * J[b];
+                }
+            }
+            for (int a = 0; a < NP; ++a) for (int b = 0; b < a; ++b) JtJ[b][a] = JtJ[a][b];
+
+            bool improved = false;
+            while (lambda < 1e12) {
+                double A[NP][NP], rhs[NP], step[NP], trial[NP];
+                for (int a = 0; a < NP; ++a) {
+                    for (int b = 0; b < NP; ++b) A[a][b] = JtJ[a][b];
+                    A[a][a] += lambda * (JtJ[a][a] + 1e-12);
+                    rhs[a] = -Jtr[a];
+                }
+                if (solve(A, rhs, step)) {
+                    for (int a = 0; a < NP; ++a) trial[a] = x[a] + step[a];
+                    project(trial, T);
+                    const double ct = cost(trial);
+                    if (ct < c) {
+                        const double drop = c - ct;
+                        std::copy(trial, trial + NP, x);
+                        c = ct;
+                        lambda = std::max(lambda / 3.0, 1e-12);
+                        improved = drop > p.tol * c;
+                        break;
+                    }
+                }
+                lambda *= 4.0;
+            }
+            if (!improved) break;
+        }
+
+        SVIFit fit;
+        fit.params = from_array(x);
+        fit.iterations = it;
+        double se = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double e = std::sqrt(std::max(fit.params.w(k[i]), 0.0) / T) - slice.ivs[i];
+            se += e * e;
+        }
+        fit.rmse_vol = std::sqrt(se / n);
+        return fit;
+    }
+
+    void VolSurface::fit_all(const std::vector<SmileSlice>& slices, const SVICalibrationParams& p, bool warm) {
+        if (slices.empty()) throw std::invalid_argument("A vol surface needs at least one expiry.");
+        std::vector<std::size_t> order(slices.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return slices[a].T < slices[b].T; });
+
+        std::vector<double> T(slices.size()), lnF(slices.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const SmileSlice& s = slices[order[i]];
+            if (s.T <= 0.0) throw std::invalid_argument("Time to maturity must be positive.");
+            if (s.forward <= 0.0) throw std::invalid_argument("Forward must be positive.");
+            if (i > 0 && s.T == T[i - 1]) throw std::invalid_argument("Expiries must be distinct.");
+            T[i] = s.T;
+            lnF[i] = std::log(s.forward);
+        }
+        if (warm && T != T_) throw std::invalid_argument("Recalibration needs the same expiries as the surface.");
+
+        const std::vector<SVIFit> previous = warm ? fits_ : std::vector<SVIFit>{};
+        std::vector<SVIFit> fits(slices.size());
+        util::parallel_for(slices.size(), [&](std::size_t i) {
+            fits[i] = fit_svi(slices[order[i]], p, warm ? &previous[i].params : nullptr);
+        }, p.threads);
+
+        T_ = std::move(T);
+        lnF_ = std::move(lnF);
+        fits_ = std::move(fits);
+    }
+
+    VolSurface VolSurface::calibrate(const std::vector<SmileSlice>& slices,
+                                     const SVICalibrationParams& p,
+                                     const VolGridParams& grid) {
+        if (grid.nodes < 2 || !(grid.k_hi > grid.k_lo)) throw std::invalid_argument("Vol grid needs at least two nodes on a non-empty k range.");
+        VolSurface s;
+        s.grid_ = grid;
+        s.dk_ = (grid.k_hi - grid.k_lo) / (grid.nodes - 1);
+        s.fit_all(slices, p, false);
+        s.build_cache();
+        return s;
+    }
+
+    void VolSurface::recalibrate(const std::vector<SmileSlice>& slices, const SVICalibrationParams& p) {
+        fit_all(slices, p, true);
+        build_cache();
+    }
+
+    void VolSurface::build_cache() {
+        const std::size_t ne = T_.size(), nk = grid_.nodes;
+        w_.assign(ne * nk, 0.0);
+        dw_.assign(ne * nk, 0.0);
+        repairs_ = 0;
+        for (std::size_t i = 0; i < ne; ++i) {
+            const SVIParams& sp = fits_[i].params;
+            for (std::size_t j = 0; j < nk; ++j) {
+                const double k = grid_.k_lo + j * dk_;
+                double w = sp.w(k), dw = sp.dw(k);
+                if (i > 0 && w < w_[(i - 1) * nk + j]) {
+                    w = w_[(i - 1) * nk + j];
+                    dw = dw_[(i - 1) * nk + j];
+                    ++repairs_;
+                }
+                w_[i * nk + j] = w;
+                dw_[i * nk + j] = dw;
+            }
+        }
+
+        bucket_.clear();
+        bucket_scale_ = 0.0;
+        if (ne >= 2) {
+            const std::size_t nb = 4 * ne;
+            bucket_scale_ = nb / (T_.back() - T_.front());
+            bucket_.resize(nb);
+            std::size_t i = 0;
+            for (std::size_t b = 0; b < nb; ++b) {
+                const double t = T_.front() + b / bucket_scale_;
+                while (i + 2 < ne && T_[i + 1] <= t) ++i;
+                bucket_[b] = i;
+            }
+        }
+    }
+
+    // Segment i (T_i <= T < T_{i+1}) for T inside [T_front, T_back]; needs two or more expiries
+    std::size_t VolSurface::bracket(double T) const {
+        const std::size_t nb = bucket_.size();
+        const double pos = (T - T_.front()) * bucket_scale_;
+        std::size_t i = bucket_[pos <= 0.0 ? 0 : std::min(nb - 1, static_cast<std::size_t>(pos))];
+        while (i + 2 < T_.size() && T_[i + 1] <= T) ++i;
+        return i;
+    }
+
+    double VolSurface::slice_w(std::size_t i, double k) const {
+        const std::size_t nk = grid_.nodes;
+        const double* w = &w_[i * nk];
+        const double* dw = &dw_[i * nk];
+        const double t = (k - grid_.k_lo) / dk_;
+        if (t <= 0.0) return std::max(0.0, w[0] + dw[0] * (k - grid_.k_lo));
+        if (t >= nk - 1) return std::max(0.0, w[nk - 1] + dw[nk - 1] * (k - grid_.k_hi));
+        const std::size_t j = static_cast<std::size_t>(t);
+        const double f = t - j, f2 = f * f, f3 = f2 * f;
+        return (2.0 * f3 - 3.0 * f2 + 1.0) * w[j] + (f3 - 2.0 * f2 + f) * dk_ * dw[j]
+             + (3.0 * f2 - 2.0 * f3) * w[j + 1] + (f3 - f2) * dk_ * dw[j + 1];
+    }
+
+    double VolSurface::forward(double T) const {
+        if (T_.size() == 1) return std::exp(lnF_[0]);
+        const std::size_t i = (T <= T_.front()) ? 0 : (T >= T_.back()) ? T_.size() - 2 : bracket(T);
+        const double u = (T - T_[i]) / (T_[i + 1] - T_[i]);
+        return std::exp(lnF_[i] + u * (lnF_[i + 1] - lnF_[i]));
+    }
+
+    double VolSurface::total_variance(double K, double T) const {
+        if (K <= 0.0) throw std::invalid_argument("Strike price must be positive.");
+        if (T <= 0.0) throw std::invalid_argument("Time to maturity must be positive.");
+        const std::size_t ne = T_.size();
+        if (T <= T_.front()) return slice_w(0, std::log(K / forward(T))) * T / T_.front();
+        if (T >= T_.back()) return slice_w(ne - 1, std::log(K / forward(T))) * T / T_.back();
+        const std::size_t i = bracket(T);
+        const double u = (T - T_[i]) / (T_[i + 1] - T_[i]);
+        const double k = std::log(K) - (lnF_[i] + u * (lnF_[i + 1] - lnF_[i]));
+        return (1.0 - u) * slice_w(i, k) + u * slice_w(i + 1, k);
+    }
+
+    double VolSurface::sigma(double K, double T) const {
+        return std::sqrt(total_variance(K, T) / T);
+    }
+
+    void VolSurface::sigma_batch(std::size_t n, const double* K, const double* T, double* out) const {
+        for (std::size_t i = 0; i < n; ++i) out[i] = sigma(K[i], T[i]);
+    }
+} // namespace opt
@@ -0,0 +1,265 @@
+// CrankNicolson.cpp: Crank-Nicolson local-volatility pricer with precomputed per-step coefficient tables
+#include "pde/CrankNicolson.hpp"
+#include "util/Parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace pde {
+    namespace {
+        constexpr int BANDS = 6;
+        enum Band { EL = 0, ED, EU, MULT, INV_PIVOT, UP };
+
+        // One step on a table block: x = (I - dt/2 L)^-1 ((I + dt/2 L) u + src), or
+        // (I - dt/2 L)^-1 (u + src) when implicit_only (a Rannacher half step); src may be null.
+        // Rows 0 and n - 1 are identity rows whose values are imposed. The explicit product is
+        // fused into the forward sweep.
+        void cn_step(const double* block, std::size_t n, const double* u, const double* src, double* x,
+                     double lo, double hi, bool implicit_only) {
+            const double* el = block + EL * n;
+            const double* ed = block + ED * n;
+            const double* eu = block + EU * n;
+            const double* mult = block + MULT * n;
+            const double* inv = block + INV_PIVOT * n;
+            const double* up = block + UP * n;
+            x[0] = lo;
+            if (implicit_only) {
+                for (std::size_t i = 1; i + 1 < n; ++i) x[i] = u[i] - mult[i] * x[i - 1];
+            } else {
+                for (std::size_t i = 1; i + 1 < n; ++i) {
+                    x[i] = el[i] * u[i - 1] + ed[i] * u[i] + eu[i] * u[i + 1] - mult[i] * x[i - 1];
+                }
+            }
+            if (src) {
+                // The source enters the rhs linearly, so it can be eliminated on its own pass
+                double carry = 0.0;
+                for (std::size_t i = 1; i + 1 < n; ++i) {
+                    carry = src[i] - mult[i] * carry;
+                    x[i] += carry;
+                }
+            }
+            x[n - 1] = hi * inv[n - 1];
+            for (std::size_t i = n - 1; i-- > 0;) x[i] = (x[i] - up[i] * x[i + 1]) * inv[i];
+        }
+    } // namespace
+
+    LocalVolPDE::LocalVolPDE(const opt::LocalVolSurface& lv,
+                             const opt::Market& m,
+                             std::vector<double> maturities,
+                             const CrankNicolsonParams& p)
+        : m_(m), p_(p) {
+        check_inputs(m, maturities, p);
+        std::sort(maturities.begin(), maturities.end());
+        maturities.erase(std::unique(maturities.begin(), maturities.end()), maturities.end());
+        maturities_ = std::move(maturities);
+
+        // Each maturity segment gets its share of the steps, so every maturity is a time node
+        const double T_max = maturities_.back();
+        t_.assign(1, 0.0);
+        for (double T : maturities_) {
+            const double t0 = t_.back();
+            const int steps = std::max(2, static_cast<int>(std::lround(p.time_steps * (T - t0) / T_max)));
+            for (int s = 1; s < steps; ++s) t_.push_back(t0 + (T - t0) * s / steps);
+            t_.push_back(T);
+            mat_step_.push_back(t_.size() - 1);
+        }
+
+        double sigma_ref = 0.0;
+        for (std::size_t s = 1; s < t_.size(); ++s) sigma_ref = std::max(sigma_ref, lv.sigma(m.S0, t_[s]));
+        const double half = p.width * sigma_ref * std::sqrt(T_max);
+        x0_ = std::log(m.S0) - half;
+        dx_ = 2.0 * half / p.space_nodes;
+
+        build_table(lv, false, backward_);
+        build_table(lv, true, forward_);
+    }
+
+    void LocalVolPDE::check_inputs(const opt::Market& m, const std::vector<double>& maturities, const CrankNicolsonParams& p) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot price must be positive.");
+        if (maturities.empty()) throw std::invalid_argument("PDE grid needs at least one maturity.");
+        for (double T : maturities) {
+            if (!(T > 0.0)) throw std::invalid_argument("Time to maturity must be positive.");
+        }
+        if (p.space_nodes < 4) throw std::invalid_argument("PDE grid needs at least 4 space intervals.");
+        if (p.time_steps < 2) throw std::invalid_argument("PDE needs at least 2 time steps.");
+        if (!(p.width > 0.0)) throw std::invalid_argument("PDE grid width must be positive.");
+    }
+
+    void LocalVolPDE::build_table(const opt::LocalVolSurface& lv, bool forward, std::vector<double>& table) const {
+        const std::size_t n = static_cast<std::size_t>(p_.space_nodes) + 1;
+        const std::size_t steps = t_.size() - 1;
+        table.assign(steps * BANDS * n, 0.0);
+        const double inv_dx2 = 1.0 / (dx_ * dx_), inv_2dx = 0.5 / dx_;
+        std::vector<double> lo(n), di(n), up(n);
+        for (std::size_t s = 0; s < steps; ++s) {
+            double* block = table.data() + s * BANDS * n;
+            const double h = 0.5 * (t_[s + 1] - t_[s]);
+            const double t_mid = 0.5 * (t_[s] + t_[s + 1]);
+            lo[0] = up[0] = lo[n - 1] = up[n - 1] = 0.0;
+            di[0] = di[n - 1] = 1.0;
+            for (std::size_t i = 1; i + 1 < n; ++i) {
+                const double sigma = lv.sigma(std::exp(x0_ + i * dx_), t_mid);
+                const double v = sigma * sigma;
+                const double drift = forward ? -(m_.r - m_.q + 0.5 * v) : (m_.r - m_.q - 0.5 * v);
+                const double a = 0.5 * v * inv_dx2 - drift * inv_2dx;
+                const double b = -v * inv_dx2 - (forward ? m_.q : m_.r);
+                const double c = 0.5 * v * inv_dx2 + drift * inv_2dx;
+                block[EL * n + i] = h * a;
+                block[ED * n + i] = 1.0 + h * b;
+                block[EU * n + i] = h * c;
+                lo[i] = -h * a;
+                di[i] = 1.0 - h * b;
+                up[i] = -h * c;
+            }
+            // LU factors of the implicit half, as in Tridiagonal
+            double* mult = block + MULT * n;
+            double* inv = block + INV_PIVOT * n;
+            double* upper = block + UP * n;
+            double pivot = di[0];
+            for (std::size_t i = 0;; ++i) {
+                inv[i] = 1.0 / pivot;
+                upper[i] = up[i];
+                if (i + 1 == n) break;
+                mult[i + 1] = lo[i + 1] * inv[i];
+                pivot = di[i + 1] - mult[i + 1] * up[i];
+            }
+        }
+    }
+
+    std::size_t LocalVolPDE::maturity_index(double T) const {
+        for (std::size_t j = 0; j < maturities_.size(); ++j) {
+            if (std::fabs(maturities_[j] - T) <= 1e-12 * maturities_[j]) return j;
+        }
+        throw std::invalid_argument("Maturity is not on the PDE time grid.");
+    }
+
+    // Quadratic Lagrange interpolation on the three nodes nearest x
+    double LocalVolPDE::interpolate(const double* u, double x) const {
+        const double pos = (x - x0_) / dx_;
+        const int k = std::clamp(static_cast<int>(std::lround(pos)) - 1, 0, p_.space_nodes - 2);
+        const double f = pos - (k + 1);
+        return 0.5 * f * (f - 1.0) * u[k] + (1.0 - f * f) * u[k + 1] + 0.5 * f * (f + 1.0) * u[k + 2];
+    }
+
+    std::vector<double> LocalVolPDE::strikes() const {
+        std::vector<double> K(static_cast<std::size_t>(p_.space_nodes) + 1);
+        for (std::size_t i = 0; i < K.size(); ++i) K[i] = std::exp(x0_ + i * dx_);
+        return K;
+    }
+
+    double LocalVolPDE::price(const opt::Option& opt) const {
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike price must be positive.");
+        const std::size_t last = mat_step_[maturity_index(opt.T)];
+        const bool put = (opt.type == opt::OptionType::Put);
+        const bool american = (opt.exercise == opt::Exercise::American);
+        const std::size_t n = static_cast<std::size_t>(p_.space_nodes) + 1;
+        const double K = opt.K;
+        const double S_lo = std::exp(x0_), S_hi = std::exp(x0_ + (n - 1) * dx_);
+
+        std::vector<double> pay(n), u(n), x(n), lam, src;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double S = std::exp(x0_ + i * dx_);
+            pay[i] = put ? std::max(K - S, 0.0) : std::max(S - K, 0.0);
+        }
+        u = pay;
+        if (american) {
+            lam.assign(n, 0.0);
+            src.assign(n, 0.0);
+        }
+
+        // American: Ikonen-Toivanen, as in HestonADI. The step carries the multiplier lam as a
+        // source, then projects onto the payoff and moves lam by what the projection added.
+        for (std::size_t s = last; s-- > 0;) {
+            const double tau = opt.T - t_[s];
+            const double dk = K * std::exp(-m_.r * tau);
+            double lo = 0.0, hi = 0.0;
+            if (put) {
+                lo = dk - S_lo * std::exp(-m_.q * tau);
+                if (american) lo = std::max(lo, K - S_lo);
+            } else {
+                hi = S_hi * std::exp(-m_.q * tau) - dk;
+                if (american) hi = std::max(hi, S_hi - K);
+            }
+            const double* block = backward_.data() + s * BANDS * n;
+            const int substeps = (p_.damping && s + 1 == last) ? 2 : 1;
+            const double h = (t_[s + 1] - t_[s]) / substeps;
+            for (int k = 0; k < substeps; ++k) {
+                if (american) {
+                    for (std::size_t i = 0; i < n; ++i) src[i] = h * lam[i];
+                }
+                cn_step(block, n, u.data(), american ? src.data() : nullptr, x.data(), lo, hi, substeps == 2);
+                if (american) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const double v = x[i];
+                        x[i] = std::max(v - h * lam[i], pay[i]);
+                        lam[i] = std::max(0.0, lam[i] + (pay[i] - v) / h);
+                    }
+                }
+                u.swap(x);
+            }
+        }
+        return interpolate(u.data(), std::log(m_.S0));
+    }
+
+    std::vector<double> LocalVolPDE::forward_calls() const {
+        const std::size_t n = static_cast<std::size_t>(p_.space_nodes) + 1;
+        const std::vector<double> K = strikes();
+        std::vector<double> calls(maturities_.size() * n);
+        std::vector<double> u(n), x(n);
+        for (std::size_t i = 0; i < n; ++i) u[i] = std::max(m_.S0 - K[i], 0.0);
+
+        std::size_t next = 0;
+        for (std::size_t s = 0; s + 1 < t_.size(); ++s) {
+            const double t = t_[s + 1];
+            const double lo = m_.S0 * std::exp(-m_.q * t) - K[0] * std::exp(-m_.r * t);
+            const double* block = forward_.data() + s * BANDS * n;
+            const int substeps = (p_.damping && s == 0) ? 2 : 1;
+            for (int k = 0; k < substeps; ++k) {
+                cn_step(block, n, u.data(), nullptr, x.data(), lo, 0.0, substeps == 2);
+                u.swap(x);
+            }
+            if (next < mat_step_.size() && mat_step_[next] == s + 1) {
+                std::copy(u.begin(), u.end(), calls.begin() + next * n);
+                ++next;
+            }
+        }
+        return calls;
+    }
+
+    std::vector<double> LocalVolPDE::price_all(const std::vector<opt::Option>& contracts) const {
+        std::vector<double> out(contracts.size());
+        std::vector<std::size_t> american;
+        bool any_european = false;
+        for (std::size_t c = 0; c < contracts.size(); ++c) {
+            const opt::Option& o = contracts[c];
+            if (o.K <= 0.0) throw std::invalid_argument("Strike price must be positive.");
+            (void)maturity_index(o.T);
+            if (o.exercise == opt::Exercise::American) american.push_back(c);
+            else any_european = true;
+        }
+
+        if (any_european) {
+            const std::size_t n = static_cast<std::size_t>(p_.space_nodes) + 1;
+            const std::vector<double> calls = forward_calls();
+            // Keep one node clear of each boundary for the three-point interpolation
+            const double x_lo = x0_ + dx_, x_hi = x0_ + (n - 2) * dx_;
+            for (std::size_t c = 0; c < contracts.size(); ++c) {
+                const opt::Option& o = contracts[c];
+                if (o.exercise == opt::Exercise::American) continue;
+                const double x = std::log(o.K);
+                if (x < x_lo || x > x_hi) throw std::invalid_argument("Strike lies outside the PDE grid.");
+                const double call = interpolate(calls.data() + maturity_index(o.T) * n, x);
+                out[c] = (o.type == opt::OptionType::Call)
+                    ? call
+                    : call - m_.S0 * std::exp(-m_.q * o.T) + o.K * std::exp(-m_.r * o.T);
+            }
+        }
+
+        util::parallel_for(american.size(), [&](std::size_t a) {
+            out[american[a]] = price(contracts[american[a]]);
+        }, p_.threads);
+        return out;
+    }
+
+} // namespace pde
@@ -0,0 +1,355 @@
+// HestonADI.cpp: ADI finite-difference pricer for European and American options under Heston
+#include "pde/HestonADI.hpp"
+#include "pde/Tridiagonal.hpp"
+#include "util/Parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace pde {
+    namespace {
+        // x_0..x_n = center + scale sinh(xi) with xi uniform between the images of lo and hi:
+        // spacing ~ scale near the centre, growing exponentially away from it
+        std::vector<double> sinh_grid(double lo, double hi, double center, double scale, int n) {
+            const double a = std::asinh((lo - center) / scale);
+            const double b = std::asinh((hi - center) / scale);
+            std::vector<double> x(n + 1);
+            for (int i = 0; i <= n; ++i) x[i] = center + scale * std::sinh(a + (b - a) * i / n);
+            x[0] = lo;
+            x[n] = hi;
+            return x;
+        }
+
+        // Weights on nodes i-1, i, i+1
+        struct Stencil {
+            double lo = 0.0, mid = 0.0, hi = 0.0;
+        };
+
+        // Central first and second derivatives on a non-uniform grid (second order for the first)
+        Stencil first_derivative(const std::vector<double>& x, int i) {
+            const double h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+            return {-h1 / (h0 * (h0 + h1)), (h1 - h0) / (h0 * h1), h0 / (h1 * (h0 + h1))};
+        }
+        Stencil second_derivative(const std::vector<double>& x, int i) {
+            const double h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+            return {2.0 / (h0 * (h0 + h1)), -2.0 / (h0 * h1), 2.0 / (h1 * (h0 + h1))};
+        }
+
+        // Semi-discrete Heston operator A = A0 + A1 + A2 on nodes k = j nS + i (S index fastest).
+        // A1 holds the S derivatives, A2 the v derivatives, A0 the mixed term; -r u is split
+        // evenly between A1 and A2. The S-boundary rows are zero (their values are imposed).
+        struct Operators {
+            int nS = 0, nV = 0;
+            std::vector<double> l1, d1, u1;  // per node
+            std::vector<double> l2, d2, u2;  // per v row: A2 is the same for every S column
+            std::vector<Stencil> dS, dV;     // first-derivative stencils of the mixed term
+            std::vector<double> c0;          // rho xi v S per node
+
+            Operators(const std::vector<double>& S, const std::vector<double>& V,
+                      const opt::Market& m, const pricers::HestonParams& h) {
+                nS = static_cast<int>(S.size());
+                nV = static_cast<int>(V.size());
+                const int m1 = nS - 1, m2 = nV - 1;
+                const std::size_t n = static_cast<std::size_t>(nS) * nV;
+                l1.assign(n, 0.0);
+                d1.assign(n, 0.0);
+                u1.assign(n, 0.0);
+                c0.assign(n, 0.0);
+                dS.assign(nS, Stencil{});
+                dV.assign(nV, Stencil{});
+                for (int i = 1; i < m1; ++i) dS[i] = first_derivative(S, i);
+                for (int j = 1; j < m2; ++j) dV[j] = first_derivative(V, j);
+
+                for (int j = 0; j < nV; ++j) {
+                    for (int i = 1; i < m1; ++i) {
+                        const std::size_t k = static_cast<std::size_t>(j) * nS + i;
+                        const Stencil f = dS[i], s = second_derivative(S, i);
+                        const double diff = 0.5 * V[j] * S[i] * S[i], drift = (m.r - m.q) * S[i];
+                        l1[k] = diff * s.lo + drift * f.lo;
+                        d1[k] = diff * s.mid + drift * f.mid - 0.5 * m.r;
+                        u1[k] = diff * s.hi + drift * f.hi;
+                        if (j > 0 && j < m2) c0[k] = h.rho * h.xi * V[j] * S[i];
+                    }
+                }
+
+                l2.assign(nV, 0.0);
+                d2.assign(nV, 0.0);
+                u2.assign(nV, 0.0);
+                // v = 0: the diffusion vanishes and the drift kappa theta >= 0 points into the
+                // grid, so a one-sided forward difference needs no boundary condition
+                const double h0 = V[1] - V[0];
+                d2[0] = -h.kappa * h.theta / h0 - 0.5 * m.r;
+                u2[0] = h.kappa * h.theta / h0;
+                for (int j = 1; j < m2; ++j) {
+                    const double diff = 0.5 * h.xi * h.xi * V[j], drift = h.kappa * (h.theta - V[j]);
+                    const Stencil s = second_derivative(V, j);
+                    // Far above the long-run variance the drift dominates the diffusion; upwind
+                    // it there (the region barely reaches prices near v0)
+                    Stencil f = dV[j];
+                    if (V[j] > 1.0) {
+                        const double hj = V[j] - V[j - 1];
+                        f = Stencil{-1.0 / hj, 1.0 / hj, 0.0};
+                    }
+                    l2[j] = diff * s.lo + drift * f.lo;
+                    d2[j] = diff * s.mid + drift * f.mid - 0.5 * m.r;
+                    u2[j] = diff * s.hi + drift * f.hi;
+                }
+                // v = v_max: u_v = 0 through a mirrored ghost node
+                const double hm = V[m2] - V[m2 - 1];
+                l2[m2] = h.xi * h.xi * V[m2] / (hm * hm);
+                d2[m2] = -l2[m2] - 0.5 * m.r;
+            }
+
+            // f0 = A0 u, f1 = A1 u, f2 = A2 u on v row j
+            void apply(const double* u, double* f0, double* f1, double* f2, int j) const {
+                const int m1 = nS - 1, m2 = nV - 1;
+                const std::size_t row = static_cast<std::size_t>(j) * nS;
+                // Rows past the v boundaries have zero weight; point them at row j
+                const double* dn = u + (j > 0 ? row - nS : row);
+                const double* at = u + row;
+                const double* up = u + (j < m2 ? row + nS : row);
+                const Stencil v = dV[j];
+                const double a = l2[j], b = d2[j], c = u2[j];
+                f0[row] = f1[row] = f2[row] = 0.0;
+                f0[row + m1] = f1[row + m1] = f2[row + m1] = 0.0;
+                for (int i = 1; i < m1; ++i) {
+                    const std::size_t k = row + i;
+                    const Stencil s = dS[i];
+                    f1[k] = l1[k] * at[i - 1] + d1[k] * at[i] + u1[k] * at[i + 1];
+                    f2[k] = a * dn[i] + b * at[i] + c * up[i];
+                    f0[k] = c0[k] * (v.lo * (s.lo * dn[i - 1] + s.mid * dn[i] + s.hi * dn[i + 1]) +
+                                     v.mid * (s.lo * at[i - 1] + s.mid * at[i] + s.hi * at[i + 1]) +
+                                     v.hi * (s.lo * up[i - 1] + s.mid * up[i] + s.hi * up[i + 1]));
+                }
+            }
+        };
+
+        // Factors of I - theta dt A1 (one per v row) and I - theta dt A2 (shared by all columns)
+        struct Factors {
+            std::vector<Tridiagonal> rows;
+            Tridiagonal cols;
+
+            Factors(const Operators& o, double th_dt) {
+                const int m1 = o.nS - 1;
+                std::vector<double> lo(o.nS), di(o.nS), up(o.nS);
+                rows.reserve(o.nV);
+                for (int j = 0; j < o.nV; ++j) {
+                    const std::size_t row = static_cast<std::size_t>(j) * o.nS;
+                    lo[0] = up[0] = lo[m1] = up[m1] = 0.0;
+                    di[0] = di[m1] = 1.0;
+                    for (int i = 1; i < m1; ++i) {
+                        lo[i] = -th_dt * o.l1[row + i];
+                        di[i] = 1.0 - th_dt * o.d1[row + i];
+                        up[i] = -th_dt * o.u1[row + i];
+                    }
+                    rows.emplace_back(lo, di, up);
+                }
+                std::vector<double> lv(o.nV), dv(o.nV), uv(o.nV);
+                for (int j = 0; j < o.nV; ++j) {
+                    lv[j] = -th_dt * o.l2[j];
+                    dv[j] = 1.0 - th_dt * o.d2[j];
+                    uv[j] = -th_dt * o.u2[j];
+                }
+                cols = Tridiagonal(lv, dv, uv);
+            }
+        };
+
+        // Quadratic Lagrange weights on the three nodes around `at`; returns the first of them
+        int lagrange3(const std::vector<double>& x, double at, double w[3]) {
+            const int n = static_cast<int>(x.size()) - 1;
+            const int c = static_cast<int>(std::upper_bound(x.begin(), x.end(), at) - x.begin());
+            int k = (c > n || at - x[c - 1] < x[c] - at) ? c - 2 : c - 1;
+            k = std::clamp(k, 0, n - 2);
+            const double x0 = x[k], x1 = x[k + 1], x2 = x[k + 2];
+            w[0] = (at - x1) * (at - x2) / ((x0 - x1) * (x0 - x2));
+            w[1] = (at - x0) * (at - x2) / ((x1 - x0) * (x1 - x2));
+            w[2] = (at - x0) * (at - x1) / ((x2 - x0) * (x2 - x1));
+            return k;
+        }
+    } // namespace
+
+    // Each ADI step from tau to tau + dt (in 't Hout & Foulon 2010, with F = A0 + A1 + A2):
+    //   Y0 = U + dt F(U) [+ dt lambda]
+    //   Yj = Y(j-1) + theta dt (Fj(Yj) - Fj(U)),    j = 1, 2   (implicit in S, then v)
+    // Douglas stops at Y2. The others correct with F evaluated at Y2:
+    //   Z0 = Y0 + dt/2 (F0(Y2) - F0(U)) + sigma dt (F1 + F2)(Y2) - (F1 + F2)(U))
+    //   Zj = Z(j-1) + theta dt (Fj(Zj) - Fj(R)),
+    // with sigma = 0 (CS), 1/2 - theta (MCS) or 1/2 (HV), and R = Y2 for HV, U otherwise.
+    // The stages run row by row (S solves) and in column blocks (v solves) on a fixed team of
+    // threads, with a barrier between phases.
+    double HestonADI::price(const opt::Market& m,
+                            const opt::Option& opt,
+                            const pricers::HestonParams& h,
+                            const HestonADIParams& p) {
+        check_inputs(m, opt, h, p);
+        const bool put = (opt.type == opt::OptionType::Put);
+        const bool american = (opt.exercise == opt::Exercise::American);
+        const double K = opt.K;
+        const int m1 = p.spot_nodes, m2 = p.var_nodes;
+        const int nS = m1 + 1, nV = m2 + 1;
+        const std::size_t n = static_cast<std::size_t>(nS) * nV;
+
+        const double S_max = p.spot_max * std::max(K, m.S0);
+        const std::vector<double> S = sinh_grid(0.0, S_max, K, p.spot_density * K, m1);
+        const std::vector<double> V = sinh_grid(0.0, p.var_max, 0.0, p.var_density * p.var_max, m2);
+        const Operators ops(S, V, m, h);
+
+        double theta = p.theta;
+        if (theta <= 0.0) {
+            switch (p.scheme) {
+                case ADIScheme::ModifiedCraigSneyd: theta = 1.0 / 3.0; break;
+                case ADIScheme::HundsdorferVerwer: theta = 0.5 + std::sqrt(3.0) / 6.0; break;
+                default: theta = 0.5; break;
+            }
+        }
+        const double dt = opt.T / p.time_steps;
+        const Factors main_factors(ops, theta * dt);
+        // Damping: the first step as two implicit (theta = 1) Douglas half steps
+        const Factors damp_factors(ops, p.damping ? 0.5 * dt : theta * dt);
+
+        // Imposed values on the S boundaries at time to maturity tau
+        auto boundary = [&](double tau, bool top) {
+            const double dk = K * std::exp(-m.r * tau);
+            if (put) return top ? 0.0 : (american ? K : dk);
+            if (!top) return 0.0;
+            const double fwd = S_max * std::exp(-m.q * tau) - dk;
+            return american ? std::max(fwd, S_max - K) : fwd;
+        };
+
+        std::vector<double> u(n), pay(n), lam(n, 0.0), y0(n), y(n), z(n);
+        std::vector<double> a0(n), a1(n), a2(n), b0(n), b1(n), b2(n);
+        for (int j = 0; j < nV; ++j) {
+            for (int i = 0; i < nS; ++i) {
+                pay[static_cast<std::size_t>(j) * nS + i] = put ? std::max(K - S[i], 0.0) : std::max(S[i] - K, 0.0);
+            }
+        }
+        u = pay;
+
+        const unsigned threads = static_cast<unsigned>(std::min<int>(std::max(1u, p.threads), std::max(1, m1 - 1)));
+        util::SpinBarrier barrier(threads);
+
+        auto worker = [&](unsigned w) {
+            // Contiguous v rows for the S stages, contiguous interior S columns for the v stages
+            const int row_block = (nV + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+            const int j0 = std::min(nV, static_cast<int>(w) * row_block), j1 = std::min(nV, j0 + row_block);
+            const int col_block = (m1 - 1 + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+            const int i0 = 1 + std::min(m1 - 1, static_cast<int>(w) * col_block);
+            const int i1 = 1 + std::min(m1 - 1, static_cast<int>(w) * col_block + col_block);
+
+            // Implicit S stage on rows [j0, j1): x = rhs - theta dt r, then solve
+            auto solve_rows = [&](const Factors& f, double* x, const double* r, double th_dt, double tau) {
+                for (int j = j0; j < j1; ++j) {
+                    const std::size_t row = static_cast<std::size_t>(j) * nS;
+                    for (int i = 1; i < m1; ++i) x[row + i] -= th_dt * r[row + i];
+                    x[row] = boundary(tau, false);
+                    x[row + m1] = boundary(tau, true);
+                    f.rows[j].solve(x + row);
+                }
+            };
+            // Implicit v stage on columns [i0, i1)
+            auto solve_cols = [&](const Factors& f, double* x, const double* r, double th_dt) {
+                for (int j = 0; j < nV; ++j) {
+                    const std::size_t row = static_cast<std::size_t>(j) * nS;
+                    for (int i = i0; i < i1; ++i) x[row + i] -= th_dt * r[row + i];
+                }
+                if (i1 > i0) f.cols.solve_many(x + i0, nS, static_cast<std::size_t>(i1 - i0));
+            };
+
+            auto step = [&](double h_dt, double th, ADIScheme scheme, const Factors& f, double tau) {
+                const double th_dt = th * h_dt;
+                for (int j = j0; j < j1; ++j) {
+                    ops.apply(u.data(), a0.data(), a1.data(), a2.data(), j);
+                    const std::size_t row = static_cast<std::size_t>(j) * nS;
+                    for (std::size_t k = row; k < row + nS; ++k) {
+                        y0[k] = u[k] + h_dt * (a0[k] + a1[k] + a2[k] + lam[k]);
+                        y[k] = y0[k];
+                    }
+                }
+                solve_rows(f, y.data(), a1.data(), th_dt, tau);
+                barrier.arrive_and_wait();
+                solve_cols(f, y.data(), a2.data(), th_dt);
+                barrier.arrive_and_wait();
+
+                double* out = y.data();
+                if (scheme != ADIScheme::Douglas) {
+                    const bool hv = (scheme == ADIScheme::HundsdorferVerwer);
+                    const double sigma = hv ? 0.5 : (scheme == ADIScheme::ModifiedCraigSneyd ? 0.5 - th : 0.0);
+                    for (int j = j0; j < j1; ++j) {
+                        ops.apply(y.data(), b0.data(), b1.data(), b2.data(), j);
+                        const std::size_t row = static_cast<std::size_t>(j) * nS;
+                        for (std::size_t k = row; k < row + nS; ++k) {
+                            z[k] = y0[k] + 0.5 * h_dt * (b0[k] - a0[k]) + sigma * h_dt * (b1[k] + b2[k] - a1[k] - a2[k]);
+                        }
+                    }
+                    solve_rows(f, z.data(), hv ? b1.data() : a1.data(), th_dt, tau);
+                    barrier.arrive_and_wait();
+                    solve_cols(f, z.data(), hv ? b2.data() : a2.data(), th_dt);
+                    barrier.arrive_and_wait();
+                    out = z.data();
+                }
+
+                // Ikonen-Toivanen update: project onto the payoff and move the multiplier by
+                // the amount the projection added
+                for (int j = j0; j < j1; ++j) {
+                    const std::size_t row = static_cast<std::size_t>(j) * nS;
+                    for (std::size_t k = row; k < row + nS; ++k) {
+                        if (american) {
+                            u[k] = std::max(out[k] - h_dt * lam[k], pay[k]);
+                            lam[k] = std::max(0.0, lam[k] + (pay[k] - out[k]) / h_dt);
+                        } else {
+                            u[k] = out[k];
+                        }
+                    }
+                }
+                barrier.arrive_and_wait();
+            };
+
+            int first = 1;
+            if (p.damping) {
+                step(0.5 * dt, 1.0, ADIScheme::Douglas, damp_factors, 0.5 * dt);
+                step(0.5 * dt, 1.0, ADIScheme::Douglas, damp_factors, dt);
+                first = 2;
+            }
+            for (int s = first; s <= p.time_steps; ++s) step(dt, theta, p.scheme, main_factors, s * dt);
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : pool) t.join();
+
+        double ws[3], wv[3];
+        const int ks = lagrange3(S, m.S0, ws);
+        const int kv = lagrange3(V, h.v0, wv);
+        double value = 0.0;
+        for (int b = 0; b < 3; ++b) {
+            for (int a = 0; a < 3; ++a) value += wv[b] * ws[a] * u[static_cast<std::size_t>(kv + b) * nS + ks + a];
+        }
+        return value;
+    }
+
+    void HestonADI::check_inputs(const opt::Market& m,
+                                 const opt::Option& opt,
+                                 const pricers::HestonParams& h,
+                                 const HestonADIParams& p) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot price must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike price must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to maturity must be positive.");
+        if (h.v0 < 0.0) throw std::invalid_argument("Heston initial variance must be non-negative.");
+        if (h.kappa <= 0.0) throw std::invalid_argument("Heston mean reversion must be positive.");
+        if (h.theta < 0.0) throw std::invalid_argument("Heston long-run variance must be non-negative.");
+        if (h.xi <= 0.0) throw std::invalid_argument("Heston vol of variance must be positive.");
+        if (h.rho < -1.0 || h.rho > 1.0) throw std::invalid_argument("Heston correlation must lie in [-1, 1].");
+        if (p.spot_nodes < 4 || p.var_nodes < 4) throw std::invalid_argument("ADI grid needs at least 4 intervals per direction.");
+        if (p.time_steps < 2) throw std::invalid_argument("ADI needs at least 2 time steps.");
+        if (p.theta < 0.0 || p.theta > 1.0) throw std::invalid_argument("ADI theta must lie in [0, 1].");
+        if (p.spot_max <= 1.0) throw std::invalid_argument("Spot grid must extend beyond the strike and spot.");
+        if (p.spot_density <= 0.0 || p.var_density <= 0.0) throw std::invalid_argument("Grid densities must be positive.");
+        if (!(p.var_max > h.v0)) throw std::invalid_argument("Variance grid must extend beyond the initial variance.");
+    }
+
+} // namespace pde
@@ -0,0 +1,53 @@
+// Tridiagonal.cpp: Factored tridiagonal systems (Thomas algorithm) for implicit finite-difference steps
+#include "pde/Tridiagonal.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace pde {
+
+    Tridiagonal::Tridiagonal(const std::vector<double>& lower, const std::vector<double>& diag, const std::vector<double>& upper) {
+        const std::size_t n = diag.size();
+        if (n == 0) throw std::invalid_argument("Tridiagonal matrix must not be empty.");
+        if (lower.size() != n || upper.size() != n) throw std::invalid_argument("Tridiagonal bands must have the same length.");
+
+        mult_.assign(n, 0.0);
+        inv_pivot_.resize(n);
+        upper_ = upper;
+        upper_[n - 1] = 0.0;
+        double pivot = diag[0];
+        for (std::size_t i = 0;; ++i) {
+            if (pivot == 0.0 || !std::isfinite(pivot)) throw std::invalid_argument("Tridiagonal matrix is singular.");
+            inv_pivot_[i] = 1.0 / pivot;
+            if (i + 1 == n) break;
+            mult_[i + 1] = lower[i + 1] * inv_pivot_[i];
+            pivot = diag[i + 1] - mult_[i + 1] * upper_[i];
+        }
+    }
+
+    void Tridiagonal::solve(double* x) const {
+        const std::size_t n = size();
+        for (std::size_t i = 1; i < n; ++i) x[i] -= mult_[i] * x[i - 1];
+        x[n - 1] *= inv_pivot_[n - 1];
+        for (std::size_t i = n - 1; i-- > 0;) x[i] = (x[i] - upper_[i] * x[i + 1]) * inv_pivot_[i];
+    }
+
+    void Tridiagonal::solve_many(double* x, std::size_t stride, std::size_t count) const {
+        const std::size_t n = size();
+        for (std::size_t i = 1; i < n; ++i) {
+            double* row = x + i * stride;
+            const double* prev = row - stride;
+            const double l = mult_[i];
+            for (std::size_t k = 0; k < count; ++k) row[k] -= l * prev[k];
+        }
+        double* last = x + (n - 1) * stride;
+        for (std::size_t k = 0; k < count; ++k) last[k] *= inv_pivot_[n - 1];
+        for (std::size_t i = n - 1; i-- > 0;) {
+            double* row = x + i * stride;
+            const double* next = row + stride;
+            const double c = upper_[i], w = inv_pivot_[i];
+            for (std::size_t k = 0; k < count; ++k) row[k] = (row[k] - c * next[k]) * w;
+        }
+    }
+
+} // namespace pde
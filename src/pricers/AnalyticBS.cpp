@@ -3,6 +3,7 @@
 #include "util/Math.hpp"
 #include <stdexcept> 
 #include <cmath> 
+#include <vector>
 
 namespace pricers {
     void AnalyticBS::check_inputs(const opt::Market& m, const opt::Option& o) {
@@ -24,22 +25,98 @@ namespace pricers {
         d2 = d1  - volSqrtT;
     }
 
+    // Shared price kernel; for Real = double this is the exact arithmetic of AnalyticBS::price
+    template <typename Real>
+    static inline Real bs_price_kernel(Real S0, Real K, Real T, Real r, Real q, Real sig, bool is_call) {
+        const Real sqrtT = std::sqrt(T);
+        const Real volSqrtT = sig * sqrtT;
+
+        const Real lnSK = std::log(S0 / K);
+        const Real d1 = (lnSK + (r - q + Real(0.5) * sig * sig) * T) / volSqrtT;
+        const Real d2 = d1 - volSqrtT;
+
+        const Real discFactorR = std::exp(-r * T);
+        const Real discFactorQ = std::exp(-q * T);
+
+        if (is_call) {
+            return S0 * discFactorQ * util::normal_cdf(d1) - K * discFactorR * util::normal_cdf(d2);
+        } else {
+            return K * discFactorR * util::normal_cdf(-d2) - S0 * discFactorQ * util::normal_cdf(-d1);
+        }
+    }
+
+    // Same price written on discount factors: F = S0 Dq / Dr, d1 = (ln(F/K) + sigma^2 T / 2) / (sigma sqrt T)
+    static inline double bs_price_discounted(double S0, double K, double T, double Dr, double Dq, double sig, bool is_call) {
+        const double volSqrtT = sig * std::sqrt(T);
+        const double F = S0 * Dq / Dr;
+        const double d1 = std::log(F / K) / volSqrtT + 0.5 * volSqrtT;
+        const double d2 = d1 - volSqrtT;
+        if (is_call) {
+            return Dr * (F * util::normal_cdf(d1) - K * util::normal_cdf(d2));
+        } else {
+            return Dr * (K * util::normal_cdf(-d2) - F * util::normal_cdf(-d1));
+        }
+    }
+
     double AnalyticBS::price(const opt::Market& m, const opt::Option& o) {
         check_inputs(m, o);
+        return bs_price_kernel<double>(m.S0, o.K, o.T, m.r, m.q, m.sigma, o.type == opt::OptionType::Call);
+    }
 
-        double d1, d2;
-        d1d2(m, o, d1, d2);
+    template <typename Real>
+    Real AnalyticBS::price_as(const opt::Market& m, const opt::Option& o) {
+        check_inputs(m, o);
+        return bs_price_kernel<Real>(static_cast<Real>(m.S0), static_cast<Real>(o.K), static_cast<Real>(o.T),
+                                     static_cast<Real>(m.r), static_cast<Real>(m.q), static_cast<Real>(m.sigma),
+                                     o.type == opt::OptionType::Call);
+    }
 
-        const double discFactorR = std::exp(-m.r * o.T);
-        const double discFactorQ = std::exp(-m.q * o.T);
+    template <typename Real>
+    void AnalyticBS::price_batch(std::size_t n,
+                                 const Real* S0, const Real* K, const Real* T,
+                                 const Real* r, const Real* q, const Real* sigma,
+                                 const opt::OptionType* type,
+                                 Real* out) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = bs_price_kernel<Real>(S0[i], K[i], T[i], r[i], q[i], sigma[i], type[i] == opt::OptionType::Call);
+        }
+    }
 
-        if (o.type == opt::OptionType::Call) {
-            return m.S0 * discFactorQ * util::normal_cdf(d1) - o.K * discFactorR * util::normal_cdf(d2);
-        } else {
-            return o.K * discFactorR * util::normal_cdf(-d2) - m.S0 * discFactorQ * util::normal_cdf(-d1);
+    double AnalyticBS::price(const opt::Market& m, const opt::Option& o, const opt::Curve& r, const opt::Curve& q) {
+        check_inputs(m, o);
+        return bs_price_discounted(m.S0, o.K, o.T, r.discount(o.T), q.discount(o.T), m.sigma, o.type == opt::OptionType::Call);
+    }
+
+    void AnalyticBS::price_batch_discounted(std::size_t n,
+                                            const double* S0, const double* K, const double* T,
+                                            const double* Dr, const double* Dq, const double* sigma,
+                                            const opt::OptionType* type,
+                                            double* out) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = bs_price_discounted(S0[i], K[i], T[i], Dr[i], Dq[i], sigma[i], type[i] == opt::OptionType::Call);
         }
     }
 
+    void AnalyticBS::price_batch(std::size_t n,
+                                 const double* S0, const double* K, const double* T,
+                                 const opt::Curve& r, const opt::Curve& q, const double* sigma,
+                                 const opt::OptionType* type,
+                                 double* out) {
+        std::vector<double> Dr(n), Dq(n);
+        r.discount_batch(n, T, Dr.data());
+        q.discount_batch(n, T, Dq.data());
+        price_batch_discounted(n, S0, K, T, Dr.data(), Dq.data(), sigma, type, out);
+    }
+
+    template float AnalyticBS::price_as<float>(const opt::Market&, const opt::Option&);
+    template double AnalyticBS::price_as<double>(const opt::Market&, const opt::Option&);
+    template void AnalyticBS::price_batch<float>(std::size_t, const float*, const float*, const float*,
+                                                 const float*, const float*, const float*,
+                                                 const opt::OptionType*, float*);
+    template void AnalyticBS::price_batch<double>(std::size_t, const double*, const double*, const double*,
+                                                  const double*, const double*, const double*,
+                                                  const opt::OptionType*, double*);
+
     Greeks AnalyticBS::greeks(const opt::Market& m, const opt::Option& o) {
         check_inputs(m, o);
 
@@ -0,0 +1,276 @@
+// AndersenLakeOffengelt.cpp: High-accuracy American pricer (Andersen-Lake-Offengelt 2016)
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "util/Math.hpp"
+#include "util/Quadrature.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace pricers {
+
+    namespace {
+        struct PutModel {
+            double K, r, q, sigma;
+
+            double d_plus(double tau, double z) const {
+                return (std::log(z) + (r - q + 0.5 * sigma * sigma) * tau) / (sigma * std::sqrt(tau));
+            }
+            double d_minus(double tau, double z) const {
+                return d_plus(tau, z) - sigma * std::sqrt(tau);
+            }
+            double european_put(double tau, double S) const {
+                return K * std::exp(-r * tau) * util::normal_cdf(-d_minus(tau, S / K))
+                     - S * std::exp(-q * tau) * util::normal_cdf(-d_plus(tau, S / K));
+            }
+        };
+
+        // Put boundary B(tau) = X exp(-sqrt(H(xi))), xi = sqrt(tau), H Chebyshev-interpolated on [0, sqrt(T)]
+        struct PutBoundary {
+            double X = 0.0;
+            double sqrtT = 0.0;
+            std::vector<double> coefs;
+
+            // -ln(B/X) at xi = sqrt(tau)
+            double neg_log_at(double xi) const {
+                if (xi <= 0.0) return 0.0;
+                const double z = 2.0 * xi / sqrtT - 1.0;
+                return std::sqrt(std::max(util::chebyshev_eval(coefs, std::min(1.0, z)), 0.0));
+            }
+            double at_sqrt_tau(double xi) const { return X * std::exp(-neg_log_at(xi)); }
+            double operator()(double tau) const { return at_sqrt_tau(std::sqrt(std::max(tau, 0.0))); }
+        };
+
+        // QD (Li 2010, without the "+" correction) boundary estimate used as the initial guess.
+        // Root of g(S) = 1 - e^{-q tau} N(-d+) + lambda (K - S - p(tau, S)) / S, found in ln S by Illinois false position.
+        double qd_boundary(const PutModel& pm, double tau, double X) {
+            const double s2 = pm.sigma * pm.sigma;
+            const double h = 1.0 - std::exp(-pm.r * tau);
+            const double beta = 2.0 * (pm.r - pm.q) / s2;
+            const double lambda = 0.5 * (-(beta - 1.0) - std::sqrt((beta - 1.0) * (beta - 1.0) + 8.0 * pm.r / (s2 * h)));
+            const double Dq = std::exp(-pm.q * tau);
+
+            auto g = [&](double x) {
+                const double S = std::exp(x);
+                return 1.0 - Dq * util::normal_cdf(-pm.d_plus(tau, S / pm.K))
+                     + lambda * (pm.K - S - pm.european_put(tau, S)) / S;
+            };
+
+            double hi = std::log(X), g_hi = g(hi);
+            double lo = hi - 8.0 * pm.sigma * std::sqrt(tau) - 1.0, g_lo = g(lo);
+            if (g_lo > 0.0 || g_hi < 0.0) return X;
+            int side = 0;
+            for (int it = 0; it < 100 && hi - lo > 1e-12; ++it) {
+                const double x = (lo * g_hi - hi * g_lo) / (g_hi - g_lo);
+                const double gx = g(x);
+                if (gx == 0.0) return std::exp(x);
+                if (gx < 0.0) {
+                    lo = x; g_lo = gx;
+                    if (side == -1) g_hi *= 0.5;
+                    side = -1;
+                } else {
+                    hi = x; g_hi = gx;
+                    if (side == 1) g_lo *= 0.5;
+                    side = 1;
+                }
+                if (std::fabs(gx) < 1e-14) break;
+            }
+            return std::exp((lo * g_hi - hi * g_lo) / (g_hi - g_lo));
+        }
+
+        PutBoundary solve_put_boundary(const PutModel& pm, double T, const ALOParams& p) {
+            const int n = p.collocation_nodes;
+            const int l = p.quadrature_nodes;
+            PutBoundary B;
+            B.X = (pm.q > 0.0) ? pm.K * std::min(1.0, pm.r / pm.q) : pm.K;
+            B.sqrtT = std::sqrt(T);
+
+            // Collocation times: Chebyshev extrema in sqrt(tau); node n is tau = 0
+            std::vector<double> tau(n + 1), H(n + 1, 0.0);
+            for (int i = 0; i <= n; ++i) {
+                const double xi = 0.5 * B.sqrtT * (1.0 + util::chebyshev_node(i, n));
+                tau[i] = (i == n) ? 0.0 : xi * xi;
+            }
+            for (int i = 0; i < n; ++i) {
+                const double lnB = std::log(qd_boundary(pm, tau[i], B.X) / B.X);
+                H[i] = lnB * lnB;
+            }
+            util::chebyshev_coefficients(H, B.coefs);
+
+            // B = K e^{-(r-q)tau} N / D, in one of two fixed-point forms (ALO 2016):
+            // FP-B (smooth-pasting form, fast contraction)
+            //   N = phi(d-)/(sig sqrt(tau)) + r int_0^tau e^{ru} phi(d-(tau-u, B/B(u))) / (sig sqrt(tau-u)) du
+            //   D = phi(d+)/(sig sqrt(tau)) + Phi(d+) + q int_0^tau e^{qu} [phi(d+(..))/(sig sqrt(tau-u)) + Phi(d+(..))] du
+            // FP-A (value-matching form, slower but contracting where FP-B is not)
+            //   N = Phi(d-) + r int_0^tau e^{ru} Phi(d-(tau-u, B/B(u))) du
+            //   D = Phi(d+) + q int_0^tau e^{qu} Phi(d+(tau-u, B/B(u))) du
+            // Substituting u = tau sin^2(theta) removes both the 1/sqrt(tau-u) singularity at u = tau and
+            // the sqrt(u) kink of B(u) at u = 0, so Gauss-Legendre converges spectrally in theta.
+            std::vector<double> y, w;
+            util::gauss_legendre(l, y, w);
+
+            // Everything but B(u) is fixed across iterations, so tabulate it per (node, abscissa) once
+            const double sig = pm.sigma;
+            const double mu = pm.r - pm.q + 0.5 * sig * sig;
+            const double ln_XK = std::log(B.X / pm.K);
+            std::vector<double> xi_u(n * l), sd(n * l), drift(n * l);
+            std::vector<double> wn_pdf(n * l), wd_pdf(n * l), wn_cdf(n * l), wd_cdf(n * l);
+            for (int i = 0; i < n; ++i) {
+                const double t = tau[i];
+                const double sqrt_t = std::sqrt(t);
+                for (int k = 0; k < l; ++k) {
+                    const double theta = 0.25 * util::PI * (1.0 + y[k]);
+                    const double st = std::sin(theta), ct = std::cos(theta);
+                    const double u = t * st * st;
+                    // du / sqrt(tau-u) = 2 sqrt(tau) sin(theta) dtheta ; du = 2 tau sin(theta) cos(theta) dtheta
+                    const double wk = w[k] * 0.25 * util::PI * 2.0 * st;
+                    const double er = pm.r * std::exp(pm.r * u), eq = pm.q * std::exp(pm.q * u);
+                    const int idx = i * l + k;
+                    xi_u[idx] = sqrt_t * st;
+                    sd[idx] = sig * sqrt_t * ct; // sig sqrt(tau - u)
+                    drift[idx] = mu * t * ct * ct;
+                    wn_pdf[idx] = wk * er * sqrt_t / sig;
+                    wd_pdf[idx] = wk * eq * sqrt_t / sig;
+                    wn_cdf[idx] = wk * er * t * ct;
+                    wd_cdf[idx] = wk * eq * t * ct;
+                }
+            }
+
+            auto iterate = [&](std::vector<double>& H, bool fp_b, int iterations) {
+                std::vector<double> H_next(n + 1, 0.0);
+                double last_step = INFINITY;
+                for (int it = 0; it < iterations; ++it) {
+                    double step = 0.0;
+                    for (int i = 0; i < n; ++i) {
+                        const double t = tau[i];
+                        const double sd_t = sig * std::sqrt(t);
+                        const double a_t = std::sqrt(H[i]); // -ln(B(tau)/X)
+
+                        const double dp = (ln_XK - a_t + mu * t) / sd_t;
+                        const double dm = dp - sd_t;
+                        double Nv, Dv;
+                        if (fp_b) {
+                            Nv = util::normal_pdf(dm) / sd_t;
+                            Dv = util::normal_pdf(dp) / sd_t + util::normal_cdf(dp);
+                        } else {
+                            Nv = util::normal_cdf(dm);
+                            Dv = util::normal_cdf(dp);
+                        }
+
+                        for (int k = 0; k < l; ++k) {
+                            const int idx = i * l + k;
+                            // ln(B(tau)/B(u)) without leaving log space
+                            const double log_ratio = B.neg_log_at(xi_u[idx]) - a_t;
+                            const double dpk = (log_ratio + drift[idx]) / sd[idx];
+                            const double dmk = dpk - sd[idx];
+                            if (fp_b) {
+                                Nv += wn_pdf[idx] * util::normal_pdf(dmk);
+                                Dv += wd_pdf[idx] * util::normal_pdf(dpk) + wd_cdf[idx] * util::normal_cdf(dpk);
+                            } else {
+                                Nv += wn_cdf[idx] * util::normal_cdf(dmk);
+                                Dv += wd_cdf[idx] * util::normal_cdf(dpk);
+                            }
+                        }
+
+                        const double B_new = std::min(B.X, pm.K * std::exp(-(pm.r - pm.q) * t) * Nv / Dv);
+                        const double lnB = std::log(B_new / B.X);
+                        H_next[i] = lnB * lnB;
+                        step = std::max(step, std::fabs(lnB + a_t));
+                    }
+                    H.swap(H_next);
+                    H[n] = 0.0;
+                    util::chebyshev_coefficients(H, B.coefs);
+
+                    // A growing update means FP-B has lost contraction; let the caller fall back
+                    if (fp_b && it >= 2 && step > last_step) return false;
+                    last_step = step;
+                }
+                return true;
+            };
+
+            // FP-B diverges for some long-dated, low-vol puts with r >> q; restart from QD with FP-A there
+            const std::vector<double> H_qd = H;
+            if (!iterate(H, true, p.iterations)) {
+                H = H_qd;
+                util::chebyshev_coefficients(H, B.coefs);
+                iterate(H, false, 2 * p.iterations);
+            }
+            return B;
+        }
+    } // namespace
+
+    void AndersenLakeOffengelt::check_inputs(const opt::Market& m, const opt::Option& o, const ALOParams& p) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (o.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (o.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (o.exercise != opt::Exercise::American) throw std::invalid_argument("Andersen-Lake-Offengelt only supports American Options.");
+        if (p.collocation_nodes < 2 || p.iterations < 0 || p.quadrature_nodes < 2 || p.pricing_nodes < 2) {
+            throw std::invalid_argument("Andersen-Lake-Offengelt node counts must be at least 2.");
+        }
+    }
+
+    double AndersenLakeOffengelt::price(const opt::Market& m, const opt::Option& o, const ALOParams& p) {
+        check_inputs(m, o, p);
+        if (o.type == opt::OptionType::Put) {
+            return put_price(m.S0, o.K, o.T, m.r, m.q, m.sigma, p);
+        }
+        // Put-call symmetry: C(S, K, r, q) = P(K, S, q, r)
+        return put_price(o.K, m.S0, o.T, m.q, m.r, m.sigma, p);
+    }
+
+    double AndersenLakeOffengelt::put_price(double S, double K, double T, double r, double q, double sigma,
+                                            const ALOParams& p) {
+        const PutModel pm{K, r, q, sigma};
+
+        // No early exercise premium for a put when r <= 0 (the double-boundary case r < q < 0 is not handled)
+        if (r <= 0.0) return pm.european_put(T, S);
+
+        const PutBoundary B = solve_put_boundary(pm, T, p);
+        if (S <= B(T)) return K - S;
+
+        std::vector<double> y, w;
+        util::gauss_legendre(p.pricing_nodes, y, w);
+
+        // Premium = int_0^T [r K e^{-r(T-u)} N(-d-(T-u, S/B(u))) - q S e^{-q(T-u)} N(-d+(T-u, S/B(u)))] du,
+        // integrated in u = T sin^2(theta) so the sqrt(u) kink of B(u) at u = 0 is smoothed out.
+        const double sqrtT = std::sqrt(T);
+        const double half_pi = 0.5 * util::PI;
+        double premium = 0.0;
+        for (int k = 0; k < p.pricing_nodes; ++k) {
+            const double theta = 0.5 * half_pi * (1.0 + y[k]);
+            const double st = std::sin(theta), ct = std::cos(theta);
+            const double s = sqrtT * ct; // sqrt(T - u)
+            if (s <= 0.0) continue;
+            const double dp = pm.d_plus(s * s, S / B.at_sqrt_tau(sqrtT * st));
+            const double dm = dp - sigma * s;
+            const double integrand = r * K * std::exp(-r * s * s) * util::normal_cdf(-dm)
+                                   - q * S * std::exp(-q * s * s) * util::normal_cdf(-dp);
+            premium += w[k] * 0.5 * half_pi * integrand * 2.0 * T * st * ct; // du = 2 T sin cos dtheta
+        }
+
+        return pm.european_put(T, S) + premium;
+    }
+
+    std::vector<double> AndersenLakeOffengelt::exercise_boundary(const opt::Market& m,
+                                                                 const opt::Option& o,
+                                                                 const std::vector<double>& taus,
+                                                                 const ALOParams& p) {
+        check_inputs(m, o, p);
+        const bool is_put = (o.type == opt::OptionType::Put);
+        // A call boundary is K^2 / (put boundary with r and q swapped)
+        const PutModel pm = is_put ? PutModel{o.K, m.r, m.q, m.sigma} : PutModel{o.K, m.q, m.r, m.sigma};
+
+        std::vector<double> out(taus.size(), is_put ? 0.0 : INFINITY);
+        if (pm.r <= 0.0) return out; // never exercised
+
+        const PutBoundary B = solve_put_boundary(pm, o.T, p);
+        for (std::size_t i = 0; i < taus.size(); ++i) {
+            const double tau = std::min(std::max(taus[i], 0.0), o.T);
+            const double b = B(tau);
+            out[i] = is_put ? b : o.K * o.K / b;
+        }
+        return out;
+    }
+
+} // namespace pricers
@@ -0,0 +1,171 @@
+// BinomialAAD.cpp: Adjoint Greeks for the CRR tree (backward induction + reverse sweep)
+#include "pricers/BinomialAAD.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace pricers {
+
+    static inline double vanilla_payoff(double S, const opt::Option& opt) {
+        return (opt.type == opt::OptionType::Call) ? std::max(0.0, S - opt.K) : std::max(0.0, opt.K - S);
+    }
+
+    // d payoff / dS (zero on the kink)
+    static inline double vanilla_payoff_dS(double S, const opt::Option& opt) {
+        if (opt.type == opt::OptionType::Call) return (S > opt.K) ? 1.0 : 0.0;
+        return (S < opt.K) ? -1.0 : 0.0;
+    }
+
+    BinomialAAD::Coefs BinomialAAD::make_coefs(const opt::Market& m,
+                                               const opt::Option& opt,
+                                               const TreeParams& p) {
+        Coefs c;
+        c.dt = opt.T / p.steps;
+        c.sqrt_dt = std::sqrt(c.dt);
+        c.u = std::exp(m.sigma * c.sqrt_dt);
+        c.d = 1.0 / c.u;
+        c.g = std::exp((m.r - m.q) * c.dt);
+        c.disc = std::exp(-m.r * c.dt);
+        c.pu = (c.g - c.d) / (c.u - c.d);
+
+        if (c.pu < -1e-12 || c.pu > 1.0 + 1e-12) throw std::invalid_argument("Risk-Neutral Probability out of bounds [0,1], please check inputs (increasing N usually helps).");
+        c.pu = std::min(1.0, std::max(0.0, c.pu));
+        c.pd = 1.0 - c.pu;
+        return c;
+    }
+
+    void BinomialAAD::roll_back(const Coefs& c, const double* S, int N, const opt::Option& opt, int step,
+                                const std::vector<double>& next, std::vector<double>& out) {
+        out.resize(step + 1);
+        if (opt.exercise == opt::Exercise::European) {
+            for (int i = 0; i <= step; ++i) {
+                out[i] = c.disc * (c.pu * next[i + 1] + c.pd * next[i]);
+            }
+            return;
+        }
+
+        for (int i = 0; i <= step; ++i) {
+            const double exercise_value = vanilla_payoff(S[2 * i - step + N], opt);
+            const double hold_value = c.disc * (c.pu * next[i + 1] + c.pd * next[i]);
+            out[i] = std::max(exercise_value, hold_value);
+        }
+    }
+
+    AdjointGreeks BinomialAAD::greeks(const opt::Market& m,
+                                      const opt::Option& opt,
+                                      const TreeParams& p,
+                                      const AADParams& ap) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (p.steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+        if (ap.checkpoint_every < 0) throw std::invalid_argument("Checkpoint spacing must be non-negative.");
+        if (p.truncation_stddevs != 0.0) throw std::invalid_argument("Tree adjoint does not support truncation.");
+
+        const Coefs c = make_coefs(m, opt, p);
+        const int N = p.steps;
+        const bool american = (opt.exercise == opt::Exercise::American);
+        std::vector<double> prices;
+        BinomialCRR::node_prices(m.S0, c.u, c.d, N, prices);
+        const double* S = prices.data();
+
+        int C = ap.checkpoint_every > 0 ? ap.checkpoint_every
+                                        : static_cast<int>(std::ceil(std::sqrt(static_cast<double>(N))));
+        C = std::min(C, N);
+
+        // ---- Pricing sweep ----
+        // Segment k covers steps [k*C, min((k+1)*C, N)]; the layer at its upper end is kept.
+        const int num_segments = (N + C - 1) / C;
+        std::vector<std::vector<double>> checkpoints(num_segments);
+
+        std::vector<double> layer(N + 1), tmp;
+        for (int i = 0; i <= N; ++i) layer[i] = vanilla_payoff(S[2 * i], opt);
+        checkpoints[num_segments - 1] = layer;
+
+        AdjointGreeks g;
+        for (int step = N - 1; step >= 0; --step) {
+            roll_back(c, S, N, opt, step, layer, tmp);
+            layer.swap(tmp);
+            if (step > 0 && step % C == 0) checkpoints[(step - 1) / C] = layer;
+
+            // Step-2 nodes S0 d^2, S0, S0 u^2: gamma from the two one-sided deltas, theta from
+            // the middle node (back at S0, 2 dt later)
+            if (step == 2) {
+                const double Sd = S[N - 2], Sm = S[N], Su = S[N + 2];
+                const double delta_up = (layer[2] - layer[1]) / (Su - Sm);
+                const double delta_dn = (layer[1] - layer[0]) / (Sm - Sd);
+                g.gamma = (delta_up - delta_dn) / (0.5 * (Su - Sd));
+                g.theta = layer[1];
+            }
+        }
+
+        g.price = layer[0];
+        if (N >= 2) g.theta = (g.theta - g.price) / (2.0 * c.dt);
+
+        // ---- Reverse sweep ----
+        double bar_S0 = 0.0;   // through node prices
+        double bar_a = 0.0;    // through node prices, a = sigma * sqrt(dt)
+        double bar_pu = 0.0;
+        double bar_disc = 0.0;
+
+        std::vector<double> bar(1, 1.0), bar_next;
+        std::vector<std::vector<double>> seg(C);
+
+        for (int k = 0; k < num_segments; ++k) {
+            const int lo = k * C;
+            const int hi = std::min(lo + C, N);
+
+            // Recompute layers lo+1..hi from the checkpoint at hi
+            seg[hi - lo - 1] = checkpoints[k];
+            for (int s = hi - 1; s > lo; --s) {
+                roll_back(c, S, N, opt, s, seg[s - lo], seg[s - lo - 1]);
+            }
+            checkpoints[k].clear();
+            checkpoints[k].shrink_to_fit();
+
+            for (int step = lo; step < hi; ++step) {
+                const std::vector<double>& next = seg[step - lo];
+                bar_next.assign(step + 2, 0.0);
+
+                for (int i = 0; i <= step; ++i) {
+                    const double Snode = S[2 * i - step + N];
+                    const double b = bar[i];
+                    const double cont = c.pu * next[i + 1] + c.pd * next[i];
+                    const double hold_value = c.disc * cont;
+
+                    if (american && vanilla_payoff(Snode, opt) > hold_value) {
+                        const double dpay = b * vanilla_payoff_dS(Snode, opt);
+                        bar_S0 += dpay * Snode / m.S0;
+                        bar_a += dpay * Snode * (2 * i - step);
+                    } else {
+                        bar_disc += b * cont;
+                        bar_pu += b * c.disc * (next[i + 1] - next[i]);
+                        bar_next[i + 1] += b * c.disc * c.pu;
+                        bar_next[i] += b * c.disc * c.pd;
+                    }
+                }
+                bar.swap(bar_next);
+            }
+        }
+
+        // Terminal payoffs
+        for (int i = 0; i <= N; ++i) {
+            const double dpay = bar[i] * vanilla_payoff_dS(S[2 * i], opt);
+            bar_S0 += dpay * S[2 * i] / m.S0;
+            bar_a += dpay * S[2 * i] * (2 * i - N);
+        }
+
+        // Chain through pu = (g - d) / (u - d), u = e^a, d = e^-a, g = e^{(r-q)dt}, disc = e^{-r dt}
+        const double ud = c.u - c.d;
+        const double dpu_da = (-(c.g - c.d) * c.u - (c.g - c.u) * c.d) / (ud * ud);
+        const double dpu_dg = 1.0 / ud;
+
+        g.delta = bar_S0;
+        g.vega = (bar_a + bar_pu * dpu_da) * c.sqrt_dt;
+        g.rho = bar_pu * dpu_dg * c.dt * c.g - bar_disc * c.dt * c.disc;
+        g.rho_q = -bar_pu * dpu_dg * c.dt * c.g;
+        return g;
+    }
+
+} // namespace pricers
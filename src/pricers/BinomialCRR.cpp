@@ -1,95 +1,435 @@
 // BinomialCRR.cpp: Binomial Cox-Ross-Rubinstein (CRR) option pricing model
 #include "pricers/BinomialCRR.hpp"
+#include "util/Parallel.hpp"
 #include <cmath> 
+#include <limits>
 #include <stdexcept>
+#include <thread>
 #include <vector> 
 #include <algorithm>
 
 namespace pricers {
+    namespace {
+        double checked_prob(double pu) {
+            if (pu < -1e-12 || pu > 1.0 + 1e-12) throw std::invalid_argument("Risk-Neutral Probability out of bounds [0,1], please check inputs (increasing N usually helps).");
+            return std::min(1.0, std::max(0.0, pu));
+        }
+
+        // Per-step rates for the inductions. Values are carried in maturity units
+        // (V_step / disc^(N-step)), so a step needs only its up-probability; growth(step) scales
+        // exercise values into those units and carry(step) gives the forward over t_step..T.
+
+        // Flat r and q: one up-probability for every step
+        struct FlatSteps {
+            double pu, r, q, dt, T;
+            int N;
+
+            FlatSteps(double r_, double q_, double dt_, double u, double d, double T_, int N_)
+                : pu(checked_prob((std::exp((r_ - q_) * dt_) - d) / (u - d))), r(r_), q(q_), dt(dt_), T(T_), N(N_) {}
+
+            double prob(int) const { return pu; }
+            double growth(int step) const { return std::exp(r * dt * (N - step)); }
+            double carry(int step) const { return std::exp((r - q) * (dt * (N - step))); }
+            double root_discount() const { return std::exp(-r * T); }
+        };
+
+        // Rate curves: arrays over the N + 1 step times from the curves' cumulative integrals.
+        // The step's own discount and drift are ratios of neighbouring entries, so building the
+        // schedule costs 2(N + 1) exps and no per-step curve integration.
+        struct CurveSteps {
+            std::vector<double> pu, growth_, carry_;
+            double df;
+
+            CurveSteps(const opt::Curve& r, const opt::Curve& q, double dt, double u, double d, double T, int N)
+                : pu(N), growth_(N + 1), carry_(N + 1) {
+                const double IrT = r.integral(T), IqT = q.integral(T);
+                for (int k = 0; k <= N; ++k) {
+                    const double t = (k == N) ? T : k * dt;
+                    const double Ir = r.integral(t), Iq = q.integral(t);
+                    growth_[k] = std::exp(IrT - Ir);
+                    carry_[k] = std::exp((IrT - IqT) - (Ir - Iq));
+                }
+                for (int k = 0; k < N; ++k) pu[k] = checked_prob((carry_[k] / carry_[k + 1] - d) / (u - d));
+                df = std::exp(-IrT);
+            }
+
+            double prob(int step) const { return pu[step]; }
+            double growth(int step) const { return growth_[step]; }
+            double carry(int step) const { return carry_[step]; }
+            double root_discount() const { return df; }
+        };
+    } // namespace
 
     double BinomialCRR::price_european(const opt::Market& m,
                                     const opt::Option& opt,
                                     const TreeParams& p) {
-        
-        // Check inputs 
+        return price_european_as<double>(m, opt, p);
+    }
+
+    double BinomialCRR::price_american(const opt::Market& m,
+                                    const opt::Option& opt,
+                                    const TreeParams& p) {
+        return price_american_as<double>(m, opt, p);
+    }
+
+    double BinomialCRR::price_european(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const TreeParams& p,
+                                       TreeWorkspace& ws) {
         check_inputs(m, opt, p);
-        
-        // Compute coefficients 
-        CRRCoefs coefs = make_coefs(m, opt, p);
+        if (opt.exercise != opt::Exercise::European) throw std::invalid_argument("Binomial European Pricer only supports European Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        return rollback_european<double>(m, opt, p, FlatSteps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps), ws.values);
+    }
+
+    double BinomialCRR::price_american(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const TreeParams& p,
+                                       TreeWorkspace& ws) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        return rollback_american<double>(m, opt, p, FlatSteps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps), ws.values);
+    }
 
+    template <typename Real>
+    Real BinomialCRR::price_european_as(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p) {
+        check_inputs(m, opt, p);
         if (opt.exercise != opt::Exercise::European) throw std::invalid_argument("Binomial European Pricer only supports European Options.");
-        if (coefs.pu < -1e-12 || coefs.pu > 1.0 + 1e-12) throw std::invalid_argument("Risk-Neutral Probability out of bounds [0,1], please check inputs (increasing N usually helps).");    
+        const CRRCoefs c = make_coefs(m, opt, p);
+        std::vector<Real> values;
+        return rollback_european<Real>(m, opt, p, FlatSteps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps), values);
+    }
 
-        // Clamp 
-        if (coefs.pu < 0.0) coefs.pu = 0.0;
-        if (coefs.pu > 1.0) coefs.pu = 1.0;
-        coefs.pd = 1.0 - coefs.pu;
+    template <typename Real>
+    Real BinomialCRR::price_american_as(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        std::vector<Real> values;
+        return rollback_american<Real>(m, opt, p, FlatSteps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps), values);
+    }
 
-        // Initialize values 
+    double BinomialCRR::price_european(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const TreeParams& p,
+                                       const opt::Curve& r,
+                                       const opt::Curve& q) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::European) throw std::invalid_argument("Binomial European Pricer only supports European Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        std::vector<double> values;
+        return rollback_european<double>(m, opt, p, CurveSteps(r, q, c.dt, c.u, c.d, opt.T, p.steps), values);
+    }
+
+    double BinomialCRR::price_american(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const TreeParams& p,
+                                       const opt::Curve& r,
+                                       const opt::Curve& q) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        std::vector<double> values;
+        return rollback_american<double>(m, opt, p, CurveSteps(r, q, c.dt, c.u, c.d, opt.T, p.steps), values);
+    }
+
+    double BinomialCRR::price_american(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const TreeParams& p,
+                                       ExerciseBoundary& boundary) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        boundary.t.resize(p.steps);
+        boundary.S.resize(p.steps);
+        for (int k = 0; k < p.steps; ++k) boundary.t[k] = k * c.dt;
+        std::vector<double> values;
+        return rollback_american_region<double>(m, opt, p, FlatSteps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps), values, boundary.S.data());
+    }
+
+    void BinomialCRR::price_american_layer(const opt::Market& m,
+                                           const opt::Option& opt,
+                                           const TreeParams& p,
+                                           int stop,
+                                           std::vector<double>& layer) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+        if (stop < 0 || stop > p.steps) throw std::invalid_argument("Layer step must lie between 0 and the number of steps.");
+        const CRRCoefs c = make_coefs(m, opt, p);
+        const FlatSteps steps(m.r, m.q, c.dt, c.u, c.d, opt.T, p.steps);
         const int N = p.steps;
-        std::vector<double> values(N + 1);
+        thread_local std::vector<double> prices;
+        node_prices(m.S0, c.u, c.d, N, prices);
+        const double* S = prices.data();
 
-        double S = m.S0 * std::pow(coefs.d, N); // Price at node (N,0)
-        const double u_over_d = coefs.u / coefs.d;
+        layer.resize(N + 1);
+        for (int i = 0; i <= N; ++i) layer[i] = payoff(S[2 * i], opt);
+        for (int step = N - 1; step >= stop; --step) {
+            const double pu = steps.prob(step);
+            induct_row<double, true>(layer.data(), 0, step + 1, step, N, pu, 1.0 - pu, steps.growth(step), S, opt);
+        }
 
-        for (int i = 0; i <= N; ++i) {
-            values[i] = payoff(S, opt);
-            S *= u_over_d;
+        // Maturity units back to money at the stop step's time
+        layer.resize(stop + 1);
+        const double df = std::exp(-m.r * (opt.T - stop * c.dt));
+        for (double& v : layer) v *= df;
+    }
+
+    // Each parity is one u/d chain from the bottom node of the last two rows, the same
+    // recurrence the terminal payoffs have always used.
+    void BinomialCRR::node_prices(double S0, double u, double d, int N, std::vector<double>& out) {
+        out.resize(2 * static_cast<std::size_t>(N) + 1);
+        const double u_over_d = u / d;
+        for (int first = 0; first <= 1 && first <= N; ++first) {
+            double x = S0 * std::pow(d, N - first);
+            for (std::size_t j = first; j < out.size(); j += 2) {
+                out[j] = x;
+                x *= u_over_d;
+            }
         }
+    }
 
-        // Solve via backward induction
+    template <typename Real, typename Steps>
+    Real BinomialCRR::rollback_european(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p,
+                                        const Steps& steps,
+                                        std::vector<Real>& values) {
+        const int N = p.steps;
+        const int J = band_halfwidth(p);
+        if (p.threads > 1 && J >= N) return rollback_wavefront<Real, false>(m, opt, p, steps, values);
+        const CRRCoefs coefs = make_coefs(m, opt, p);
+        thread_local std::vector<double> prices;
+        node_prices(m.S0, coefs.u, coefs.d, N, prices);
+        const double* S = prices.data();
+
+        // Initialize values 
+        if (values.size() < static_cast<std::size_t>(N) + 1) values.resize(N + 1);
+
+        int lo = 0, hi = N;
+        band(N, J, lo, hi);
+        for (int i = lo; i <= hi; ++i) values[i] = static_cast<Real>(payoff(S[2 * i], opt));
+
+        // Solve via backward induction. Discounting is factored out of the rollback (applied once
+        // at the root) so a rounded per-step discount does not compound over N steps; pd = 1 - pu
+        // is exact in Real.
         for (int step = p.steps - 1; step >= 0; --step) {
-            for (int i = 0; i <= step; ++i) {
-                values[i] = coefs.disc * (coefs.pu * values[i + 1] + coefs.pd * values[i]);
-            }
+            const int lo_next = lo, hi_next = hi;
+            band(step, J, lo, hi);
+            if (lo < lo_next) values[lo] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, lo, steps.carry(step + 1), steps.growth(step + 1)));
+            if (hi + 1 > hi_next) values[hi + 1] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, hi + 1, steps.carry(step + 1), steps.growth(step + 1)));
+
+            const Real pu = static_cast<Real>(steps.prob(step));
+            const Real pd = Real(1) - pu;
+            induct_row<Real, false>(values.data(), lo, hi + 1, step, N, pu, pd, 0.0, S, opt);
         }
         
-        return values[0];
+        return static_cast<Real>(static_cast<double>(values[0]) * steps.root_discount());
     }
 
-    double BinomialCRR::price_american(const opt::Market& m,
-                                    const opt::Option& opt,
-                                    const TreeParams& p) {
-        // Check inputs 
-        check_inputs(m, opt, p);
+    template <typename Real, typename Steps>
+    Real BinomialCRR::rollback_american(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p,
+                                        const Steps& steps,
+                                        std::vector<Real>& values) {
+        const int N = p.steps;
+        const int J = band_halfwidth(p);
+        if (p.exercise_region) return rollback_american_region<Real>(m, opt, p, steps, values, nullptr);
+        if (p.threads > 1 && J >= N) return rollback_wavefront<Real, true>(m, opt, p, steps, values);
+        const CRRCoefs coefs = make_coefs(m, opt, p);
+        thread_local std::vector<double> prices;
+        node_prices(m.S0, coefs.u, coefs.d, N, prices);
+        const double* S = prices.data();
 
-        // Compute coefficients
-        CRRCoefs coefs = make_coefs(m, opt, p);
+        // Initialize values 
+        if (values.size() < static_cast<std::size_t>(N) + 1) values.resize(N + 1);
 
-        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
-        if (coefs.pu < -1e-12 || coefs.pu > 1.0 + 1e-12) throw std::invalid_argument("Risk-Neutral Probability out of bounds [0,1], please check inputs (increasing N usually helps).");
+        int lo = 0, hi = N;
+        band(N, J, lo, hi);
+        for (int i = lo; i <= hi; ++i) values[i] = static_cast<Real>(payoff(S[2 * i], opt));
+
+        // Solve via backward induction with early exercise. Values are carried in maturity units
+        // (V_step / disc^(N-step)) so the rollback needs no per-step discount; exercise values are
+        // scaled into the same units in double.
+        for (int step = p.steps - 1; step >= 0; --step) {
+            const int lo_next = lo, hi_next = hi;
+            band(step, J, lo, hi);
+            if (lo < lo_next) values[lo] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, lo, steps.carry(step + 1), steps.growth(step + 1)));
+            if (hi + 1 > hi_next) values[hi + 1] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, hi + 1, steps.carry(step + 1), steps.growth(step + 1)));
 
-        // Clamp
-        if (coefs.pu < 0.0) coefs.pu = 0.0;
-        if (coefs.pu > 1.0) coefs.pu = 1.0;
-        coefs.pd = 1.0 - coefs.pu;
+            const Real pu = static_cast<Real>(steps.prob(step));
+            const Real pd = Real(1) - pu;
+            const double growth = steps.growth(step); // 1 / disc^(N-step)
+            induct_row<Real, true>(values.data(), lo, hi + 1, step, N, pu, pd, growth, S, opt);
+        }
 
-        // Initialize values 
+        return static_cast<Real>(static_cast<double>(values[0]) * steps.root_discount());
+    }
+
+    template <typename Real, typename Steps>
+    Real BinomialCRR::rollback_american_region(const opt::Market& m,
+                                               const opt::Option& opt,
+                                               const TreeParams& p,
+                                               const Steps& steps,
+                                               std::vector<Real>& values,
+                                               double* boundary) {
         const int N = p.steps;
-        std::vector<double> values(N + 1);
+        const int J = band_halfwidth(p);
+        const CRRCoefs coefs = make_coefs(m, opt, p);
+        thread_local std::vector<double> prices;
+        node_prices(m.S0, coefs.u, coefs.d, N, prices);
+        const double* S = prices.data();
+        if (values.size() < static_cast<std::size_t>(N) + 1) values.resize(N + 1);
 
-        double S = m.S0 * std::pow(coefs.d, N); // Price at node (N, 0)
-        const double u_over_d = coefs.u / coefs.d;
+        int lo = 0, hi = N;
+        band(N, J, lo, hi);
+        for (int i = lo; i <= hi; ++i) values[i] = static_cast<Real>(payoff(S[2 * i], opt));
 
+        // A put is exercised on a run of nodes [lo, b] at the bottom of the row, a call on
+        // [b, hi] at the top. The terminal in-the-money run seeds the walk for step N - 1.
+        const bool put = (opt.type == opt::OptionType::Put);
+        int b = put ? -1 : N + 1;
         for (int i = 0; i <= N; ++i) {
-            values[i] = payoff(S, opt);
-            S *= u_over_d;
+            if (put && S[2 * i] < opt.K) b = i;
+            if (!put && S[2 * i] > opt.K && b > N) b = i;
         }
 
-        // Solve via backward induction with early exercise
         for (int step = p.steps - 1; step >= 0; --step) {
-            double Snode = m.S0 * std::pow(coefs.d, step); // Price at node (step, 0)
-            for (int i = 0; i <= step; ++i) {
-                double exercise_value = payoff(Snode, opt);
-                double hold_value = coefs.disc * (coefs.pu * values[i + 1] + coefs.pd * values[i]);
+            const int lo_next = lo, hi_next = hi;
+            band(step, J, lo, hi);
+            if (lo < lo_next) values[lo] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, lo, steps.carry(step + 1), steps.growth(step + 1)));
+            if (hi + 1 > hi_next) values[hi + 1] = static_cast<Real>(far_node_value(m, opt, coefs, step + 1, hi + 1, steps.carry(step + 1), steps.growth(step + 1)));
+
+            // Continuation value everywhere: no payoff, no branch
+            const Real pu = static_cast<Real>(steps.prob(step));
+            const Real pd = Real(1) - pu;
+            induct_row<Real, false>(values.data(), lo, hi + 1, step, N, pu, pd, 0.0, S, opt);
+
+            // Move the boundary from its previous index, comparing exercise with hold (the
+            // max() test) only on the nodes it passes; the node price moves by half a lattice
+            // spacing per step, so this is one or two nodes on most steps
+            const double growth = steps.growth(step); // 1 / disc^(N-step)
+            // Out-of-the-money nodes (payoff 0 <= hold) count as held, which keeps the run contiguous
+            auto exercise = [&](int i) { return static_cast<Real>(payoff(S[2 * i - step + N], opt) * growth); };
+            auto exercised = [&](int i) {
+                const Real ex = exercise(i);
+                return ex > Real(0) && ex >= values[i];
+            };
+            int first, last; // exercise run
+            if (put) {
+                b = std::clamp(b, lo - 1, hi);
+                while (b >= lo && !exercised(b)) --b;
+                while (b < hi && exercised(b + 1)) ++b;
+                first = lo;
+                last = b;
+            } else {
+                b = std::clamp(b, lo, hi + 1);
+                while (b <= hi && !exercised(b)) ++b;
+                while (b > lo && exercised(b - 1)) --b;
+                first = b;
+                last = hi;
+            }
+            for (int i = first; i <= last; ++i) values[i] = exercise(i);
+
+            if (boundary != nullptr) {
+                boundary[step] = (first <= last) ? S[2 * (put ? last : first) - step + N]
+                                                 : std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        return static_cast<Real>(static_cast<double>(values[0]) * steps.root_discount());
+    }
+
+    template <typename Real, bool American>
+    void BinomialCRR::induct_row(Real* values, int lo, int hi, int step, int N,
+                                 Real pu, Real pd, double growth,
+                                 const double* S, const opt::Option& opt) {
+        for (int i = lo; i < hi; ++i) {
+            const Real hold_value = pu * values[i + 1] + pd * values[i];
+            if constexpr (American) {
+                const Real exercise_value = static_cast<Real>(payoff(S[2 * i - step + N], opt) * growth);
                 values[i] = std::max(exercise_value, hold_value);
-                Snode *= u_over_d;
+            } else {
+                values[i] = hold_value;
             }
         }
+    }
+
+    template <typename Real, bool American, typename Steps>
+    Real BinomialCRR::rollback_wavefront(const opt::Market& m,
+                                         const opt::Option& opt,
+                                         const TreeParams& p,
+                                         const Steps& steps,
+                                         std::vector<Real>& values) {
+        const CRRCoefs coefs = make_coefs(m, opt, p);
+        const int N = p.steps;
+        thread_local std::vector<double> prices;
+        node_prices(m.S0, coefs.u, coefs.d, N, prices);
+        const double* S = prices.data();
+        if (values.size() < static_cast<std::size_t>(N) + 1) values.resize(N + 1);
+        Real* v = values.data();
+        for (int i = 0; i <= N; ++i) v[i] = static_cast<Real>(payoff(S[2 * i], opt));
+
+        // Tiles are W columns by W steps: a tile's values and node prices (~24 W bytes) stay in
+        // L1/L2 for all W steps. W shrinks with the thread count so a wavefront has enough tiles.
+        // More workers than cores only spin at the barrier, and more than columns have no tile
+        // on any diagonal.
+        unsigned threads = std::min(p.threads, util::hardware_threads());
+        const int W = std::clamp(N / (4 * static_cast<int>(threads)), 256, 4096);
+        const int n_cols = N / W + 1;        // columns c in [0, N]
+        const int n_bands = (N + W - 1) / W; // steps N-1 down to 0
+        threads = std::min(threads, static_cast<unsigned>(n_cols));
 
-        return values[0];
+        // Tile (b, k): steps [s_top - W + 1, s_top] with s_top = N - 1 - b W, columns
+        // [k W, (k + 1) W). At step s the live columns are [N - s, N], so a column dies from the
+        // left as s falls. Concurrent tiles on one anti-diagonal touch index ranges at least two
+        // apart, and each reads only values its left and upper neighbours have finished.
+        auto tile = [&](int b, int k) {
+            const int s_top = N - 1 - b * W;
+            const int s_bot = std::max(0, s_top - W + 1);
+            const int c0 = k * W;
+            const int c1 = std::min(N + 1, c0 + W);
+            for (int s = s_top; s >= s_bot; --s) {
+                const int lo_c = std::max(c0, N - s);
+                if (lo_c >= c1) return;
+                const Real pu = static_cast<Real>(steps.prob(s));
+                const Real pd = Real(1) - pu;
+                const double growth = American ? steps.growth(s) : 0.0;
+                induct_row<Real, American>(v, lo_c - (N - s), c1 - (N - s), s, N, pu, pd, growth, S, opt);
+            }
+        };
+
+        util::SpinBarrier barrier(threads);
+        auto worker = [&](unsigned w) {
+            for (int diag = 0; diag < n_bands + n_cols - 1; ++diag) {
+                const int b_lo = std::max(0, diag - n_cols + 1);
+                const int b_hi = std::min(n_bands - 1, diag);
+                for (int b = b_lo + static_cast<int>(w); b <= b_hi; b += static_cast<int>(threads)) tile(b, diag - b);
+                barrier.arrive_and_wait();
+            }
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : pool) t.join();
+
+        return static_cast<Real>(static_cast<double>(v[0]) * steps.root_discount());
     }
 
+    template void BinomialCRR::induct_row<double, false>(double*, int, int, int, int, double, double, double, const double*, const opt::Option&);
+    template void BinomialCRR::induct_row<double, true>(double*, int, int, int, int, double, double, double, const double*, const opt::Option&);
+    template float BinomialCRR::price_european_as<float>(const opt::Market&, const opt::Option&, const TreeParams&);
+    template double BinomialCRR::price_european_as<double>(const opt::Market&, const opt::Option&, const TreeParams&);
+    template float BinomialCRR::price_american_as<float>(const opt::Market&, const opt::Option&, const TreeParams&);
+    template double BinomialCRR::price_american_as<double>(const opt::Market&, const opt::Option&, const TreeParams&);
+
     void BinomialCRR::check_inputs(const opt::Market& m,
                                 const opt::Option& opt,
                                 const TreeParams& p) {
@@ -98,6 +438,42 @@ namespace pricers {
         if (opt.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
         if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
         if (p.steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+        if (p.truncation_stddevs < 0.0) throw std::invalid_argument("Truncation width must be non-negative.");
+    }
+
+    int BinomialCRR::band_halfwidth(const TreeParams& p) {
+        if (p.truncation_stddevs <= 0.0) return p.steps;
+        // One node step is sigma*sqrt(dt) in log-price and j = 2i - step moves by 2 per up-move,
+        // so k standard deviations over T = N steps is j = k*sqrt(N)
+        const double J = std::ceil(p.truncation_stddevs * std::sqrt(static_cast<double>(p.steps)));
+        return (J >= p.steps) ? p.steps : static_cast<int>(J);
+    }
+
+    void BinomialCRR::band(int step, int J, int& lo, int& hi) {
+        // |2i - step| <= J  <=>  (step - J)/2 <= i <= (step + J)/2
+        const int a = step - J;
+        const int b = step + J;
+        lo = std::max(0, (a >= 0) ? (a + 1) / 2 : -((-a) / 2));
+        hi = std::min(step, b / 2);
+    }
+
+    double BinomialCRR::far_node_value(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const CRRCoefs& c,
+                                       int step, int i,
+                                       double carry, double growth) {
+        const double S = m.S0 * std::pow(c.u, 2 * i - step);
+        // Forward value of the contract in maturity units: (S e^{-q tau} - K e^{-r tau}) e^{r tau}
+        const double fwd = S * carry - opt.K;
+        const double forward_value = (opt.type == opt::OptionType::Call) ? fwd : -fwd;
+
+        // k standard deviations out, the time value is negligible: the node is worth 0 when
+        // out of the money and its forward (or, if American, intrinsic) value when in the money
+        const double value = std::max(0.0, forward_value);
+        if (opt.exercise == opt::Exercise::American) {
+            return std::max(value, payoff(S, opt) * growth);
+        }
+        return value;
     }
 
     BinomialCRR::CRRCoefs BinomialCRR::make_coefs(const opt::Market& m,
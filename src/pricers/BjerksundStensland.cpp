@@ -0,0 +1,107 @@
+// BjerksundStensland.cpp: Bjerksund-Stensland (2002) closed-form American approximation
+#include "pricers/BjerksundStensland.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace pricers {
+
+    void BjerksundStensland::check_inputs(const opt::Market& m, const opt::Option& o) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (o.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (o.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (o.exercise != opt::Exercise::American) throw std::invalid_argument("Bjerksund-Stensland only supports American Options.");
+    }
+
+    double BjerksundStensland::price(const opt::Market& m, const opt::Option& o) {
+        check_inputs(m, o);
+        const double b = m.r - m.q;
+        if (o.type == opt::OptionType::Call) {
+            return call_price(m.S0, o.K, o.T, m.r, b, m.sigma);
+        }
+        // Put-call transformation: P(S, K, T, r, b) = C(K, S, T, r - b, -b)
+        return call_price(o.K, m.S0, o.T, m.r - b, -b, m.sigma);
+    }
+
+    double BjerksundStensland::phi(double S, double T, double gamma, double H, double I,
+                                   double r, double b, double sigma) {
+        const double v2 = sigma * sigma;
+        const double volSqrtT = sigma * std::sqrt(T);
+        const double lambda = (-r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2) * T;
+        const double d = -(std::log(S / H) + (b + (gamma - 0.5) * v2) * T) / volSqrtT;
+        const double kappa = 2.0 * b / v2 + 2.0 * gamma - 1.0;
+        return std::exp(lambda) * std::pow(S, gamma)
+             * (util::normal_cdf(d) - std::pow(I / S, kappa) * util::normal_cdf(d - 2.0 * std::log(I / S) / volSqrtT));
+    }
+
+    double BjerksundStensland::psi(double S, double T2, double gamma, double H, double I2, double I1,
+                                   double t1, double r, double b, double sigma) {
+        const double v2 = sigma * sigma;
+        const double drift = b + (gamma - 0.5) * v2;
+        const double vt1 = sigma * std::sqrt(t1);
+        const double vt2 = sigma * std::sqrt(T2);
+
+        const double e1 = (std::log(S / I1) + drift * t1) / vt1;
+        const double e2 = (std::log(I2 * I2 / (S * I1)) + drift * t1) / vt1;
+        const double e3 = (std::log(S / I1) - drift * t1) / vt1;
+        const double e4 = (std::log(I2 * I2 / (S * I1)) - drift * t1) / vt1;
+
+        const double f1 = (std::log(S / H) + drift * T2) / vt2;
+        const double f2 = (std::log(I2 * I2 / (S * H)) + drift * T2) / vt2;
+        const double f3 = (std::log(I1 * I1 / (S * H)) + drift * T2) / vt2;
+        const double f4 = (std::log(S * I1 * I1 / (H * I2 * I2)) + drift * T2) / vt2;
+
+        const double rho = std::sqrt(t1 / T2);
+        const double lambda = -r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2;
+        const double kappa = 2.0 * b / v2 + (2.0 * gamma - 1.0);
+
+        return std::exp(lambda * T2) * std::pow(S, gamma)
+             * (util::bivariate_normal_cdf(-e1, -f1, rho)
+                - std::pow(I2 / S, kappa) * util::bivariate_normal_cdf(-e2, -f2, rho)
+                - std::pow(I1 / S, kappa) * util::bivariate_normal_cdf(-e3, -f3, -rho)
+                + std::pow(I1 / I2, kappa) * util::bivariate_normal_cdf(-e4, -f4, -rho));
+    }
+
+    double BjerksundStensland::call_price(double S, double K, double T, double r, double b, double sigma) {
+        // Never optimal to exercise early: European value
+        if (b >= r) {
+            const opt::Market m{S, r, r - b, sigma};
+            const opt::Option o{K, T, opt::OptionType::Call, opt::Exercise::European};
+            return AnalyticBS::price(m, o);
+        }
+
+        const double v2 = sigma * sigma;
+        const double beta = (0.5 - b / v2) + std::sqrt((b / v2 - 0.5) * (b / v2 - 0.5) + 2.0 * r / v2);
+        const double B_inf = beta / (beta - 1.0) * K;
+        const double B0 = std::max(K, r / (r - b) * K);
+
+        const double t1 = 0.5 * (std::sqrt(5.0) - 1.0) * T;
+        const double h1 = -(b * t1 + 2.0 * sigma * std::sqrt(t1)) * K * K / ((B_inf - B0) * B0);
+        const double h2 = -(b * T + 2.0 * sigma * std::sqrt(T)) * K * K / ((B_inf - B0) * B0);
+
+        const double I1 = B0 + (B_inf - B0) * (1.0 - std::exp(h1));
+        const double I2 = B0 + (B_inf - B0) * (1.0 - std::exp(h2));
+        const double alpha1 = (I1 - K) * std::pow(I1, -beta);
+        const double alpha2 = (I2 - K) * std::pow(I2, -beta);
+
+        if (S >= I2) return S - K;
+
+        return alpha2 * std::pow(S, beta)
+             - alpha2 * phi(S, t1, beta, I2, I2, r, b, sigma)
+             + phi(S, t1, 1.0, I2, I2, r, b, sigma)
+             - phi(S, t1, 1.0, I1, I2, r, b, sigma)
+             - K * phi(S, t1, 0.0, I2, I2, r, b, sigma)
+             + K * phi(S, t1, 0.0, I1, I2, r, b, sigma)
+             + alpha1 * phi(S, t1, beta, I1, I2, r, b, sigma)
+             - alpha1 * psi(S, T, beta, I1, I2, I1, t1, r, b, sigma)
+             + psi(S, T, 1.0, I1, I2, I1, t1, r, b, sigma)
+             - psi(S, T, 1.0, K, I2, I1, t1, r, b, sigma)
+             - K * psi(S, T, 0.0, I1, I2, I1, t1, r, b, sigma)
+             + K * psi(S, T, 0.0, K, I2, I1, t1, r, b, sigma);
+    }
+
+} // namespace pricers
@@ -0,0 +1,467 @@
+// ChebyshevSurrogate.cpp: Tensor Chebyshev interpolant of an expensive pricer, stored in mmap-able tables
+#include "pricers/ChebyshevSurrogate.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "util/Parallel.hpp"
+#include "util/Quadrature.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pricers {
+
+    namespace {
+        constexpr int MAX_DEGREE = 64;
+        constexpr std::uint32_t FILE_VERSION = 1;
+        constexpr char FILE_MAGIC[8] = {'O', 'P', 'T', 'C', 'H', 'E', 'B', 'S'};
+
+        // On-disk header; a multiple of 8 bytes so the coefficients that follow stay aligned
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t type;        // opt::OptionType
+            std::uint32_t exercise;    // opt::Exercise
+            std::uint32_t axes;
+            std::uint32_t european_control;
+            std::uint32_t front_fixed;
+            double lo[5];
+            double hi[5];
+            std::uint32_t degree[5];
+            std::uint32_t pieces[5];
+            double front_hi;
+            double validation_error;
+            double tail_estimate;
+            std::uint64_t n_coefs;
+        };
+        static_assert(sizeof(FileHeader) % sizeof(double) == 0, "FileHeader must keep coefficients aligned.");
+
+        // Axis order: moneyness, sigma, T, r, q
+        SurrogateAxis& axis(SurrogateDomain& d, int a) {
+            switch (a) {
+                case 0: return d.moneyness;
+                case 1: return d.sigma;
+                case 2: return d.T;
+                case 3: return d.r;
+                default: return d.q;
+            }
+        }
+
+        const SurrogateAxis& axis(const SurrogateDomain& d, int a) {
+            return axis(const_cast<SurrogateDomain&>(d), a);
+        }
+
+        // Interpolation coordinate of a natural-unit value (ln for moneyness, sqrt for T) and back
+        double to_coordinate(int a, double v) {
+            if (a == 0) return std::log(v);
+            if (a == 2) return std::sqrt(v);
+            return v;
+        }
+
+        double from_coordinate(int a, double c) {
+            if (a == 0) return std::exp(c);
+            if (a == 2) return c * c;
+            return c;
+        }
+
+        // Unit-strike contract at natural-unit values v
+        void unit_contract(opt::OptionType type, opt::Exercise exercise, const double v[5],
+                           opt::Market& m, opt::Option& o) {
+            m.S0 = v[0];
+            m.sigma = v[1];
+            m.r = v[3];
+            m.q = v[4];
+            o.K = 1.0;
+            o.T = v[2];
+            o.type = type;
+            o.exercise = exercise;
+        }
+
+        double unit_price(const PricerFn& pricer, opt::OptionType type, opt::Exercise exercise,
+                          const double v[5]) {
+            opt::Market m;
+            opt::Option o;
+            unit_contract(type, exercise, v, m, o);
+            return pricer(m, o);
+        }
+
+        // Black-Scholes European price of the same contract at unit strike
+        double unit_control(opt::OptionType type, const double v[5]) {
+            opt::Market m;
+            opt::Option o;
+            unit_contract(type, opt::Exercise::European, v, m, o);
+            return AnalyticBS::price(m, o);
+        }
+    } // namespace
+
+    void ChebyshevSurrogate::check_domain(const SurrogateDomain& d) {
+        for (int a = 0; a < AXES; ++a) {
+            const SurrogateAxis& ax = axis(d, a);
+            if (ax.degree < 0 || ax.degree > MAX_DEGREE) throw std::invalid_argument("Surrogate degree must be between 0 and 64.");
+            if (ax.degree == 0 && ax.lo != ax.hi) throw std::invalid_argument("Pinned surrogate axis (degree 0) must have lo == hi.");
+            if (ax.degree > 0 && !(ax.lo < ax.hi)) throw std::invalid_argument("Surrogate axis must have lo < hi.");
+            if (ax.pieces < 1) throw std::invalid_argument("Surrogate axis must have at least one piece.");
+            if (ax.degree == 0 && ax.pieces != 1) throw std::invalid_argument("Pinned surrogate axis (degree 0) must have one piece.");
+        }
+        if (d.moneyness.degree == 0) throw std::invalid_argument("Surrogate moneyness axis cannot be pinned.");
+        if (d.moneyness.lo <= 0.0) throw std::invalid_argument("Surrogate moneyness must be positive.");
+        if (d.sigma.lo <= 0.0) throw std::invalid_argument("Surrogate volatility must be positive.");
+        if (d.T.lo <= 0.0) throw std::invalid_argument("Surrogate maturity must be positive.");
+    }
+
+    void ChebyshevSurrogate::set_layout(double lo0, double hi0) {
+        auto fill = [&](Layout& L, bool pin_moneyness) {
+            L.tile_size = 1;
+            L.n_tiles = 1;
+            for (int a = 0; a < AXES; ++a) {
+                const SurrogateAxis& ax = axis(domain_, a);
+                const bool pinned = ax.degree == 0 || (a == 0 && pin_moneyness);
+                L.lo[a] = a == 0 ? lo0 : to_coordinate(a, ax.lo);
+                const double hi = a == 0 ? hi0 : to_coordinate(a, ax.hi);
+                L.size[a] = pinned ? 1 : ax.degree + 1;
+                L.pieces[a] = pinned ? 1 : ax.pieces;
+                L.width[a] = pinned ? 0.0 : (hi - L.lo[a]) / ax.pieces;
+                L.tile_size *= static_cast<std::size_t>(L.size[a]);
+                L.n_tiles *= static_cast<std::size_t>(L.pieces[a]);
+            }
+        };
+        fill(price_, false);
+        if (front_fixed_) fill(boundary_, true);
+        else boundary_ = Layout{};
+    }
+
+    // Locates the tile, then contracts its tensor one axis at a time, slowest (moneyness) first:
+    // the remaining tensor is a weighted sum of len contiguous slabs. Pinned axes cost nothing.
+    double ChebyshevSurrogate::eval_table(const Layout& L, const double* coefs, const double c[AXES]) {
+        double t[AXES][MAX_DEGREE + 1];
+        std::size_t tile = 0;
+        for (int a = 0; a < AXES; ++a) {
+            const int len = L.size[a];
+            if (len == 1) continue;
+            const double u = (c[a] - L.lo[a]) / L.width[a];
+            const int p = std::min(std::max(static_cast<int>(std::floor(u)), 0), L.pieces[a] - 1);
+            tile = tile * static_cast<std::size_t>(L.pieces[a]) + static_cast<std::size_t>(p);
+            const double z = 2.0 * (u - p) - 1.0;
+            t[a][0] = 1.0;
+            t[a][1] = z;
+            for (int k = 2; k < len; ++k) t[a][k] = 2.0 * z * t[a][k - 1] - t[a][k - 2];
+        }
+
+        // Partial sums live on the stack for typical tiles; larger ones use a per-thread buffer
+        constexpr std::size_t STACK_SCRATCH = 512;
+        double local[STACK_SCRATCH];
+        double* dst = local;
+        const double* src = coefs + tile * L.tile_size;
+        std::size_t n = L.tile_size;
+        bool first = true;
+        for (int a = 0; a < AXES; ++a) {
+            const int len = L.size[a];
+            if (len == 1) continue;
+            const std::size_t m = n / static_cast<std::size_t>(len);
+            if (first && m > STACK_SCRATCH) {
+                thread_local std::vector<double> scratch;
+                if (scratch.size() < m) scratch.resize(m);
+                dst = scratch.data();
+            }
+            // In place after the first pass: slab 0 is scaled where it lies, later slabs sit past m
+            if (first) {
+                for (std::size_t j = 0; j < m; ++j) dst[j] = src[j];
+                first = false;
+            }
+            for (int k = 1; k < len; ++k) {
+                const double* slab = src + k * m;
+                const double tk = t[a][k];
+                for (std::size_t j = 0; j < m; ++j) dst[j] += tk * slab[j];
+            }
+            src = dst;
+            n = m;
+        }
+        return src[0];
+    }
+
+    double ChebyshevSurrogate::to_coefficients(const Layout& L, double* values, unsigned threads) {
+        std::vector<double> tail(L.n_tiles * AXES, 0.0);
+        util::parallel_for(L.n_tiles, [&](std::size_t tile) {
+            double* t = values + tile * L.tile_size;
+            std::vector<double> f, a_k;
+            std::size_t stride = L.tile_size;
+            for (int a = 0; a < AXES; ++a) {
+                const std::size_t len = static_cast<std::size_t>(L.size[a]);
+                stride /= len;
+                if (len == 1) continue;
+                const std::size_t outer = L.tile_size / (len * stride);
+                f.resize(len);
+                for (std::size_t o = 0; o < outer; ++o) {
+                    for (std::size_t in = 0; in < stride; ++in) {
+                        double* fibre = t + o * len * stride + in;
+                        for (std::size_t k = 0; k < len; ++k) f[k] = fibre[k * stride];
+                        util::chebyshev_coefficients(f, a_k);
+                        // Fold the sum'' end halving into the coefficients: evaluation is a plain sum
+                        a_k.front() *= 0.5;
+                        a_k.back() *= 0.5;
+                        for (std::size_t k = 0; k < len; ++k) fibre[k * stride] = a_k[k];
+                    }
+                }
+            }
+
+            // Largest highest-order coefficient along each interpolated axis
+            for (std::size_t idx = 0; idx < L.tile_size; ++idx) {
+                std::size_t rest = idx;
+                for (int a = AXES - 1; a >= 0; --a) {
+                    const int k = static_cast<int>(rest % L.size[a]);
+                    rest /= L.size[a];
+                    double& tmax = tail[tile * AXES + a];
+                    if (L.size[a] > 1 && k == L.size[a] - 1) tmax = std::max(tmax, std::fabs(t[idx]));
+                }
+            }
+        }, threads);
+
+        double estimate = 0.0;
+        for (int a = 0; a < AXES; ++a) {
+            double tmax = 0.0;
+            for (std::size_t tile = 0; tile < L.n_tiles; ++tile) tmax = std::max(tmax, tail[tile * AXES + a]);
+            estimate += tmax;
+        }
+        return estimate;
+    }
+
+    ChebyshevSurrogate ChebyshevSurrogate::build(const PricerFn& pricer,
+                                                 opt::OptionType type,
+                                                 opt::Exercise exercise,
+                                                 const SurrogateDomain& domain,
+                                                 const SurrogateBuildParams& params) {
+        if (!pricer) throw std::invalid_argument("Surrogate needs a pricer to sample.");
+        if (params.validation_points < 0) throw std::invalid_argument("Validation points must be non-negative.");
+        if (params.exercise_boundary && exercise != opt::Exercise::American) {
+            throw std::invalid_argument("An exercise boundary only applies to American surrogates.");
+        }
+        check_domain(domain);
+        // Puts are only exercised early with r > 0 and calls with q > 0; without that the table
+        // would hold European prices under an American label
+        const SurrogateAxis& carry = type == opt::OptionType::Put ? domain.r : domain.q;
+        if (exercise == opt::Exercise::American && !(carry.hi > 0.0)) {
+            throw std::invalid_argument("American surrogate needs a positive rate (r for puts, q for calls) on the domain.");
+        }
+
+        ChebyshevSurrogate s;
+        s.type_ = type;
+        s.exercise_ = exercise;
+        s.domain_ = domain;
+        s.european_control_ = params.european_control;
+        s.front_fixed_ = static_cast<bool>(params.exercise_boundary);
+        const bool is_put = (type == opt::OptionType::Put);
+        const double ln_lo = std::log(domain.moneyness.lo);
+        const double ln_hi = std::log(domain.moneyness.hi);
+        s.set_layout(ln_lo, ln_hi);
+
+        // Chebyshev extrema on [-1, 1] per degree (z_i = cos(i pi / n), so node 0 is the top)
+        std::vector<double> z[MAX_DEGREE + 1];
+        for (int a = 0; a < AXES; ++a) {
+            const int n = axis(domain, a).degree;
+            if (z[n].empty()) for (int i = 0; i <= n; ++i) z[n].push_back(n == 0 ? 0.0 : util::chebyshev_node(i, n));
+        }
+        // Coordinates of flat sample index idx of layout L
+        auto node = [&](const Layout& L, std::size_t idx, double c[AXES]) {
+            std::size_t local = idx % L.tile_size;
+            std::size_t tile = idx / L.tile_size;
+            for (int a = AXES - 1; a >= 0; --a) {
+                const int i = static_cast<int>(local % L.size[a]);
+                const int p = static_cast<int>(tile % L.pieces[a]);
+                local /= L.size[a];
+                tile /= L.pieces[a];
+                c[a] = L.size[a] == 1 ? L.lo[a] : L.lo[a] + L.width[a] * (p + 0.5 * (1.0 + z[L.size[a] - 1][i]));
+            }
+        };
+
+        // Exercise boundary first: the price table's moneyness range is measured from it
+        const std::size_t n_price = s.price_.count();
+        auto data = std::make_shared<std::vector<double>>(n_price + s.boundary_.count());
+        double* pcoefs = data->data();
+        double* bcoefs = data->data() + n_price;
+        if (s.front_fixed_) {
+            const std::size_t n_boundary = s.boundary_.count();
+            util::parallel_for(n_boundary, [&](std::size_t idx) {
+                double c[AXES];
+                node(s.boundary_, idx, c);
+                double v[AXES] = {1.0};
+                for (int a = 1; a < AXES; ++a) v[a] = from_coordinate(a, c[a]);
+                const double b = unit_price(params.exercise_boundary, type, exercise, v);
+                if (!(b > 0.0) || !std::isfinite(b)) {
+                    throw std::invalid_argument("Exercise boundary must be positive and finite over the domain.");
+                }
+                bcoefs[idx] = std::log(b);
+            }, params.threads);
+            const auto range = std::minmax_element(bcoefs, bcoefs + n_boundary);
+            s.front_hi_ = is_put ? ln_hi - *range.first : *range.second - ln_lo;
+            if (!(s.front_hi_ > 0.0)) throw std::invalid_argument("Surrogate domain lies entirely in the exercise region.");
+            to_coefficients(s.boundary_, bcoefs, params.threads);
+            s.set_layout(0.0, s.front_hi_);
+        }
+
+        // Sample the pricer at every tile's nodes (shared tile faces are sampled once per tile)
+        util::parallel_for(n_price, [&](std::size_t idx) {
+            double c[AXES];
+            node(s.price_, idx, c);
+            double v[AXES];
+            for (int a = 1; a < AXES; ++a) v[a] = from_coordinate(a, c[a]);
+            if (s.front_fixed_) {
+                const double lnB = eval_table(s.boundary_, bcoefs, c);
+                v[0] = std::exp(is_put ? lnB + c[0] : lnB - c[0]);
+            } else {
+                v[0] = from_coordinate(0, c[0]);
+            }
+            pcoefs[idx] = unit_price(pricer, type, exercise, v);
+            if (s.european_control_) pcoefs[idx] -= unit_control(type, v);
+        }, params.threads);
+        s.tail_estimate_ = to_coefficients(s.price_, pcoefs, params.threads);
+        s.coefs_ = std::shared_ptr<const double>(data, data->data());
+
+        // Validation against the source pricer at random points (drawn serially for determinism)
+        const std::size_t n_val = static_cast<std::size_t>(params.validation_points);
+        std::vector<double> points(n_val * AXES);
+        std::mt19937_64 rng(params.seed);
+        std::uniform_real_distribution<double> unif(0.0, 1.0);
+        for (std::size_t i = 0; i < n_val; ++i) {
+            for (int a = 0; a < AXES; ++a) {
+                const SurrogateAxis& ax = axis(domain, a);
+                points[i * AXES + a] = ax.lo + (ax.hi - ax.lo) * unif(rng);
+            }
+        }
+        std::vector<double> errors(n_val, 0.0);
+        util::parallel_for(n_val, [&](std::size_t i) {
+            const double* v = &points[i * AXES];
+            errors[i] = std::fabs(s.eval(v[0], v[1], v[2], v[3], v[4]) - unit_price(pricer, type, exercise, v));
+        }, params.threads);
+        for (double e : errors) s.validation_error_ = std::max(s.validation_error_, e);
+
+        s.fallback_ = pricer;
+        return s;
+    }
+
+    void ChebyshevSurrogate::save(const std::string& path) const {
+        FileHeader h{};
+        std::memcpy(h.magic, FILE_MAGIC, sizeof(h.magic));
+        h.version = FILE_VERSION;
+        h.type = static_cast<std::uint32_t>(type_);
+        h.exercise = static_cast<std::uint32_t>(exercise_);
+        h.axes = AXES;
+        h.european_control = european_control_ ? 1u : 0u;
+        h.front_fixed = front_fixed_ ? 1u : 0u;
+        for (int a = 0; a < AXES; ++a) {
+            const SurrogateAxis& ax = axis(domain_, a);
+            h.lo[a] = ax.lo;
+            h.hi[a] = ax.hi;
+            h.degree[a] = static_cast<std::uint32_t>(ax.degree);
+            h.pieces[a] = static_cast<std::uint32_t>(ax.pieces);
+        }
+        h.front_hi = front_hi_;
+        h.validation_error = validation_error_;
+        h.tail_estimate = tail_estimate_;
+        h.n_coefs = coefficient_count();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot open surrogate file for writing: " + path);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(coefs_.get()), static_cast<std::streamsize>(h.n_coefs * sizeof(double)));
+        if (!out) throw std::runtime_error("Failed writing surrogate file: " + path);
+    }
+
+    ChebyshevSurrogate ChebyshevSurrogate::load(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open surrogate file: " + path);
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Not a surrogate file: " + path);
+        }
+        const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        void* addr = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) throw std::runtime_error("Cannot map surrogate file: " + path);
+        // Owns the mapping from here on, so every throw below unmaps it
+        std::shared_ptr<const void> mapping(addr, [bytes](const void* p) { ::munmap(const_cast<void*>(p), bytes); });
+
+        FileHeader h;
+        std::memcpy(&h, addr, sizeof(h));
+        if (std::memcmp(h.magic, FILE_MAGIC, sizeof(h.magic)) != 0) throw std::runtime_error("Not a surrogate file: " + path);
+        if (h.version != FILE_VERSION) throw std::runtime_error("Unsupported surrogate file version: " + path);
+        if (h.axes != AXES || h.type > 1 || h.exercise > 1 || h.european_control > 1 || h.front_fixed > 1) {
+            throw std::runtime_error("Corrupt surrogate file header: " + path);
+        }
+
+        ChebyshevSurrogate s;
+        s.type_ = static_cast<opt::OptionType>(h.type);
+        s.exercise_ = static_cast<opt::Exercise>(h.exercise);
+        s.european_control_ = h.european_control != 0;
+        s.front_fixed_ = h.front_fixed != 0;
+        for (int a = 0; a < AXES; ++a) {
+            SurrogateAxis& ax = axis(s.domain_, a);
+            ax.lo = h.lo[a];
+            ax.hi = h.hi[a];
+            ax.degree = static_cast<int>(std::min<std::uint32_t>(h.degree[a], MAX_DEGREE + 1));
+            ax.pieces = static_cast<int>(std::min<std::uint32_t>(h.pieces[a], 1u << 20));
+        }
+        try {
+            check_domain(s.domain_);
+        } catch (const std::invalid_argument&) {
+            throw std::runtime_error("Corrupt surrogate file header: " + path);
+        }
+        s.front_hi_ = h.front_hi;
+        if (s.front_fixed_) s.set_layout(0.0, s.front_hi_);
+        else s.set_layout(std::log(s.domain_.moneyness.lo), std::log(s.domain_.moneyness.hi));
+        if (h.n_coefs != s.coefficient_count() || bytes != sizeof(FileHeader) + h.n_coefs * sizeof(double)) {
+            throw std::runtime_error("Corrupt surrogate file size: " + path);
+        }
+        s.validation_error_ = h.validation_error;
+        s.tail_estimate_ = h.tail_estimate;
+        s.coefs_ = std::shared_ptr<const double>(mapping,
+            reinterpret_cast<const double*>(static_cast<const char*>(addr) + sizeof(FileHeader)));
+        return s;
+    }
+
+    bool ChebyshevSurrogate::in_domain(const opt::Market& m, const opt::Option& opt) const {
+        if (opt.type != type_ || opt.exercise != exercise_) return false;
+        if (opt.K <= 0.0 || m.S0 <= 0.0) return false;
+        const double v[AXES] = {m.S0 / opt.K, m.sigma, opt.T, m.r, m.q};
+        for (int a = 0; a < AXES; ++a) {
+            const SurrogateAxis& ax = axis(domain_, a);
+            if (!(v[a] >= ax.lo && v[a] <= ax.hi)) return false;
+        }
+        return true;
+    }
+
+    double ChebyshevSurrogate::eval(double moneyness, double sigma, double T, double r, double q) const {
+        const double v[AXES] = {moneyness, sigma, T, r, q};
+        double c[AXES];
+        for (int a = 1; a < AXES; ++a) c[a] = to_coordinate(a, v[a]);
+        if (front_fixed_) {
+            c[0] = 0.0;
+            const double lnB = eval_table(boundary_, coefs_.get() + price_.count(), c);
+            const double lnx = std::log(moneyness);
+            const bool is_put = (type_ == opt::OptionType::Put);
+            c[0] = is_put ? lnx - lnB : lnB - lnx;
+            if (c[0] <= 0.0) return is_put ? 1.0 - moneyness : moneyness - 1.0; // exercise region
+        } else {
+            c[0] = to_coordinate(0, moneyness);
+        }
+        double value = eval_table(price_, coefs_.get(), c);
+        if (european_control_) value += unit_control(type_, v);
+        return value;
+    }
+
+    double ChebyshevSurrogate::price(const opt::Market& m, const opt::Option& opt) const {
+        if (in_domain(m, opt)) return opt.K * eval(m.S0 / opt.K, m.sigma, opt.T, m.r, m.q);
+        if (!fallback_) throw std::out_of_range("Request is outside the surrogate domain and no fallback pricer is set.");
+        return fallback_(m, opt);
+    }
+
+} // namespace pricers
@@ -0,0 +1,215 @@
+// EngineRouter.cpp: Picks the cheapest engine predicted to meet a target accuracy for each contract
+#include "pricers/EngineRouter.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/BjerksundStensland.hpp"
+#include "pricers/LeisenReimer.hpp"
+#include "util/Timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace pricers {
+
+    namespace {
+        // Error bounds in units of S0 sigma sqrt(T) (see EngineRouter.hpp)
+        constexpr double CRR_ERROR = 0.15;  // times 1/N
+        constexpr double LR_ERROR = 0.13;   // times 1/N
+        constexpr double INF = std::numeric_limits<double>::infinity();
+
+        // Bjerksund-Stensland and ALO degrade as kappa = 2 r / sigma^2 (2 q / sigma^2 for a
+        // call) grows: the exercise boundary steepens near expiry. ALO holds ~1e-10 below
+        // kappa = 5 but loses about an order of magnitude per band above it (survey worst cases,
+        // accurate / fast: 5e-6 / 4e-5 up to 7, 5e-5 / 2e-4 up to 10, 3e-4 / 7e-4 past it).
+        // Past kappa = 10 Bjerksund-Stensland's flat boundary can be off by more than the price
+        // itself.
+        struct ClosedFormBand {
+            double max_kappa;
+            double bs02;
+            double alo_fast;
+            double alo;
+        };
+        constexpr ClosedFormBand BANDS[] = {
+            {2.0, 1e-2, 1e-6, 1e-8},
+            {5.0, 1e-2, 3e-6, 5e-8},
+            {7.0, 1e-2, 1e-4, 1e-5},
+            {10.0, 1e-2, 4e-4, 1e-4},
+            {INF, INF, 1.5e-3, 6e-4},
+        };
+
+        const ClosedFormBand& band(const opt::Market& m, const opt::Option& opt) {
+            const double rate = (opt.type == opt::OptionType::Put) ? m.r : m.q;
+            const double kappa = 2.0 * rate / (m.sigma * m.sigma);
+            for (const ClosedFormBand& b : BANDS) {
+                if (kappa < b.max_kappa) return b;
+            }
+            return BANDS[4];
+        }
+
+        // American contracts whose early exercise is never optimal
+        bool never_exercised(const opt::Market& m, const opt::Option& opt) {
+            if (opt.type == opt::OptionType::Call) return m.q <= 0.0 && m.r >= 0.0;
+            return m.r <= 0.0 && m.q >= 0.0;
+        }
+
+        // Best of `repeats` timings of `calls` evaluations, in microseconds per call
+        template <typename F>
+        double time_us(F&& f, int calls, int repeats = 3) {
+            double best = std::numeric_limits<double>::infinity();
+            double sink = 0.0;
+            for (int rep = 0; rep < repeats; ++rep) {
+                util::Timer t;
+                for (int i = 0; i < calls; ++i) sink += f(i);
+                best = std::min(best, 1e6 * t.seconds() / calls);
+            }
+            volatile double keep = sink;  // keeps the pricing loops from being optimized away
+            (void)keep;
+            return best;
+        }
+    } // namespace
+
+    EngineRouter::EngineRouter(const RouterParams& p) : EngineRouter(calibrate(), p) {}
+
+    EngineRouter::EngineRouter(const RouterCostModel& model, const RouterParams& p) : model_(model), params_(p) {
+        if (p.min_steps <= 0 || p.max_steps < p.min_steps) throw std::invalid_argument("Number of steps must be positive.");
+    }
+
+    RouterCostModel EngineRouter::calibrate() {
+        // The contract only has to exercise the full code paths; each call nudges the spot so
+        // nothing can be hoisted out of the loop
+        const opt::Market m{100.0, 0.05, 0.02, 0.25};
+        const opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+        const opt::Option eu{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European};
+        auto at = [&](int i) { opt::Market mi = m; mi.S0 += 1e-3 * (i % 7); return mi; };
+
+        RouterCostModel c;
+        c.bs_us = time_us([&](int i) { return AnalyticBS::price(at(i), eu); }, 2000);
+        c.bs02_us = time_us([&](int i) { return BjerksundStensland::price(at(i), put); }, 200);
+        c.alo_fast_us = time_us([&](int i) { return AndersenLakeOffengelt::price(at(i), put, ALOParams::fast()); }, 40);
+        c.alo_us = time_us([&](int i) { return AndersenLakeOffengelt::price(at(i), put); }, 8);
+
+        // Two tree sizes fix the fixed and per-node costs
+        constexpr int N1 = 200, N2 = 1600;
+        auto fit = [&](double t1, double t2, double& fixed_us, double& node_ns) {
+            const double per_node_us = std::max(0.0, (t2 - t1) / (double(N2) * N2 - double(N1) * N1));
+            node_ns = 1e3 * per_node_us;
+            fixed_us = std::max(0.0, t1 - per_node_us * N1 * N1);
+        };
+        const double crr1 = time_us([&](int i) { return BinomialCRR::price_american(at(i), put, TreeParams{N1}); }, 8);
+        const double crr2 = time_us([&](int i) { return BinomialCRR::price_american(at(i), put, TreeParams{N2}); }, 1);
+        fit(crr1, crr2, c.crr_fixed_us, c.crr_node_ns);
+        const double lr1 = time_us([&](int i) { return LeisenReimer::price_american(at(i), put, TreeParams{N1 + 1}); }, 8);
+        const double lr2 = time_us([&](int i) { return LeisenReimer::price_american(at(i), put, TreeParams{N2 + 1}); }, 1);
+        fit(lr1, lr2, c.lr_fixed_us, c.lr_node_ns);
+        return c;
+    }
+
+    void EngineRouter::check_inputs(const opt::Market& m, const opt::Option& opt, double tol) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot price S0 must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike price K must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to maturity T must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility sigma must be positive.");
+        if (!(tol > 0.0)) throw std::invalid_argument("Target accuracy must be positive.");
+    }
+
+    double EngineRouter::predicted_error(const opt::Market& m, const opt::Option& opt, RequestEngine e, int steps) {
+        const bool exact = opt.exercise == opt::Exercise::European || never_exercised(m, opt);
+        const double scale = m.S0 * m.sigma * std::sqrt(opt.T);
+        switch (e) {
+            case RequestEngine::AnalyticBS:
+                return exact ? 0.0 : std::numeric_limits<double>::infinity();
+            case RequestEngine::CRR:
+                return CRR_ERROR * scale / std::max(steps, 1);
+            case RequestEngine::LeisenReimer:
+                return LR_ERROR * scale / std::max(steps, 1);
+            case RequestEngine::BjerksundStensland:
+                return band(m, opt).bs02 * scale;
+            case RequestEngine::ALO:
+                return band(m, opt).alo * scale;
+            case RequestEngine::ALOFast:
+                return band(m, opt).alo_fast * scale;
+            default:
+                throw std::invalid_argument("Engine is not a pricing engine.");
+        }
+    }
+
+    double EngineRouter::predicted_cost_us(RequestEngine e, int steps) const {
+        const double n2 = double(steps) * steps;
+        switch (e) {
+            case RequestEngine::AnalyticBS:         return model_.bs_us;
+            case RequestEngine::BjerksundStensland: return model_.bs02_us;
+            case RequestEngine::ALOFast:            return model_.alo_fast_us;
+            case RequestEngine::ALO:                return model_.alo_us;
+            case RequestEngine::CRR:                return model_.crr_fixed_us + 1e-3 * model_.crr_node_ns * n2;
+            case RequestEngine::LeisenReimer:       return model_.lr_fixed_us + 1e-3 * model_.lr_node_ns * n2;
+            default:
+                throw std::invalid_argument("Engine is not a pricing engine.");
+        }
+    }
+
+    RouteDecision EngineRouter::route(const opt::Market& m, const opt::Option& opt, double tol) const {
+        check_inputs(m, opt, tol);
+
+        auto decide = [&](RequestEngine e, int steps) {
+            RouteDecision d;
+            d.engine = e;
+            d.steps = steps;
+            d.predicted_error = predicted_error(m, opt, e, steps);
+            d.predicted_cost_us = predicted_cost_us(e, steps);
+            d.meets_target = d.predicted_error <= tol;
+            return d;
+        };
+
+        if (opt.exercise == opt::Exercise::European || never_exercised(m, opt)) {
+            return decide(RequestEngine::AnalyticBS, 0);
+        }
+
+        // Trees at the smallest N that meets tol (max_steps if none does; LR rounds up to odd)
+        const double scale = m.S0 * m.sigma * std::sqrt(opt.T);
+        auto tree_steps = [&](double c) {
+            const double n = std::ceil(c * scale / tol);
+            return static_cast<int>(std::min<double>(std::max<double>(n, params_.min_steps), params_.max_steps));
+        };
+        int lr_steps = tree_steps(LR_ERROR);
+        if (lr_steps % 2 == 0) lr_steps = (lr_steps < params_.max_steps) ? lr_steps + 1 : lr_steps - 1;
+
+        const RouteDecision candidates[] = {
+            decide(RequestEngine::BjerksundStensland, 0),
+            decide(RequestEngine::ALOFast, 0),
+            decide(RequestEngine::ALO, 0),
+            decide(RequestEngine::CRR, tree_steps(CRR_ERROR)),
+            decide(RequestEngine::LeisenReimer, lr_steps),
+        };
+
+        // Cheapest candidate meeting the target, else the most accurate one
+        const RouteDecision* best = nullptr;
+        for (const RouteDecision& d : candidates) {
+            if (d.meets_target && (!best || d.predicted_cost_us < best->predicted_cost_us)) best = &d;
+        }
+        if (best) return *best;
+        for (const RouteDecision& d : candidates) {
+            if (!best || d.predicted_error < best->predicted_error ||
+                (d.predicted_error == best->predicted_error && d.predicted_cost_us < best->predicted_cost_us)) {
+                best = &d;
+            }
+        }
+        return *best;
+    }
+
+    RoutedPrice EngineRouter::price(const opt::Market& m, const opt::Option& opt, double tol) const {
+        RoutedPrice res;
+        res.decision = route(m, opt, tol);
+        Request req;
+        req.engine = res.decision.engine;
+        req.market = m;
+        req.option = opt;
+        req.steps = res.decision.steps;
+        if (req.engine == RequestEngine::AnalyticBS) req.option.exercise = opt::Exercise::European;
+        res.price = RequestLog::execute(req);
+        return res;
+    }
+
+} // namespace pricers
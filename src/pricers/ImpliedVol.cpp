@@ -1,11 +1,44 @@
 #include "pricers/ImpliedVol.hpp"
 #include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
 
 #include <cmath> 
 #include <stdexcept> 
 #include <algorithm>
+#include <limits>
 
 namespace pricers {
+    namespace {
+        // Root of f(sigma) = price(sigma) - target for a price increasing in sigma. The first step
+        // is Newton with the supplied vega, later ones are secant; a step that leaves the bracket
+        // known so far is replaced by bisection. `slope` returns the last secant slope.
+        template <typename F>
+        double newton_secant(F&& f, double x0, double vega, double lo, double hi,
+                             double tol_sigma, double tol_price, int max_iter, double& slope) {
+            double x = x0, x_prev = 0.0, f_prev = 0.0;
+            bool have_prev = false;
+            slope = vega;
+            for (int it = 0; it < max_iter; ++it) {
+                const double fx = f(x);
+                if (std::fabs(fx) < tol_price) return x;
+                if (fx < 0.0) lo = x;
+                else hi = x;
+
+                if (have_prev && fx != f_prev) slope = (fx - f_prev) / (x - x_prev);
+                double next = (slope > 0.0) ? x - fx / slope : 0.5 * (lo + hi);
+                if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+                if (std::fabs(next - x) < tol_sigma) return next;
+
+                x_prev = x;
+                f_prev = fx;
+                have_prev = true;
+                x = next;
+            }
+            throw std::runtime_error("American implied volatility solver did not converge within max iterations.");
+        }
+    } // namespace
+
     void ImpliedVol::check_inputs(const opt::Market& m, 
                                  const opt::Option& opt, 
                                  double target_price) {
@@ -41,6 +74,14 @@ namespace pricers {
                               const opt::Option& opt, 
                               double target_price, 
                               const ImpliedVolParams& params) {
+        return solve_bs_as<double>(m_in, opt, target_price, params);
+    }
+
+    template <typename Real>
+    Real ImpliedVol::solve_bs_as(const opt::Market& m_in, 
+                                 const opt::Option& opt, 
+                                 double target_price, 
+                                 const ImpliedVolParams& params) {
         check_inputs(m_in, opt, target_price);
         // Enforce no-arbitrage bounds
         double lb = 0.0, ub = 0.0;
@@ -51,8 +92,13 @@ namespace pricers {
             throw std::invalid_argument("Target price violates no-arbitrage bounds.");
         }
 
-        if (std::fabs(target_price - lb) < params.tol_price) {
-            return params.sigma_lo; // Implied vol approaches 0
+        // Tolerances no finer than Real can resolve
+        const double eps_real = std::numeric_limits<Real>::epsilon();
+        const double tol_sigma = std::max(params.tol_sigma, 4.0 * eps_real);
+        const double tol_price = std::max(params.tol_price, 8.0 * eps_real * ub);
+
+        if (std::fabs(target_price - lb) < tol_price) {
+            return static_cast<Real>(params.sigma_lo); // Implied vol approaches 0
         }
 
         // Bracket sigma (volatility)
@@ -62,25 +108,25 @@ namespace pricers {
         opt::Market m = m_in; // Local copy to modify sigma
         auto price_at = [&](double sigma) -> double {
             m.sigma = sigma;
-            return AnalyticBS::price(m, opt);
+            return static_cast<double>(AnalyticBS::price_as<Real>(m, opt));
         }; // Lambda expression to compute price at given sigma
 
         double price_lo = price_at(lo);
         if (price_lo > target_price) {
-            return lo; // Implied vol is very low
+            return static_cast<Real>(lo); // Implied vol is very low
         }
         double price_hi = price_at(hi);
 
         // Expand upper bracket until we bracket the target price
         int expand = 0;
-        while (price_hi + params.tol_price < target_price && expand < 50) {
+        while (price_hi + tol_price < target_price && expand < 50) {
             hi *= 2.0;
             price_hi = price_at(hi);
             ++expand;
             if (hi > 10.0) break; // Prevent excessive volatility
         }
 
-        if (price_hi + params.tol_price < target_price) {
+        if (price_hi + tol_price < target_price) {
             throw std::runtime_error("Failed to bracket target price with volatility.");
         }
 
@@ -91,8 +137,8 @@ namespace pricers {
             const double pmid = price_at(mid);
             const double err = pmid - target_price;
 
-            if (std::fabs(err) < params.tol_price || (hi - lo) < params.tol_sigma) {
-                return mid; // Converged
+            if (std::fabs(err) < tol_price || (hi - lo) < tol_sigma) {
+                return static_cast<Real>(mid); // Converged
             }
 
             // Monotone: if pmid < target_price, need higher sigma
@@ -104,4 +150,126 @@ namespace pricers {
         }
         throw std::runtime_error("Implied volatility solver did not converge within max iterations.");
     }
-} // namespace pricers
\ No newline at end of file
+
+    template float ImpliedVol::solve_bs_as<float>(const opt::Market&, const opt::Option&, double, const ImpliedVolParams&);
+    template double ImpliedVol::solve_bs_as<double>(const opt::Market&, const opt::Option&, double, const ImpliedVolParams&);
+
+    double ImpliedVol::solve_bs_mixed(const opt::Market& m_in,
+                                      const opt::Option& opt,
+                                      double target_price,
+                                      const ImpliedVolParams& params) {
+        // Coarse stage in float
+        ImpliedVolParams coarse = params;
+        coarse.tol_sigma = std::max(params.tol_sigma, 1e-4);
+        double sigma = static_cast<double>(solve_bs_as<float>(m_in, opt, target_price, coarse));
+        if (sigma <= params.sigma_lo) {
+            // Float cannot resolve prices this close to the lower bound; use the double solver
+            return solve_bs(m_in, opt, target_price, params);
+        }
+
+        // Double polish: Newton on the BS price
+        opt::Market m = m_in;
+        for (int it = 0; it < 8; ++it) {
+            m.sigma = sigma;
+            const double err = AnalyticBS::price(m, opt) - target_price;
+            if (std::fabs(err) < params.tol_price) return sigma;
+
+            const double vega = AnalyticBS::greeks(m, opt).vega;
+            if (!(vega > 1e-14)) break;
+
+            const double next = sigma - err / vega;
+            if (!(next > 0.0)) break;
+            if (std::fabs(next - sigma) < params.tol_sigma) return next;
+            sigma = next;
+        }
+
+        return solve_bs(m_in, opt, target_price, params);
+    }
+
+    AmericanIVResult ImpliedVol::solve_american(const opt::Market& m_in,
+                                                const opt::Option& opt,
+                                                double target_price,
+                                                const AmericanIVParams& params) {
+        if (m_in.S0 <= 0.0) throw std::invalid_argument("Spot price S0 must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike price K must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to maturity T must be positive.");
+        if (opt.exercise != opt::Exercise::American) {
+            throw std::invalid_argument("American implied volatility requires an American option.");
+        }
+        if (params.steps <= 0 || params.coarse_steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+
+        // American no-arbitrage bounds: intrinsic <= V <= S0 (call) or K (put)
+        const bool is_call = (opt.type == opt::OptionType::Call);
+        const double intrinsic = is_call ? std::max(0.0, m_in.S0 - opt.K) : std::max(0.0, opt.K - m_in.S0);
+        const double upper = is_call ? m_in.S0 : opt.K;
+        if (target_price < intrinsic - 1e-12 || target_price > upper + 1e-12) {
+            throw std::invalid_argument("Target price violates no-arbitrage bounds.");
+        }
+
+        AmericanIVResult res;
+        if (target_price - intrinsic < params.tol_price) {
+            res.sigma = params.sigma_lo; // No time value left: any small vol reproduces the quote
+            return res;
+        }
+
+        opt::Market m = m_in;
+        TreeWorkspace ws; // one value layer for every tree evaluation
+        TreeParams tp;
+        tp.truncation_stddevs = params.truncation_stddevs;
+        // Below |r - q| sqrt(dt) the CRR up-probability leaves [0, 1]
+        auto tree_sigma_lo = [&](int N) {
+            return std::max(params.sigma_lo, 1.001 * std::fabs(m_in.r - m_in.q) * std::sqrt(opt.T / N));
+        };
+        auto tree_err = [&](double sigma) {
+            m.sigma = sigma;
+            ++res.tree_evals;
+            return BinomialCRR::price_american(m, opt, tp, ws) - target_price;
+        };
+
+        double sigma = 0.0, vega = 0.0;
+        if (params.fast_seed) {
+            const ALOParams fast = ALOParams::fast();
+            auto fast_err = [&](double s) {
+                m.sigma = s;
+                ++res.fast_evals;
+                return AndersenLakeOffengelt::price(m, opt, fast) - target_price;
+            };
+            if (fast_err(params.sigma_hi) < 0.0) {
+                throw std::runtime_error("Failed to bracket target price with volatility.");
+            }
+            m.sigma = 0.25;
+            const double seed_vega = AnalyticBS::greeks(m, opt::Option{opt.K, opt.T, opt.type, opt::Exercise::European}).vega;
+            sigma = newton_secant(fast_err, 0.25, seed_vega, params.sigma_lo, params.sigma_hi,
+                                  std::max(params.tol_sigma, 1e-6), 1e-3 * params.tol_price + 1e-8,
+                                  params.max_iter, vega);
+
+            // American vega at the seed (the secant slope may be stale)
+            const double h = 1e-4 * std::max(1.0, sigma);
+            vega = (fast_err(sigma + h) - fast_err(sigma - h)) / (2.0 * h);
+        } else {
+            // European IV of the quote as a first guess where it exists, then trees of 2x the
+            // steps per rung, each seeded with the previous rung's root and slope
+            const opt::Option eu{opt.K, opt.T, opt.type, opt::Exercise::European};
+            double lb = 0.0, ub = 0.0;
+            bs_bounds(m_in, eu, lb, ub);
+            sigma = (target_price > lb && target_price < ub) ? solve_bs(m_in, eu, target_price) : 0.25;
+            sigma = std::min(std::max(sigma, params.sigma_lo), params.sigma_hi);
+            m.sigma = sigma;
+            vega = AnalyticBS::greeks(m, eu).vega;
+
+            for (int N = params.coarse_steps; N < params.steps; N *= 2) {
+                tp.steps = N;
+                sigma = newton_secant(tree_err, std::max(sigma, tree_sigma_lo(N)), vega, tree_sigma_lo(N), params.sigma_hi,
+                                      std::max(params.tol_sigma, 1e-4), params.tol_price,
+                                      params.max_iter, vega);
+            }
+        }
+
+        // Polish on the target tree
+        tp.steps = params.steps;
+        const double lo = tree_sigma_lo(params.steps);
+        res.sigma = newton_secant(tree_err, std::max(sigma, lo), vega, lo, params.sigma_hi,
+                                  params.tol_sigma, params.tol_price, params.max_iter, vega);
+        return res;
+    }
+} // namespace pricers
@@ -0,0 +1,180 @@
+// ImpliedVolChain.cpp: Live implied vols for one expiry's quotes, re-solved incrementally on updates
+#include "pricers/ImpliedVolChain.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+namespace pricers {
+
+    namespace {
+        constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+        // Below this vega a price gap says nothing useful about sigma
+        constexpr double min_vega = 1e-12;
+    } // namespace
+
+    ImpliedVolChain::ImpliedVolChain(const opt::Market& m, double T, const ImpliedVolChainParams& p)
+        : T_(T), params_(p) {
+        if (T <= 0.0) throw std::invalid_argument("Time to maturity T must be positive.");
+        if (!(p.max_step > 0.0)) throw std::invalid_argument("Maximum warm step must be positive.");
+        sqrtT_ = std::sqrt(T);
+        set_market(m);
+    }
+
+    void ImpliedVolChain::set_market(const opt::Market& m) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot price S0 must be positive.");
+        m_ = m;
+        Fq_ = m.S0 * std::exp(-m.q * T_);
+        Dr_ = std::exp(-m.r * T_);
+    }
+
+    ImpliedVolChain::Quote& ImpliedVolChain::at(std::size_t i) {
+        if (i >= quotes_.size()) throw std::out_of_range("Quote index out of range.");
+        return quotes_[i];
+    }
+
+    const ImpliedVolChain::Quote& ImpliedVolChain::at(std::size_t i) const {
+        if (i >= quotes_.size()) throw std::out_of_range("Quote index out of range.");
+        return quotes_[i];
+    }
+
+    // Price, vega and volga from one set of d1, d2
+    void ImpliedVolChain::evaluate(Quote& q, double sigma) const {
+        const double sd = sigma * sqrtT_;
+        const double Fq = Fq_;
+        const double Kr = q.K * Dr_;
+        const double d1 = (std::log(Fq / Kr) + 0.5 * sd * sd) / sd;
+        const double d2 = d1 - sd;
+
+        q.model = (q.type == opt::OptionType::Call)
+            ? Fq * util::normal_cdf(d1) - Kr * util::normal_cdf(d2)
+            : Kr * util::normal_cdf(-d2) - Fq * util::normal_cdf(-d1);
+        q.vega = Fq * util::normal_pdf(d1) * sqrtT_;
+        q.volga = q.vega * d1 * d2 / sigma;
+    }
+
+    // One Halley step from the stored sigma, where model, vega and volga are already known, then
+    // one evaluation to check it. Leaves q untouched and returns false if the step is not trusted.
+    bool ImpliedVolChain::warm_step(Quote& q) const {
+        if (!(q.sigma > 0.0) || !(q.vega > min_vega)) return false;
+
+        const double gap = q.price - q.model;  // -f(sigma0)
+        const double newton = gap / q.vega;
+        const double denom = 1.0 + 0.5 * newton * q.volga / q.vega;
+        if (!(denom > 0.5)) return false;      // curvature term would dominate the step
+        const double step = newton / denom;
+        if (!(std::fabs(step) <= params_.max_step)) return false;
+        const double s1 = q.sigma + step;
+        if (!(s1 > params_.solve.sigma_lo)) return false;
+
+        Quote trial = q;
+        evaluate(trial, s1);
+        const double err = trial.model - q.price;
+        if (std::fabs(err) <= params_.solve.tol_price) {
+            trial.sigma = s1;
+        } else {
+            // Newton correction from the checking evaluation; it leaves an error of about
+            // volga / (2 vega) * polish^2 in sigma, and the values at s1 are carried over to
+            // first order rather than paying for another evaluation
+            if (!(trial.vega > min_vega)) return false;
+            const double polish = err / trial.vega;
+            if (!(std::fabs(polish) <= std::fabs(step))) return false;
+            const double residual = 0.5 * std::fabs(trial.volga / trial.vega) * polish * polish;
+            if (!(std::fabs(polish) <= params_.solve.tol_sigma || residual <= params_.solve.tol_sigma)) return false;
+            trial.sigma = s1 - polish;
+            trial.model = q.price + 0.5 * trial.volga * polish * polish;
+            trial.vega -= trial.volga * polish;
+        }
+        q = trial;
+        return true;
+    }
+
+    void ImpliedVolChain::full_solve(Quote& q) {
+        ++stats_.full;
+        try {
+            const opt::Option opt{q.K, T_, q.type, opt::Exercise::European};
+            const double sigma = ImpliedVol::solve_bs(m_, opt, q.price, params_.solve);
+            q.sigma = sigma;
+            evaluate(q, sigma);
+        } catch (const std::exception&) {
+            // No implied vol for this quote (outside the no-arbitrage bounds, or unbracketed);
+            // the chain keeps it and tries again on the next update
+            ++stats_.failed;
+            q.sigma = NaN;
+            q.model = NaN;
+            q.vega = NaN;
+            q.volga = NaN;
+        }
+    }
+
+    void ImpliedVolChain::resolve(std::size_t i, bool reprice) {
+        Quote& q = quotes_[i];
+        if (reprice && q.sigma > 0.0) evaluate(q, q.sigma);
+
+        if (warm_step(q)) ++stats_.warm;
+        else full_solve(q);
+
+        if (!q.dirty) {
+            q.dirty = true;
+            dirty_.push_back(i);
+        }
+        const bool was_nan = std::isnan(q.cleared), is_nan = std::isnan(q.sigma);
+        const bool moved = (was_nan != is_nan) ||
+                           (!is_nan && std::fabs(q.sigma - q.cleared) > params_.change_tol);
+        if (moved && !q.changed) {
+            q.changed = true;
+            changed_.push_back(i);
+        }
+    }
+
+    std::size_t ImpliedVolChain::add(double K, opt::OptionType type, double price) {
+        if (K <= 0.0) throw std::invalid_argument("Strike price K must be positive.");
+        Quote q;
+        q.K = K;
+        q.type = type;
+        q.price = price;
+        q.sigma = NaN;    // forces the full solve
+        q.cleared = NaN;
+        quotes_.push_back(q);
+
+        const std::size_t i = quotes_.size() - 1;
+        resolve(i, false);
+        if (!quotes_[i].changed) {
+            // New quotes are always reported, even the ones without an implied vol
+            quotes_[i].changed = true;
+            changed_.push_back(i);
+        }
+        return i;
+    }
+
+    void ImpliedVolChain::update(std::size_t i, double price) {
+        Quote& q = at(i);
+        if (price == q.price && !std::isnan(q.sigma)) return;  // nothing moved
+        q.price = price;
+        resolve(i, false);
+    }
+
+    void ImpliedVolChain::on_market(const opt::Market& m) {
+        set_market(m);
+        for (std::size_t i = 0; i < quotes_.size(); ++i) resolve(i, true);
+    }
+
+    double ImpliedVolChain::sigma(std::size_t i) const { return at(i).sigma; }
+    double ImpliedVolChain::vega(std::size_t i) const { return at(i).vega; }
+    double ImpliedVolChain::quote(std::size_t i) const { return at(i).price; }
+
+    void ImpliedVolChain::clear_dirty() {
+        for (std::size_t i : dirty_) {
+            Quote& q = quotes_[i];
+            q.dirty = false;
+            q.changed = false;
+            q.cleared = q.sigma;
+        }
+        dirty_.clear();
+        changed_.clear();
+    }
+
+} // namespace pricers
@@ -0,0 +1,125 @@
+// LeisenReimer.cpp: Leisen-Reimer binomial tree (Peizer-Pratt inversion) option pricing model
+#include "pricers/LeisenReimer.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+namespace pricers {
+
+    double LeisenReimer::price_european(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::European) throw std::invalid_argument("Binomial European Pricer only supports European Options.");
+
+        return rollback<false>(m, opt, make_coefs(m, opt, p));
+    }
+
+    double LeisenReimer::price_american(const opt::Market& m,
+                                        const opt::Option& opt,
+                                        const TreeParams& p) {
+        check_inputs(m, opt, p);
+        if (opt.exercise != opt::Exercise::American) throw std::invalid_argument("Binomial American Pricer only supports American Options.");
+
+        return rollback<true>(m, opt, make_coefs(m, opt, p));
+    }
+
+    // Node (step, i) is S0 u^i d^(step - i) = g^step S0 v^(2i - step) with g = sqrt(u d) and
+    // v = sqrt(u / d). The rows read BinomialCRR's table of S0 v^j and run its induct_row
+    // kernel, with g^step folded into the strike (payoff(g^s x, K) = g^s payoff(x, K / g^s))
+    // and the exercise scaling. Values are carried in maturity units as in the CRR rollback.
+    template <bool American>
+    double LeisenReimer::rollback(const opt::Market& m,
+                                  const opt::Option& opt,
+                                  const LRCoefs& c) {
+        const int N = c.steps;
+        const double v = std::sqrt(c.u / c.d);
+        const double g = std::sqrt(c.u * c.d);
+        thread_local std::vector<double> prices;
+        BinomialCRR::node_prices(m.S0, v, 1.0 / v, N, prices);
+        const double* S = prices.data();
+
+        std::vector<double> values(N + 1);
+        const double gN = std::pow(g, N);
+        for (int i = 0; i <= N; ++i) values[i] = payoff(gN * S[2 * i], opt);
+
+        opt::Option row_opt = opt;
+        for (int step = N - 1; step >= 0; --step) {
+            const double gs = std::pow(g, step);
+            row_opt.K = opt.K / gs;
+            const double growth = American ? std::exp(m.r * c.dt * (N - step)) * gs : 0.0;
+            BinomialCRR::induct_row<double, American>(values.data(), 0, step + 1, step, N, c.pu, c.pd, growth, S, row_opt);
+        }
+        return values[0] * std::exp(-m.r * opt.T);
+    }
+
+    double LeisenReimer::price_american_richardson(const opt::Market& m,
+                                                   const opt::Option& opt,
+                                                   const TreeParams& p) {
+        TreeParams coarse = p;
+        coarse.steps = odd_steps(p.steps);
+        TreeParams fine = p;
+        fine.steps = 2 * coarse.steps + 1;
+
+        const double v_coarse = price_american(m, opt, coarse);
+        const double v_fine = price_american(m, opt, fine);
+
+        // Error ~ c / N  =>  eliminate c between the two step counts
+        const double n1 = coarse.steps, n2 = fine.steps;
+        return (n2 * v_fine - n1 * v_coarse) / (n2 - n1);
+    }
+
+    void LeisenReimer::check_inputs(const opt::Market& m,
+                                    const opt::Option& opt,
+                                    const TreeParams& p) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (p.steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+        if (p.truncation_stddevs != 0.0) throw std::invalid_argument("Leisen-Reimer trees do not support truncation.");
+    }
+
+    double LeisenReimer::peizer_pratt(double z, int n) {
+        const double nd = static_cast<double>(n);
+        const double t = z / (nd + 1.0 / 3.0 + 0.1 / (nd + 1.0));
+        const double root = std::sqrt(0.25 - 0.25 * std::exp(-t * t * (nd + 1.0 / 6.0)));
+        return (z >= 0.0) ? 0.5 + root : 0.5 - root;
+    }
+
+    LeisenReimer::LRCoefs LeisenReimer::make_coefs(const opt::Market& m,
+                                                   const opt::Option& opt,
+                                                   const TreeParams& p) {
+        LRCoefs c;
+        c.steps = odd_steps(p.steps);
+        c.dt = opt.T / c.steps;
+
+        const double volSqrtT = m.sigma * std::sqrt(opt.T);
+        const double d1 = (std::log(m.S0 / opt.K) + (m.r - m.q + 0.5 * m.sigma * m.sigma) * opt.T) / volSqrtT;
+        const double d2 = d1 - volSqrtT;
+
+        const double growth = std::exp((m.r - m.q) * c.dt);
+        c.pu = peizer_pratt(d2, c.steps);
+        const double p_bar = peizer_pratt(d1, c.steps);
+
+        c.u = growth * p_bar / c.pu;
+        c.d = (growth - c.pu * c.u) / (1.0 - c.pu);
+        c.pd = 1.0 - c.pu;
+        c.disc = std::exp(-m.r * c.dt);
+
+        if (!(c.pu > 0.0 && c.pu < 1.0) || !(c.d > 0.0) || !(c.u > c.d)) {
+            throw std::invalid_argument("Leisen-Reimer tree parameters are degenerate, please check inputs.");
+        }
+        return c;
+    }
+
+    double LeisenReimer::payoff(double S, const opt::Option& opt) {
+        if (opt.type == opt::OptionType::Call) {
+            return std::max(0.0, S - opt.K);
+        } else {
+            return std::max(0.0, opt.K - S);
+        }
+    }
+
+} // namespace pricers
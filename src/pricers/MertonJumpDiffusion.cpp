@@ -0,0 +1,149 @@
+// MertonJumpDiffusion.cpp: Merton (1976) jump-diffusion European pricer as an adaptive Poisson series of BS terms
+#include "pricers/MertonJumpDiffusion.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace pricers {
+    namespace {
+        constexpr int MAX_TERMS = MertonJumpDiffusion::max_terms;
+
+        // Number of terms n = 0..N-1 whose dropped Poisson(x) tail is below tol. Past the mode,
+        // p(m+1) / p(m) = x / (m+1) falls, so the tail after n is at most the geometric sum
+        // p(n+1) / (1 - x / (n+2)).
+        int series_terms(double x, double tol) {
+            double pn = std::exp(-x);
+            if (!(pn > 0.0)) throw std::invalid_argument("Merton jump intensity is too large for the Poisson series.");
+            for (int n = 0; n + 1 < MAX_TERMS; ++n) {
+                const double next = pn * x / (n + 1);
+                if (n + 2 > x && next <= tol * (1.0 - x / (n + 2))) return n + 1;
+                pn = next;
+            }
+            throw std::invalid_argument("Merton jump intensity is too large for the Poisson series.");
+        }
+
+        template <bool WithGreeks>
+        MertonResult series(double S, double K, double T, double r, double q, double sigma, bool is_call,
+                            const MertonParams& jp, double tol) {
+            // Contract-static pieces; everything per term below is a multiply-add away from them
+            const double log_jump = jp.mu_j + 0.5 * jp.sigma_j * jp.sigma_j; // ln(1 + k)
+            const double k = std::expm1(log_jump);
+            const double x = jp.lambda * T; // expected jump count
+            const double Dr = std::exp(-r * T);
+            const double Dq = std::exp(-q * T);
+            const double DrK = Dr * K;
+            const double G0 = S * Dq * std::exp(-jp.lambda * k * T); // discounted forward, no jumps
+            const double lnFK0 = std::log(G0 / DrK);
+            const double var0 = sigma * sigma * T;
+            const double var_j = jp.sigma_j * jp.sigma_j;
+            const double one_k = 1.0 + k;
+
+            const int N = series_terms(x, tol);
+
+            // Weights, discounted forwards and moneyness by recurrence
+            double w[MAX_TERMS], G[MAX_TERMS], lnFK[MAX_TERMS], var[MAX_TERMS];
+            w[0] = std::exp(-x);
+            G[0] = G0;
+            for (int n = 1; n < N; ++n) {
+                w[n] = w[n - 1] * x / n;
+                G[n] = G[n - 1] * one_k;
+            }
+            for (int n = 0; n < N; ++n) {
+                lnFK[n] = lnFK0 + n * log_jump;
+                var[n] = var0 + n * var_j;
+            }
+
+            // The BS terms in one pass: Black put on (G_n, K) with total variance var_n
+            double put[MAX_TERMS], Nm1[MAX_TERMS], Nm2[MAX_TERMS], phi_sw[MAX_TERMS];
+            for (int n = 0; n < N; ++n) {
+                const double sw = std::sqrt(var[n]);
+                const double d1 = lnFK[n] / sw + 0.5 * sw;
+                const double d2 = d1 - sw;
+                Nm1[n] = util::normal_cdf(-d1);
+                Nm2[n] = util::normal_cdf(-d2);
+                put[n] = DrK * Nm2[n] - G[n] * Nm1[n];
+                if (WithGreeks) phi_sw[n] = util::normal_pdf(d1) / sw;
+            }
+
+            MertonResult res;
+            res.terms = N;
+            double P = 0.0;
+            for (int n = 0; n < N; ++n) P += w[n] * put[n];
+            res.price = is_call ? P + S * Dq - DrK : P;
+            if (!WithGreeks) return res;
+
+            // Greeks of the put as weighted sums of the term Greeks. Theta also differentiates
+            // the Poisson weights: d w_n / dT = lambda (w_{n-1} - w_n).
+            double sG_N1 = 0.0, sG_phi = 0.0, s_N2 = 0.0, s_dT = 0.0;
+            const double drift = r - q - jp.lambda * k;
+            for (int n = 0; n < N; ++n) {
+                const double g_phi = G[n] * phi_sw[n];
+                sG_N1 += w[n] * G[n] * Nm1[n];
+                sG_phi += w[n] * g_phi;
+                s_N2 += w[n] * Nm2[n];
+                const double dput_dT = -r * put[n] - drift * G[n] * Nm1[n] + 0.5 * sigma * sigma * g_phi;
+                const double dw_dT = jp.lambda * ((n > 0 ? w[n - 1] : 0.0) - w[n]);
+                s_dT += w[n] * dput_dT + dw_dT * put[n];
+            }
+            Greeks& g = res.greeks;
+            g.delta = -sG_N1 / S;
+            g.gamma = sG_phi / (S * S);
+            g.vega = sigma * T * sG_phi;
+            g.rho = -T * DrK * s_N2;
+            g.theta = -s_dT;
+            if (is_call) {
+                g.delta += Dq;
+                g.rho += T * DrK;
+                g.theta += q * S * Dq - r * DrK;
+            }
+            return res;
+        }
+    } // namespace
+
+    void MertonJumpDiffusion::check_inputs(const opt::Market& m, const opt::Option& o) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (o.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (o.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (o.exercise != opt::Exercise::European) throw std::invalid_argument("Merton jump-diffusion only supports European Options.");
+    }
+
+    void MertonJumpDiffusion::check_jumps(const MertonParams& jumps, const MertonSeriesParams& p) {
+        if (jumps.lambda < 0.0) throw std::invalid_argument("Jump intensity must be non-negative.");
+        if (jumps.sigma_j < 0.0) throw std::invalid_argument("Jump volatility must be non-negative.");
+        if (!(p.tolerance > 0.0)) throw std::invalid_argument("Series tolerance must be positive.");
+    }
+
+    double MertonJumpDiffusion::price(const opt::Market& m,
+                                      const opt::Option& opt,
+                                      const MertonParams& jumps,
+                                      const MertonSeriesParams& p) {
+        check_inputs(m, opt);
+        check_jumps(jumps, p);
+        return series<false>(m.S0, opt.K, opt.T, m.r, m.q, m.sigma, opt.type == opt::OptionType::Call, jumps, p.tolerance).price;
+    }
+
+    MertonResult MertonJumpDiffusion::price_greeks(const opt::Market& m,
+                                                   const opt::Option& opt,
+                                                   const MertonParams& jumps,
+                                                   const MertonSeriesParams& p) {
+        check_inputs(m, opt);
+        check_jumps(jumps, p);
+        return series<true>(m.S0, opt.K, opt.T, m.r, m.q, m.sigma, opt.type == opt::OptionType::Call, jumps, p.tolerance);
+    }
+
+    void MertonJumpDiffusion::price_batch(std::size_t n,
+                                          const double* S0, const double* K, const double* T,
+                                          const double* r, const double* q, const double* sigma,
+                                          const opt::OptionType* type,
+                                          const MertonParams& jumps,
+                                          double* out,
+                                          const MertonSeriesParams& p) {
+        check_jumps(jumps, p);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = series<false>(S0[i], K[i], T[i], r[i], q[i], sigma[i], type[i] == opt::OptionType::Call, jumps, p.tolerance).price;
+        }
+    }
+
+} // namespace pricers
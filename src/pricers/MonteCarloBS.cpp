@@ -0,0 +1,81 @@
+// MonteCarloBS.cpp: Monte Carlo pricer for European options under Black-Scholes dynamics
+#include "pricers/MonteCarloBS.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <random>
+#include <algorithm>
+
+namespace pricers {
+
+    void MonteCarloBS::check_inputs(const opt::Market& m,
+                                    const opt::Option& opt,
+                                    const MCParams& p) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (opt.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (opt.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (p.paths <= 0) throw std::invalid_argument("Number of paths must be positive.");
+        if (opt.exercise != opt::Exercise::European) throw std::invalid_argument("Monte Carlo pricer only supports European Options.");
+    }
+
+    double MonteCarloBS::price(const opt::Market& m,
+                               const opt::Option& opt,
+                               const MCParams& p) {
+        return greeks(m, opt, p).price;
+    }
+
+    AdjointGreeks MonteCarloBS::greeks(const opt::Market& m,
+                                       const opt::Option& opt,
+                                       const MCParams& p) {
+        check_inputs(m, opt, p);
+
+        const double T = opt.T;
+        const double sqrtT = std::sqrt(T);
+        const double drift = (m.r - m.q - 0.5 * m.sigma * m.sigma) * T;
+        const double volSqrtT = m.sigma * sqrtT;
+        const double disc = std::exp(-m.r * T);
+        const bool is_call = (opt.type == opt::OptionType::Call);
+
+        std::mt19937_64 rng(p.seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+
+        // Undiscounted sums of payoff and of the path adjoints dPayoff/dS_T * dS_T/dtheta
+        double sum_pay = 0.0;
+        double sum_dS0 = 0.0;
+        double sum_dsig = 0.0;
+        double sum_drift = 0.0; // dS_T/dr = S_T*T, dS_T/dq = -S_T*T
+
+        auto path = [&](double z) {
+            const double ST = m.S0 * std::exp(drift + volSqrtT * z);
+            const double pay = is_call ? std::max(0.0, ST - opt.K) : std::max(0.0, opt.K - ST);
+            const double bar_ST = is_call ? (ST > opt.K ? 1.0 : 0.0) : (ST < opt.K ? -1.0 : 0.0);
+            sum_pay += pay;
+            if (bar_ST != 0.0) {
+                sum_dS0 += bar_ST * ST / m.S0;
+                sum_dsig += bar_ST * ST * (sqrtT * z - m.sigma * T);
+                sum_drift += bar_ST * ST * T;
+            }
+        };
+
+        int n = 0;
+        while (n < p.paths) {
+            const double z = normal(rng);
+            path(z);
+            ++n;
+            if (p.antithetic && n < p.paths) {
+                path(-z);
+                ++n;
+            }
+        }
+
+        const double inv_n = 1.0 / static_cast<double>(n);
+        AdjointGreeks g;
+        g.price = disc * sum_pay * inv_n;
+        g.delta = disc * sum_dS0 * inv_n;
+        g.vega = disc * sum_dsig * inv_n;
+        g.rho = disc * sum_drift * inv_n - T * g.price;
+        g.rho_q = -disc * sum_drift * inv_n;
+        return g;
+    }
+
+} // namespace pricers
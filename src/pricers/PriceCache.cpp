@@ -0,0 +1,191 @@
+// PriceCache.cpp: Sharded, bounded memo cache of tree prices keyed on quantized contract inputs
+#include "pricers/PriceCache.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace pricers {
+
+    namespace {
+        // splitmix64 finaliser: spreads nearby quantized values over the whole word
+        std::uint64_t mix(std::uint64_t x) {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+    } // namespace
+
+    bool PriceCache::Key::operator==(const Key& o) const {
+        return std::memcmp(q, o.q, sizeof(q)) == 0 && steps == o.steps && type == o.type && exercise == o.exercise;
+    }
+
+    std::size_t PriceCache::KeyHash::operator()(const Key& k) const {
+        std::uint64_t h = mix(static_cast<std::uint64_t>(k.steps) << 16 | static_cast<std::uint64_t>(k.type) << 8 | static_cast<std::uint64_t>(k.exercise));
+        for (std::int64_t v : k.q) h = mix(h ^ static_cast<std::uint64_t>(v));
+        return static_cast<std::size_t>(h);
+    }
+
+    PriceCache::Pricer PriceCache::tree_pricer() {
+        return [](const opt::Market& m, const opt::Option& opt, int steps) {
+            const TreeParams tp{steps};
+            return (opt.exercise == opt::Exercise::American) ? BinomialCRR::price_american(m, opt, tp)
+                                                             : BinomialCRR::price_european(m, opt, tp);
+        };
+    }
+
+    PriceCache::PriceCache(const PriceCacheParams& p, Pricer pricer)
+        : params_(p), pricer_(std::move(pricer)) {
+        if (p.shards == 0) throw std::invalid_argument("Price cache needs at least one shard.");
+        if (p.capacity == 0) throw std::invalid_argument("Price cache capacity must be positive.");
+        for (double step : {p.spot_step, p.strike_step, p.time_step, p.rate_step, p.vol_step}) {
+            if (!(step >= 0.0)) throw std::invalid_argument("Quantization steps must be non-negative.");
+        }
+        if (!pricer_) throw std::invalid_argument("Price cache needs a pricer.");
+
+        const std::size_t per_shard = (p.capacity + p.shards - 1) / p.shards;
+        shards_.reserve(p.shards);
+        for (unsigned i = 0; i < p.shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->slots.resize(per_shard);
+            shards_.back()->index.reserve(per_shard);
+        }
+    }
+
+    // Step 0 keys on the bit pattern (so -0.0 and 0.0 differ, which only costs a miss)
+    std::int64_t PriceCache::quantize(double x, double step, double& snapped) const {
+        if (step > 0.0) {
+            const std::int64_t k = std::llround(x / step);
+            snapped = static_cast<double>(k) * step;
+            return k;
+        }
+        snapped = x;
+        std::int64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    // Never-used or dropped slot if any, else the first unreferenced one under the CLOCK hand.
+    // In-flight entries are skipped for up to two sweeps, then evicted too (their waiters hold
+    // the future).
+    std::size_t PriceCache::claim_slot(Shard& s) {
+        if (s.used < s.slots.size()) return s.used++;
+        const std::size_t n = s.slots.size();
+        for (std::size_t scanned = 0;; ++scanned) {
+            const std::size_t i = s.hand;
+            s.hand = (s.hand + 1 == n) ? 0 : s.hand + 1;
+            Slot& slot = s.slots[i];
+            if (!slot.live) return i;
+            if (slot.pending && scanned < 2 * n) continue;
+            if (slot.referenced && scanned < 2 * n) {
+                slot.referenced = false;
+                continue;
+            }
+            s.index.erase(slot.key);
+            ++s.stats.evictions;
+            return i;
+        }
+    }
+
+    double PriceCache::price(const opt::Market& m, const opt::Option& opt, int steps) {
+        Key key;
+        opt::Market mq = m;
+        opt::Option oq = opt;
+        key.q[0] = quantize(m.S0, params_.spot_step, mq.S0);
+        key.q[1] = quantize(opt.K, params_.strike_step, oq.K);
+        key.q[2] = quantize(opt.T, params_.time_step, oq.T);
+        key.q[3] = quantize(m.r, params_.rate_step, mq.r);
+        key.q[4] = quantize(m.q, params_.rate_step, mq.q);
+        key.q[5] = quantize(m.sigma, params_.vol_step, mq.sigma);
+        key.steps = steps;
+        key.type = static_cast<std::int8_t>(opt.type);
+        key.exercise = static_cast<std::int8_t>(opt.exercise);
+
+        // High hash bits pick the shard; the shard's map buckets on the full hash
+        Shard& s = *shards_[(KeyHash{}(key) >> 40) % shards_.size()];
+        std::promise<double> promise;
+        std::uint64_t id = 0;
+        {
+            std::unique_lock<std::mutex> lock(s.mutex);
+            auto it = s.index.find(key);
+            if (it != s.index.end()) {
+                Slot& slot = s.slots[it->second];
+                slot.referenced = true;
+                std::shared_future<double> value = slot.value;
+                ++(slot.pending ? s.stats.joins : s.stats.hits);
+                lock.unlock();
+                return value.get();
+            }
+
+            ++s.stats.misses;
+            const std::size_t i = claim_slot(s);
+            Slot& slot = s.slots[i];
+            slot.key = key;
+            slot.value = promise.get_future().share();
+            slot.id = id = ++s.next_id;
+            slot.live = true;
+            slot.referenced = false;
+            slot.pending = true;
+            s.index.emplace(key, i);
+        }
+
+        // Price outside the lock; the slot is found through the index again afterwards because
+        // it may have been evicted (and reused) meanwhile
+        auto finish = [&](bool ok) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto it = s.index.find(key);
+            if (it == s.index.end() || s.slots[it->second].id != id) return;
+            Slot& slot = s.slots[it->second];
+            slot.pending = false;
+            if (!ok) {
+                // Failed prices are not cached; the CLOCK hand reclaims the dropped slot
+                slot.live = false;
+                s.index.erase(it);
+            }
+        };
+        try {
+            const double v = pricer_(mq, oq, steps);
+            promise.set_value(v);
+            finish(true);
+            return v;
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            finish(false);
+            throw;
+        }
+    }
+
+    PriceCacheStats PriceCache::stats() const {
+        PriceCacheStats total;
+        for (const auto& sp : shards_) {
+            std::lock_guard<std::mutex> lock(sp->mutex);
+            total.hits += sp->stats.hits;
+            total.joins += sp->stats.joins;
+            total.misses += sp->stats.misses;
+            total.evictions += sp->stats.evictions;
+            total.size += sp->index.size();
+        }
+        return total;
+    }
+
+    void PriceCache::clear() {
+        for (const auto& sp : shards_) {
+            std::lock_guard<std::mutex> lock(sp->mutex);
+            // In-flight entries stay so their owners can still finish them
+            for (auto it = sp->index.begin(); it != sp->index.end();) {
+                Slot& slot = sp->slots[it->second];
+                if (slot.pending) {
+                    ++it;
+                    continue;
+                }
+                slot.value = std::shared_future<double>();
+                slot.live = false;
+                slot.referenced = false;
+                it = sp->index.erase(it);
+            }
+        }
+    }
+
+} // namespace pricers
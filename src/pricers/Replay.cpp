@@ -0,0 +1,135 @@
+// Replay.cpp: Replays captured pricing requests and reports throughput and latency per engine
+#include "pricers/Replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace pricers {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        struct Outcome {
+            double latency_us = 0.0;
+            bool failed = false;
+        };
+
+        // Nearest-rank percentile of sorted values
+        double percentile(const std::vector<double>& sorted, double p) {
+            if (sorted.empty()) return 0.0;
+            const std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+            return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+        }
+
+        ReplayEngineStats summarize(std::vector<double>& latency, std::size_t failed, double seconds) {
+            ReplayEngineStats s;
+            s.count = latency.size();
+            s.failed = failed;
+            if (latency.empty()) return s;
+            std::sort(latency.begin(), latency.end());
+            double sum = 0.0;
+            for (double l : latency) sum += l;
+            s.throughput = seconds > 0.0 ? s.count / seconds : 0.0;
+            s.mean_us = sum / s.count;
+            s.p50_us = percentile(latency, 0.50);
+            s.p90_us = percentile(latency, 0.90);
+            s.p99_us = percentile(latency, 0.99);
+            s.max_us = latency.back();
+            return s;
+        }
+    } // namespace
+
+    ReplayResult Replay::run(const std::vector<Request>& reqs, const ReplayParams& p) {
+        if (p.speed < 0.0 || !std::isfinite(p.speed)) throw std::invalid_argument("Replay speed must be non-negative.");
+
+        // Arrival offsets from the first request; captures appended out of order are clamped
+        std::vector<Clock::duration> arrival(reqs.size());
+        if (p.speed > 0.0 && !reqs.empty()) {
+            const std::int64_t t0 = reqs.front().t_ns;
+            for (std::size_t i = 0; i < reqs.size(); ++i) {
+                const double ns = std::max<std::int64_t>(reqs[i].t_ns - t0, 0) / p.speed;
+                arrival[i] = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(ns));
+            }
+        }
+
+        std::vector<Outcome> outcome(reqs.size());
+        std::atomic<std::size_t> next{0};
+        const Clock::time_point start = Clock::now();
+
+        // Each free worker takes the oldest request not yet served, waits for it to arrive,
+        // and runs it: a FIFO queue served by the pool, without the queue itself
+        auto serve = [&]() {
+            for (;;) {
+                const std::size_t i = next.fetch_add(1);
+                if (i >= reqs.size()) return;
+                Clock::time_point arrived;
+                if (p.speed > 0.0) {
+                    arrived = start + arrival[i];
+                    std::this_thread::sleep_until(arrived);
+                } else {
+                    arrived = Clock::now();
+                }
+                try {
+                    (void)RequestLog::execute(reqs[i]);
+                } catch (const std::exception&) {
+                    outcome[i].failed = true;
+                }
+                outcome[i].latency_us = std::chrono::duration<double, std::micro>(Clock::now() - arrived).count();
+            }
+        };
+
+        if (p.workers == 0) {
+            serve();
+        } else {
+            std::vector<std::thread> team;
+            team.reserve(p.workers);
+            for (unsigned t = 0; t < p.workers; ++t) team.emplace_back(serve);
+            for (std::thread& t : team) t.join();
+        }
+
+        ReplayResult res;
+        res.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<std::vector<double>> latency(request_engine_count);
+        std::vector<std::size_t> failed(request_engine_count, 0);
+        std::vector<double> all;
+        all.reserve(reqs.size());
+        std::size_t all_failed = 0;
+        for (std::size_t i = 0; i < reqs.size(); ++i) {
+            const int e = static_cast<int>(reqs[i].engine);
+            latency[e].push_back(outcome[i].latency_us);
+            all.push_back(outcome[i].latency_us);
+            if (outcome[i].failed) {
+                ++failed[e];
+                ++all_failed;
+            }
+        }
+        for (int e = 0; e < request_engine_count; ++e) {
+            if (latency[e].empty()) continue;
+            ReplayEngineStats s = summarize(latency[e], failed[e], res.seconds);
+            s.engine = static_cast<RequestEngine>(e);
+            res.engines.push_back(s);
+        }
+        res.all = summarize(all, all_failed, res.seconds);
+        return res;
+    }
+
+    std::string Replay::to_csv(const ReplayResult& r) {
+        std::ostringstream os;
+        os.precision(10);
+        os << "engine,count,failed,throughput,mean_us,p50_us,p90_us,p99_us,max_us\n";
+        auto row = [&](const char* name, const ReplayEngineStats& s) {
+            os << name << ',' << s.count << ',' << s.failed << ',' << s.throughput << ',' << s.mean_us << ','
+               << s.p50_us << ',' << s.p90_us << ',' << s.p99_us << ',' << s.max_us << '\n';
+        };
+        for (const ReplayEngineStats& s : r.engines) row(RequestLog::engine_name(s.engine), s);
+        row("all", r.all);
+        return os.str();
+    }
+
+} // namespace pricers
@@ -0,0 +1,192 @@
+// RequestLog.cpp: Binary capture of pricing requests for offline replay
+#include "pricers/RequestLog.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/BjerksundStensland.hpp"
+#include "pricers/ImpliedVol.hpp"
+#include "pricers/LeisenReimer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace pricers {
+
+    namespace {
+        constexpr char FILE_MAGIC[8] = {'O', 'P', 'T', 'R', 'E', 'Q', '\0', '\0'};
+
+        const char* const ENGINE_NAMES[request_engine_count] = {"bs", "crr", "lr", "alo", "bs02", "iv-bs", "iv-crr", "alo-fast"};
+
+        template <typename T>
+        void put(unsigned char*& p, T v) {
+            std::memcpy(p, &v, sizeof(T));
+            p += sizeof(T);
+        }
+
+        template <typename T>
+        T take(const unsigned char*& p) {
+            T v;
+            std::memcpy(&v, p, sizeof(T));
+            p += sizeof(T);
+            return v;
+        }
+
+        void encode_header(unsigned char* out) {
+            unsigned char* p = out;
+            std::memcpy(p, FILE_MAGIC, sizeof(FILE_MAGIC));
+            p += sizeof(FILE_MAGIC);
+            put<std::uint32_t>(p, RequestLog::version);
+            put<std::uint32_t>(p, static_cast<std::uint32_t>(RequestLog::record_size));
+        }
+
+        // Throws unless the header is ours, in this version
+        void check_header(const unsigned char* in, const std::string& path) {
+            if (std::memcmp(in, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) throw std::runtime_error("Not a request capture file: " + path);
+            const unsigned char* p = in + sizeof(FILE_MAGIC);
+            const std::uint32_t version = take<std::uint32_t>(p);
+            const std::uint32_t record_size = take<std::uint32_t>(p);
+            if (version != RequestLog::version || record_size != RequestLog::record_size) {
+                throw std::runtime_error("Unsupported request capture file version: " + path);
+            }
+        }
+    } // namespace
+
+    void RequestLog::encode(const Request& req, unsigned char* out) {
+        unsigned char* p = out;
+        put<std::int64_t>(p, req.t_ns);
+        put<double>(p, req.market.S0);
+        put<double>(p, req.market.r);
+        put<double>(p, req.market.q);
+        put<double>(p, req.market.sigma);
+        put<double>(p, req.option.K);
+        put<double>(p, req.option.T);
+        put<double>(p, req.target);
+        put<std::int32_t>(p, req.steps);
+        put<std::uint8_t>(p, static_cast<std::uint8_t>(req.engine));
+        put<std::uint8_t>(p, static_cast<std::uint8_t>(req.option.type));
+        put<std::uint8_t>(p, static_cast<std::uint8_t>(req.option.exercise));
+        put<std::uint8_t>(p, 0);
+    }
+
+    Request RequestLog::decode(const unsigned char* in) {
+        const unsigned char* p = in;
+        Request req;
+        req.t_ns = take<std::int64_t>(p);
+        req.market.S0 = take<double>(p);
+        req.market.r = take<double>(p);
+        req.market.q = take<double>(p);
+        req.market.sigma = take<double>(p);
+        req.option.K = take<double>(p);
+        req.option.T = take<double>(p);
+        req.target = take<double>(p);
+        req.steps = take<std::int32_t>(p);
+        const std::uint8_t engine = take<std::uint8_t>(p);
+        const std::uint8_t type = take<std::uint8_t>(p);
+        const std::uint8_t exercise = take<std::uint8_t>(p);
+        if (engine >= request_engine_count || type > 1 || exercise > 1) {
+            throw std::runtime_error("Corrupt request capture record.");
+        }
+        req.engine = static_cast<RequestEngine>(engine);
+        req.option.type = static_cast<opt::OptionType>(type);
+        req.option.exercise = static_cast<opt::Exercise>(exercise);
+        return req;
+    }
+
+    std::vector<Request> RequestLog::read(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("Cannot open request capture file: " + path);
+        const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.size() < header_size) throw std::runtime_error("Not a request capture file: " + path);
+        check_header(bytes.data(), path);
+        if ((bytes.size() - header_size) % record_size != 0) {
+            throw std::runtime_error("Truncated request capture file: " + path);
+        }
+
+        std::vector<Request> reqs;
+        reqs.reserve((bytes.size() - header_size) / record_size);
+        for (std::size_t off = header_size; off < bytes.size(); off += record_size) {
+            reqs.push_back(decode(bytes.data() + off));
+        }
+        return reqs;
+    }
+
+    double RequestLog::execute(const Request& req) {
+        const TreeParams tp{req.steps};
+        const bool american = req.option.exercise == opt::Exercise::American;
+        switch (req.engine) {
+            case RequestEngine::AnalyticBS:
+                return AnalyticBS::price(req.market, req.option);
+            case RequestEngine::CRR:
+                return american ? BinomialCRR::price_american(req.market, req.option, tp)
+                                : BinomialCRR::price_european(req.market, req.option, tp);
+            case RequestEngine::LeisenReimer:
+                return american ? LeisenReimer::price_american(req.market, req.option, tp)
+                                : LeisenReimer::price_european(req.market, req.option, tp);
+            case RequestEngine::ALO:
+                return AndersenLakeOffengelt::price(req.market, req.option);
+            case RequestEngine::ALOFast:
+                return AndersenLakeOffengelt::price(req.market, req.option, ALOParams::fast());
+            case RequestEngine::BjerksundStensland:
+                return BjerksundStensland::price(req.market, req.option);
+            case RequestEngine::ImpliedVolBS:
+                return ImpliedVol::solve_bs(req.market, req.option, req.target);
+            case RequestEngine::ImpliedVolCRR: {
+                AmericanIVParams ap;
+                ap.steps = req.steps;
+                return ImpliedVol::solve_american(req.market, req.option, req.target, ap).sigma;
+            }
+        }
+        throw std::invalid_argument("Unknown request engine.");
+    }
+
+    const char* RequestLog::engine_name(RequestEngine e) {
+        const int i = static_cast<int>(e);
+        return (i >= 0 && i < request_engine_count) ? ENGINE_NAMES[i] : "unknown";
+    }
+
+    RequestEngine RequestLog::parse_engine(const std::string& name) {
+        for (int i = 0; i < request_engine_count; ++i) {
+            if (name == ENGINE_NAMES[i]) return static_cast<RequestEngine>(i);
+        }
+        throw std::invalid_argument("Unknown engine (use bs|crr|lr|alo|alo-fast|bs02|iv-bs|iv-crr): " + name);
+    }
+
+    RequestRecorder::RequestRecorder(const std::string& path) {
+        // An existing capture is appended to, so one file can collect many CLI runs
+        std::size_t existing = 0;
+        {
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (in) existing = static_cast<std::size_t>(in.tellg());
+            if (existing > 0) {
+                unsigned char header[RequestLog::header_size] = {};
+                in.seekg(0);
+                in.read(reinterpret_cast<char*>(header), sizeof(header));
+                if (!in) throw std::runtime_error("Not a request capture file: " + path);
+                check_header(header, path);
+            }
+        }
+        out_.open(path, std::ios::binary | std::ios::app);
+        if (!out_) throw std::runtime_error("Cannot open request capture file for writing: " + path);
+        if (existing == 0) {
+            unsigned char header[RequestLog::header_size];
+            encode_header(header);
+            out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+        }
+    }
+
+    void RequestRecorder::record(Request req) {
+        req.t_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        unsigned char rec[RequestLog::record_size];
+        RequestLog::encode(req, rec);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_.write(reinterpret_cast<const char*>(rec), sizeof(rec));
+        out_.flush();
+        if (!out_) throw std::runtime_error("Failed writing request capture file.");
+        ++recorded_;
+    }
+
+} // namespace pricers
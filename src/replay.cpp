@@ -0,0 +1,91 @@
+// replay.cpp: optreplay, replays an optcli --record capture and reports per-engine latency
+#include "pricers/Replay.hpp"
+#include "pricers/RequestLog.hpp"
+#include "util/Args.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void print_usage() {
+    std::cout <<
+    R"(Usage:
+    optreplay --in <capture.bin> [--speed <x>] [--workers <n>] [--loops <n>] [--out <report.csv>]
+
+    Examples:
+    optreplay --in capture.bin                      original timing, in-process
+    optreplay --in capture.bin --speed 10           ten times faster
+    optreplay --in capture.bin --speed 0 --workers 4 --loops 20
+
+    Notes:
+    - --speed divides the captured gaps between requests (default 1); 0 replays flat-out.
+    - --workers 0 (default) runs every request on the calling thread. n > 0 runs a daemon
+      stand-in: n worker threads serving one FIFO queue of arrivals.
+    - --loops repeats the capture back to back, each pass shifted past the last one.
+    - Latency runs from a request's arrival to its completion, so it includes time spent
+      queued behind earlier requests. The report is printed as a table, or written as CSV
+      with --out.
+    )";
+}
+
+int main(int argc, char** argv) {
+    try {
+        const util::Args args(argc, argv, {"--help"});
+        if (argc == 1 || args.has("--help")) {
+            print_usage();
+            return 0;
+        }
+
+        const std::string path = args.get_str("--in");
+        const std::vector<pricers::Request> capture = pricers::RequestLog::read(path);
+        const int loops = args.get_int("--loops", 1);
+        if (loops <= 0) throw std::invalid_argument("--loops must be positive.");
+
+        std::vector<pricers::Request> reqs;
+        reqs.reserve(capture.size() * loops);
+        const std::int64_t span = capture.empty() ? 0 : capture.back().t_ns - capture.front().t_ns + 1;
+        for (int l = 0; l < loops; ++l) {
+            for (pricers::Request req : capture) {
+                req.t_ns += l * span;
+                reqs.push_back(req);
+            }
+        }
+
+        pricers::ReplayParams p;
+        p.speed = args.get_double("--speed", 1.0);
+        p.workers = static_cast<unsigned>(args.get_int("--workers", 0));
+        const pricers::ReplayResult res = pricers::Replay::run(reqs, p);
+
+        if (args.has("--out")) {
+            const std::string out_path = args.get_str("--out");
+            std::ofstream out(out_path);
+            if (!out) throw std::invalid_argument("Cannot open output file: " + out_path);
+            out << pricers::Replay::to_csv(res);
+            std::cerr << "Wrote report for " << reqs.size() << " requests to " << out_path << "\n";
+            return 0;
+        }
+
+        std::cout << "Replayed " << reqs.size() << " requests from " << path << " in "
+                  << std::fixed << std::setprecision(3) << res.seconds << " s\n\n";
+        std::cout << std::left << std::setw(8) << "engine" << std::right
+                  << std::setw(9) << "count" << std::setw(8) << "failed" << std::setw(12) << "req/s"
+                  << std::setw(11) << "mean us" << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+                  << std::setw(11) << "p99 us" << std::setw(11) << "max us" << "\n";
+        auto row = [](const char* name, const pricers::ReplayEngineStats& s) {
+            std::cout << std::left << std::setw(8) << name << std::right << std::setprecision(1)
+                      << std::setw(9) << s.count << std::setw(8) << s.failed << std::setw(12) << s.throughput
+                      << std::setw(11) << s.mean_us << std::setw(11) << s.p50_us << std::setw(11) << s.p90_us
+                      << std::setw(11) << s.p99_us << std::setw(11) << s.max_us << "\n";
+        };
+        for (const pricers::ReplayEngineStats& s : res.engines) row(pricers::RequestLog::engine_name(s.engine), s);
+        row("all", res.all);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "[error] " << e.what() << "\n\n";
+        print_usage();
+        return 1;
+    }
+}
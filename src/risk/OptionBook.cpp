@@ -0,0 +1,172 @@
+// OptionBook.cpp: European contracts in SoA form, repriced incrementally on spot/vol ticks
+#include "risk/OptionBook.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace risk {
+
+    OptionBook::OptionBook(bool with_greeks) : with_greeks_(with_greeks) {}
+
+    std::size_t OptionBook::add(const std::string& underlying, const opt::Market& m, const opt::Option& o) {
+        if (m.S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        if (o.K <= 0.0) throw std::invalid_argument("Strike Price must be positive.");
+        if (o.T <= 0.0) throw std::invalid_argument("Time to Maturity must be positive.");
+        if (m.sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        if (o.exercise != opt::Exercise::European) throw std::invalid_argument("OptionBook only supports European Options.");
+
+        auto it = underlying_ids_.find(underlying);
+        if (it == underlying_ids_.end()) {
+            it = underlying_ids_.emplace(underlying, blocks_.size()).first;
+            blocks_.emplace_back();
+            blocks_.back().S0 = m.S0;
+            blocks_.back().lnS = std::log(m.S0);
+        } else if (m.S0 != blocks_[it->second].S0) {
+            throw std::invalid_argument("Spot Price disagrees with the book's spot for this underlying.");
+        }
+
+        Block& b = blocks_[it->second];
+        const std::size_t row = row_block_.size();
+        const std::size_t slot = b.rows.size();
+        row_block_.push_back(it->second);
+        row_slot_.push_back(slot);
+        is_dirty_.push_back(0);
+
+        b.rows.push_back(row);
+        b.K.push_back(o.K);
+        b.T.push_back(o.T);
+        b.r.push_back(m.r);
+        b.q.push_back(m.q);
+        b.w.push_back(o.type == opt::OptionType::Call ? 1.0 : -1.0);
+        b.lnK.push_back(std::log(o.K));
+        b.sqrtT.push_back(std::sqrt(o.T));
+        b.KDr.push_back(o.K * std::exp(-m.r * o.T));
+        b.Dq.push_back(std::exp(-m.q * o.T));
+        b.sigma.push_back(0.0);
+        b.sig_sqrtT.push_back(0.0);
+        b.shift.push_back(0.0);
+        for (auto* out : {&b.price, &b.delta, &b.gamma, &b.vega, &b.theta, &b.rho}) out->push_back(0.0);
+
+        set_vol(b, slot, m.sigma);
+        reprice(b, slot, slot + 1);
+        return row;
+    }
+
+    std::size_t OptionBook::underlying_id(const std::string& underlying) const {
+        const auto it = underlying_ids_.find(underlying);
+        if (it == underlying_ids_.end()) throw std::invalid_argument("Unknown underlying: " + underlying);
+        return it->second;
+    }
+
+    std::size_t OptionBook::on_spot(std::size_t underlying, double S0) {
+        if (underlying >= blocks_.size()) throw std::out_of_range("Underlying id out of range.");
+        if (S0 <= 0.0) throw std::invalid_argument("Spot Price must be positive.");
+        Block& b = blocks_[underlying];
+        b.S0 = S0;
+        b.lnS = std::log(S0);
+        reprice(b, 0, b.rows.size());
+        return b.rows.size();
+    }
+
+    std::size_t OptionBook::on_spot(const std::string& underlying, double S0) {
+        return on_spot(underlying_id(underlying), S0);
+    }
+
+    std::size_t OptionBook::on_vol(std::size_t underlying, double sigma) {
+        if (underlying >= blocks_.size()) throw std::out_of_range("Underlying id out of range.");
+        if (sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        Block& b = blocks_[underlying];
+        for (std::size_t i = 0; i < b.rows.size(); ++i) set_vol(b, i, sigma);
+        reprice(b, 0, b.rows.size());
+        return b.rows.size();
+    }
+
+    std::size_t OptionBook::on_vol(const std::string& underlying, double sigma) {
+        return on_vol(underlying_id(underlying), sigma);
+    }
+
+    std::size_t OptionBook::on_row_vol(std::size_t row, double sigma) {
+        check_row(row);
+        if (sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+        Block& b = blocks_[row_block_[row]];
+        const std::size_t slot = row_slot_[row];
+        set_vol(b, slot, sigma);
+        reprice(b, slot, slot + 1);
+        return 1;
+    }
+
+    double OptionBook::spot(std::size_t underlying) const {
+        if (underlying >= blocks_.size()) throw std::out_of_range("Underlying id out of range.");
+        return blocks_[underlying].S0;
+    }
+
+    double OptionBook::price(std::size_t row) const {
+        check_row(row);
+        return blocks_[row_block_[row]].price[row_slot_[row]];
+    }
+
+    pricers::Greeks OptionBook::greeks(std::size_t row) const {
+        check_row(row);
+        const Block& b = blocks_[row_block_[row]];
+        const std::size_t i = row_slot_[row];
+        pricers::Greeks g;
+        g.delta = b.delta[i];
+        g.gamma = b.gamma[i];
+        g.vega = b.vega[i];
+        g.theta = b.theta[i];
+        g.rho = b.rho[i];
+        return g;
+    }
+
+    void OptionBook::clear_dirty() {
+        for (std::size_t row : dirty_) is_dirty_[row] = 0;
+        dirty_.clear();
+    }
+
+    void OptionBook::set_vol(Block& b, std::size_t i, double sigma) {
+        b.sigma[i] = sigma;
+        b.sig_sqrtT[i] = sigma * b.sqrtT[i];
+        b.shift[i] = (b.r[i] - b.q[i] + 0.5 * sigma * sigma) * b.T[i] - b.lnK[i];
+    }
+
+    // Minimal BS kernel over slots [begin, end): w = +1 call, -1 put
+    //   V = w (S Dq N(w d1) - K Dr N(w d2))
+    void OptionBook::reprice(Block& b, std::size_t begin, std::size_t end) {
+        const double S = b.S0;
+        const double lnS = b.lnS;
+        for (std::size_t i = begin; i < end; ++i) {
+            const double w = b.w[i];
+            const double d1 = (lnS + b.shift[i]) / b.sig_sqrtT[i];
+            const double d2 = d1 - b.sig_sqrtT[i];
+            const double SDq = S * b.Dq[i];
+            const double Nd1 = util::normal_cdf(w * d1);
+            const double Nd2 = util::normal_cdf(w * d2);
+            b.price[i] = w * (SDq * Nd1 - b.KDr[i] * Nd2);
+
+            if (with_greeks_) {
+                const double nd1 = util::normal_pdf(d1);
+                b.delta[i] = w * b.Dq[i] * Nd1;
+                b.gamma[i] = b.Dq[i] * nd1 / (S * b.sig_sqrtT[i]);
+                b.vega[i] = SDq * nd1 * b.sqrtT[i];
+                b.rho[i] = w * b.KDr[i] * b.T[i] * Nd2;
+                b.theta[i] = -SDq * nd1 * b.sigma[i] / (2.0 * b.sqrtT[i])
+                           - w * b.r[i] * b.KDr[i] * Nd2 + w * b.q[i] * SDq * Nd1;
+            }
+        }
+        for (std::size_t i = begin; i < end; ++i) mark_dirty(b.rows[i]);
+    }
+
+    void OptionBook::mark_dirty(std::size_t row) {
+        if (!is_dirty_[row]) {
+            is_dirty_[row] = 1;
+            dirty_.push_back(row);
+        }
+    }
+
+    void OptionBook::check_row(std::size_t row) const {
+        if (row >= row_block_.size()) throw std::out_of_range("Row out of range.");
+    }
+
+} // namespace risk
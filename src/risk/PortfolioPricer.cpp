@@ -0,0 +1,146 @@
+// PortfolioPricer.cpp: Book pricing that prices each distinct contract once and scatters to positions
+#include "risk/PortfolioPricer.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "util/Parallel.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace risk {
+
+    namespace {
+        struct ContractKey {
+            std::uint64_t bits[6] = {}; // S0, r, q, sigma, K, T
+            std::int8_t type = 0;
+            std::int8_t exercise = 0;
+
+            bool operator==(const ContractKey& o) const {
+                return std::memcmp(bits, o.bits, sizeof(bits)) == 0 && type == o.type && exercise == o.exercise;
+            }
+        };
+
+        // splitmix64 finaliser, folded over the fields
+        std::uint64_t mix(std::uint64_t x) {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+
+        struct ContractKeyHash {
+            std::size_t operator()(const ContractKey& k) const {
+                std::uint64_t h = mix(static_cast<std::uint64_t>(k.type) << 8 | static_cast<std::uint64_t>(k.exercise));
+                for (std::uint64_t b : k.bits) h = mix(h ^ b);
+                return static_cast<std::size_t>(h);
+            }
+        };
+
+        // -0.0 and 0.0 price identically; key them the same
+        std::uint64_t canonical_bits(double x) {
+            if (x == 0.0) x = 0.0;
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof(b));
+            return b;
+        }
+
+        struct Contract {
+            opt::Market market;
+            opt::Option option;
+        };
+
+        Contract canonicalize(const Position& pos, bool merge_american_calls) {
+            Contract c{pos.market, pos.option};
+            if (merge_american_calls && c.option.exercise == opt::Exercise::American &&
+                c.option.type == opt::OptionType::Call && c.market.q <= 0.0 && c.market.r >= 0.0) {
+                c.option.exercise = opt::Exercise::European;
+            }
+            return c;
+        }
+
+        ContractKey make_key(const Contract& c) {
+            ContractKey k;
+            const double fields[6] = {c.market.S0, c.market.r, c.market.q, c.market.sigma, c.option.K, c.option.T};
+            for (int i = 0; i < 6; ++i) k.bits[i] = canonical_bits(fields[i]);
+            k.type = static_cast<std::int8_t>(c.option.type);
+            k.exercise = static_cast<std::int8_t>(c.option.exercise);
+            return k;
+        }
+    } // namespace
+
+    PortfolioPricer::PortfolioPricer(const PortfolioParams& p) : params_(p) {
+        if (params_.tree_steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+        if (params_.with_greeks && params_.tree_steps < 2) throw std::invalid_argument("Tree gamma and theta need at least 2 steps.");
+    }
+
+    PortfolioResult PortfolioPricer::price(const std::vector<Position>& book) const {
+        PortfolioResult res;
+        res.contract.resize(book.size());
+
+        // Group positions by canonical contract
+        std::vector<Contract> unique;
+        std::unordered_map<ContractKey, std::size_t, ContractKeyHash> index;
+        index.reserve(book.size());
+        for (std::size_t p = 0; p < book.size(); ++p) {
+            const Contract c = canonicalize(book[p], params_.merge_american_calls);
+            auto it = index.emplace(make_key(c), unique.size());
+            if (it.second) unique.push_back(c);
+            res.contract[p] = it.first->second;
+        }
+        res.unique_contracts = unique.size();
+
+        // American trees first so the long jobs are not left for the end of the loop
+        std::vector<std::size_t> order;
+        order.reserve(unique.size());
+        for (std::size_t u = 0; u < unique.size(); ++u) {
+            if (unique[u].option.exercise == opt::Exercise::American) order.push_back(u);
+        }
+        for (std::size_t u = 0; u < unique.size(); ++u) {
+            if (unique[u].option.exercise != opt::Exercise::American) order.push_back(u);
+        }
+
+        std::vector<double> price(unique.size());
+        std::vector<pricers::Greeks> greeks(params_.with_greeks ? unique.size() : 0);
+        const pricers::TreeParams tp{params_.tree_steps};
+        util::parallel_for(order.size(), [&](std::size_t i) {
+            const std::size_t u = order[i];
+            const opt::Market& m = unique[u].market;
+            const opt::Option& o = unique[u].option;
+            if (o.exercise == opt::Exercise::European) {
+                price[u] = pricers::AnalyticBS::price(m, o);
+                if (params_.with_greeks) greeks[u] = pricers::AnalyticBS::greeks(m, o);
+            } else if (params_.with_greeks) {
+                // The adjoint sweep prices the tree on its way (gamma and theta from its step-2
+                // nodes); no separate pricing pass
+                const pricers::AdjointGreeks a = pricers::BinomialAAD::greeks(m, o, tp);
+                price[u] = a.price;
+                greeks[u] = pricers::Greeks{a.delta, a.gamma, a.vega, a.theta, a.rho};
+            } else {
+                price[u] = pricers::BinomialCRR::price_american(m, o, tp);
+            }
+        }, params_.threads);
+
+        // Scatter back in book order, accumulating quantity-weighted totals
+        res.price.resize(book.size());
+        if (params_.with_greeks) res.greeks.resize(book.size());
+        for (std::size_t p = 0; p < book.size(); ++p) {
+            const std::size_t u = res.contract[p];
+            const double qty = book[p].quantity;
+            res.price[p] = price[u];
+            res.value += qty * price[u];
+            if (!params_.with_greeks) continue;
+            const pricers::Greeks& g = greeks[u];
+            res.greeks[p] = g;
+            res.total.delta += qty * g.delta;
+            res.total.gamma += qty * g.gamma;
+            res.total.vega += qty * g.vega;
+            res.total.theta += qty * g.theta;
+            res.total.rho += qty * g.rho;
+        }
+        return res;
+    }
+
+} // namespace risk
@@ -0,0 +1,170 @@
+// ScenarioEngine.cpp: Spot/vol scenario grid P&L with work shared across grid cells
+#include "risk/ScenarioEngine.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_set>
+
+namespace risk {
+
+    ScenarioEngine::ScenarioEngine(const ShockGrid& grid, const ScenarioParams& p)
+        : grid_(grid), params_(p) {
+        check_grid(grid_);
+        if (params_.tree_steps <= 0) throw std::invalid_argument("Number of steps must be positive.");
+    }
+
+    void ScenarioEngine::check_grid(const ShockGrid& grid) {
+        if (grid.spot_shocks.empty() || grid.vol_shocks.empty()) {
+            throw std::invalid_argument("Shock grid must have at least one spot and one vol shock.");
+        }
+        for (double s : grid.spot_shocks) {
+            if (s <= -1.0) throw std::invalid_argument("Spot shock must be greater than -100%.");
+        }
+    }
+
+    bool ScenarioEngine::same_contract(const Entry& e, const Position& pos) {
+        const opt::Market& a = e.market;
+        const opt::Market& b = pos.market;
+        const opt::Option& x = e.option;
+        const opt::Option& y = pos.option;
+        return a.S0 == b.S0 && a.r == b.r && a.q == b.q && a.sigma == b.sigma
+            && x.K == y.K && x.T == y.T && x.type == y.type && x.exercise == y.exercise;
+    }
+
+    // European: strike/maturity terms are computed once per vol shock, only ln(S) moves with spot
+    void ScenarioEngine::bs_scenarios(const opt::Market& m, const opt::Option& o, double* out) const {
+        const double base = pricers::AnalyticBS::price(m, o);
+
+        const double T = o.T;
+        const double sqrtT = std::sqrt(T);
+        const double lnK = std::log(o.K);
+        const double KDr = o.K * std::exp(-m.r * T);
+        const double Dq = std::exp(-m.q * T);
+        const bool is_call = (o.type == opt::OptionType::Call);
+
+        const std::size_t ns = grid_.spot_shocks.size();
+        std::vector<double> lnS(ns), SDq(ns);
+        for (std::size_t j = 0; j < ns; ++j) {
+            const double S = m.S0 * (1.0 + grid_.spot_shocks[j]);
+            lnS[j] = std::log(S);
+            SDq[j] = S * Dq;
+        }
+
+        for (std::size_t v = 0; v < grid_.vol_shocks.size(); ++v) {
+            const double sig = m.sigma + grid_.vol_shocks[v];
+            if (sig <= 0.0) throw std::invalid_argument("Vol shock produces non-positive volatility.");
+
+            const double volSqrtT = sig * sqrtT;
+            const double inv_volSqrtT = 1.0 / volSqrtT;
+            const double shift = -lnK + (m.r - m.q + 0.5 * sig * sig) * T;
+
+            double* row = out + v * ns;
+            for (std::size_t j = 0; j < ns; ++j) {
+                const double d1 = (lnS[j] + shift) * inv_volSqrtT;
+                const double d2 = d1 - volSqrtT;
+                const double px = is_call ? SDq[j] * util::normal_cdf(d1) - KDr * util::normal_cdf(d2)
+                                          : KDr * util::normal_cdf(-d2) - SDq[j] * util::normal_cdf(-d1);
+                row[j] = px - base;
+            }
+        }
+    }
+
+    // American: one widened CRR tree per vol shock. Rooting an (N + 2J)-step tree at S0 with
+    // the same dt, its step-2J layer holds exact N-step tree prices for spots S0 * u^(2j),
+    // j = -J..J; shocked spots are read off that ladder by quadratic interpolation in log-spot.
+    // The rollback is BinomialCRR's own induction, so the ladder cannot drift from
+    // price_american.
+    void ScenarioEngine::tree_scenarios(const opt::Market& m, const opt::Option& o, double* out) const {
+        pricers::TreeParams tp;
+        tp.steps = params_.tree_steps;
+        const double base = pricers::BinomialCRR::price_american(m, o, tp);
+
+        const int N = params_.tree_steps;
+        const double dt = o.T / N;
+        const std::size_t ns = grid_.spot_shocks.size();
+
+        std::vector<double> x(ns);
+        double xmax = 0.0;
+        for (std::size_t j = 0; j < ns; ++j) {
+            x[j] = std::log1p(grid_.spot_shocks[j]);
+            xmax = std::max(xmax, std::fabs(x[j]));
+        }
+
+        std::vector<double> values;
+        for (std::size_t v = 0; v < grid_.vol_shocks.size(); ++v) {
+            opt::Market shocked = m;
+            shocked.sigma = m.sigma + grid_.vol_shocks[v];
+            if (shocked.sigma <= 0.0) throw std::invalid_argument("Vol shock produces non-positive volatility.");
+            const double a = shocked.sigma * std::sqrt(dt);
+
+            // Ladder spacing in log-spot is 2a; one spare node on each side for interpolation
+            const int J = static_cast<int>(std::ceil(xmax / (2.0 * a))) + 1;
+            opt::Option wide = o;
+            wide.T = dt * (N + 2 * J);
+            pricers::BinomialCRR::price_american_layer(shocked, wide, pricers::TreeParams{N + 2 * J}, 2 * J, values);
+
+            double* row = out + v * ns;
+            for (std::size_t j = 0; j < ns; ++j) {
+                const double pos = x[j] / (2.0 * a); // ladder coordinate, node k = J + pos
+                int c = static_cast<int>(std::lround(pos));
+                c = std::max(-J + 1, std::min(J - 1, c));
+                const double t = pos - c;
+                const double fm = values[J + c - 1], f0 = values[J + c], fp = values[J + c + 1];
+                const double px = f0 + 0.5 * t * (fp - fm) + 0.5 * t * t * (fp - 2.0 * f0 + fm);
+                row[j] = px - base;
+            }
+        }
+    }
+
+    std::vector<double> ScenarioEngine::unit_pnl(const opt::Market& m, const opt::Option& o) const {
+        std::vector<double> out(grid_.vol_shocks.size() * grid_.spot_shocks.size());
+        if (o.exercise == opt::Exercise::European) bs_scenarios(m, o, out.data());
+        else tree_scenarios(m, o, out.data());
+        return out;
+    }
+
+    const PnLCube& ScenarioEngine::run(const std::vector<Position>& book) {
+        const std::size_t nv = grid_.vol_shocks.size();
+        const std::size_t ns = grid_.spot_shocks.size();
+
+        cube_.n_positions = book.size();
+        cube_.n_vol = nv;
+        cube_.n_spot = ns;
+        cube_.pnl.assign(book.size() * nv * ns, 0.0);
+        stats_ = ScenarioRunStats{};
+
+        std::unordered_set<std::string> seen;
+        seen.reserve(book.size());
+
+        for (std::size_t p = 0; p < book.size(); ++p) {
+            const Position& pos = book[p];
+            if (!seen.insert(pos.id).second) throw std::invalid_argument("Duplicate position id: " + pos.id);
+
+            auto it = cache_.find(pos.id);
+            if (it == cache_.end() || !same_contract(it->second, pos)) {
+                Entry e{pos.market, pos.option, unit_pnl(pos.market, pos.option)};
+                it = cache_.insert_or_assign(pos.id, std::move(e)).first;
+                ++stats_.repriced;
+            } else {
+                ++stats_.reused;
+            }
+
+            const std::vector<double>& unit = it->second.unit_pnl;
+            double* dst = cube_.pnl.data() + p * nv * ns;
+            for (std::size_t k = 0; k < nv * ns; ++k) dst[k] = pos.quantity * unit[k];
+        }
+
+        // Drop positions that left the book
+        for (auto it = cache_.begin(); it != cache_.end();) {
+            if (seen.count(it->first) == 0) it = cache_.erase(it);
+            else ++it;
+        }
+
+        return cube_;
+    }
+
+} // namespace risk
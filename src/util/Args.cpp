@@ -0,0 +1,53 @@
+// Args.cpp: Minimal --key value command-line parser shared by the command-line tools
+#include "util/Args.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace util {
+    Args::Args(int argc, char** argv, const std::vector<std::string>& switches) {
+        for (int i = 1; i < argc; ++i) {
+            std::string key = argv[i];
+            if (key.rfind("--", 0) != 0) {
+                throw std::invalid_argument("Expected flag starting with --, got: " + key);
+            }
+            if (std::find(switches.begin(), switches.end(), key) != switches.end()) {
+                kv_[key] = "1";
+                continue;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value after: " + key);
+            kv_[key] = argv[++i];
+        }
+    }
+
+    bool Args::has(const std::string& key) const {
+        return kv_.find(key) != kv_.end();
+    }
+
+    std::string Args::get_str(const std::string& key) const {
+        auto it = kv_.find(key);
+        if (it == kv_.end()) throw std::invalid_argument("Missing required flag: " + key);
+        return it->second;
+    }
+
+    std::string Args::get_str(const std::string& key, const std::string& def) const {
+        auto it = kv_.find(key);
+        return it == kv_.end() ? def : it->second;
+    }
+
+    double Args::get_double(const std::string& key) const {
+        return std::stod(get_str(key));
+    }
+
+    double Args::get_double(const std::string& key, double def) const {
+        return has(key) ? get_double(key) : def;
+    }
+
+    int Args::get_int(const std::string& key) const {
+        return std::stoi(get_str(key));
+    }
+
+    int Args::get_int(const std::string& key, int def) const {
+        return has(key) ? get_int(key) : def;
+    }
+} // namespace util
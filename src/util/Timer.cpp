@@ -0,0 +1,12 @@
+// Timer.cpp: Monotonic wall-clock stopwatch for benchmarks and convergence studies
+#include "util/Timer.hpp"
+
+namespace util {
+    void Timer::reset() {
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    double Timer::seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+} // namespace util
@@ -0,0 +1,160 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/MonteCarloBS.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+static double tree_price(const opt::Market& m, const opt::Option& o, const pricers::TreeParams& tp) {
+    return (o.exercise == opt::Exercise::American) ? pricers::BinomialCRR::price_american(m, o, tp)
+                                                   : pricers::BinomialCRR::price_european(m, o, tp);
+}
+
+// Central finite differences of the tree price, same bump pattern as test_greeks.cpp
+static void check_tree_adjoint_against_fd(const opt::Market& m, const opt::Option& o, int N, bool* ok) {
+    pricers::TreeParams tp;
+    tp.steps = N;
+
+    const auto g = pricers::BinomialAAD::greeks(m, o, tp);
+
+    const double hS = 1e-5 * m.S0;
+    const double hV = 1e-6;
+    const double hR = 1e-6;
+
+    opt::Market s_up = m, s_dn = m;  s_up.S0 += hS;    s_dn.S0 -= hS;
+    opt::Market v_up = m, v_dn = m;  v_up.sigma += hV; v_dn.sigma -= hV;
+    opt::Market r_up = m, r_dn = m;  r_up.r += hR;     r_dn.r -= hR;
+    opt::Market q_up = m, q_dn = m;  q_up.q += hR;     q_dn.q -= hR;
+
+    const double delta_fd = (tree_price(s_up, o, tp) - tree_price(s_dn, o, tp)) / (2.0 * hS);
+    const double vega_fd  = (tree_price(v_up, o, tp) - tree_price(v_dn, o, tp)) / (2.0 * hV);
+    const double rho_fd   = (tree_price(r_up, o, tp) - tree_price(r_dn, o, tp)) / (2.0 * hR);
+    const double rhoq_fd  = (tree_price(q_up, o, tp) - tree_price(q_dn, o, tp)) / (2.0 * hR);
+
+    *ok = std::fabs(g.price - tree_price(m, o, tp)) < 1e-12
+       && std::fabs(g.delta - delta_fd) < 1e-5
+       && std::fabs(g.vega  - vega_fd)  < 1e-3
+       && std::fabs(g.rho   - rho_fd)   < 1e-3
+       && std::fabs(g.rho_q - rhoq_fd)  < 1e-3;
+
+    if (!*ok) {
+        std::cerr << "  AAD  delta=" << g.delta << " vega=" << g.vega << " rho=" << g.rho << " rho_q=" << g.rho_q << "\n"
+                  << "  FD   delta=" << delta_fd << " vega=" << vega_fd << " rho=" << rho_fd << " rho_q=" << rhoq_fd << "\n";
+    }
+}
+
+TEST(test_tree_aad_matches_fd_european_call) {
+    opt::Market m{100.0, 0.03, 0.01, 0.25};
+    opt::Option call{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European};
+    bool ok = false;
+    check_tree_adjoint_against_fd(m, call, 500, &ok);
+    REQUIRE(ok);
+}
+
+TEST(test_tree_aad_matches_fd_american_put) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    bool ok = false;
+    check_tree_adjoint_against_fd(m, put, 500, &ok);
+    REQUIRE(ok);
+}
+
+TEST(test_tree_aad_matches_fd_american_call_with_dividends) {
+    opt::Market m{150.0, 0.01, 0.10, 0.30};
+    opt::Option call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    bool ok = false;
+    check_tree_adjoint_against_fd(m, call, 400, &ok);
+    REQUIRE(ok);
+}
+
+TEST(test_tree_aad_european_close_to_bs_greeks) {
+    opt::Market m{100.0, 0.03, 0.01, 0.25};
+    opt::Option put{105.0, 1.5, opt::OptionType::Put, opt::Exercise::European};
+
+    pricers::TreeParams tp;
+    tp.steps = 2000;
+    const auto g = pricers::BinomialAAD::greeks(m, put, tp);
+    const auto bs = pricers::AnalyticBS::greeks(m, put);
+
+    // Dividend rho from put-call parity: d/dq of -S e^{-qT} N(-d1) = T S e^{-qT} N(-d1)
+    const double rho_q_bs = -put.T * m.S0 * (bs.delta);
+
+    REQUIRE_NEAR(g.delta, bs.delta, 2e-3);
+    REQUIRE_NEAR(g.vega,  bs.vega,  5e-2);
+    REQUIRE_NEAR(g.rho,   bs.rho,   5e-2);
+    REQUIRE_NEAR(g.rho_q, rho_q_bs, 5e-2);
+
+    // Lattice gamma and theta from the step-2 nodes
+    REQUIRE_NEAR(g.gamma, bs.gamma, 1e-5);
+    REQUIRE_NEAR(g.theta, bs.theta, 5e-3);
+    REQUIRE(std::isnan(pricers::BinomialAAD::greeks(m, put, pricers::TreeParams{1}).gamma));
+}
+
+TEST(test_tree_aad_checkpoint_spacing_is_exact) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    pricers::TreeParams tp;
+    tp.steps = 300;
+
+    pricers::AADParams full;
+    full.checkpoint_every = 1; // every layer stored
+    const auto g1 = pricers::BinomialAAD::greeks(m, put, tp, full);
+
+    for (int C : {0, 7, 64, 300, 1000}) {
+        pricers::AADParams ap;
+        ap.checkpoint_every = C;
+        const auto g = pricers::BinomialAAD::greeks(m, put, tp, ap);
+        REQUIRE(g.price == g1.price);
+        REQUIRE_NEAR(g.delta, g1.delta, 1e-14);
+        REQUIRE_NEAR(g.vega,  g1.vega,  1e-12);
+        REQUIRE_NEAR(g.rho,   g1.rho,   1e-12);
+        REQUIRE_NEAR(g.rho_q, g1.rho_q, 1e-12);
+    }
+}
+
+TEST(test_tree_aad_rejects_truncation) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    pricers::TreeParams tp;
+    tp.steps = 300;
+    tp.truncation_stddevs = 6.0;
+
+    bool threw = false;
+    try {
+        pricers::BinomialAAD::greeks(m, put, tp);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+
+    // Threads and the exercise region are speed settings of the pricer; the adjoint ignores them
+    pricers::TreeParams fast;
+    fast.steps = 300;
+    fast.threads = 4;
+    fast.exercise_region = true;
+    REQUIRE(pricers::BinomialAAD::greeks(m, put, fast).price == pricers::BinomialAAD::greeks(m, put, pricers::TreeParams{300}).price);
+}
+
+TEST(test_mc_adjoint_greeks_match_bs) {
+    opt::Market m{100.0, 0.03, 0.01, 0.25};
+    opt::Option call{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European};
+
+    pricers::MCParams mp;
+    mp.paths = 400000;
+    const auto g = pricers::MonteCarloBS::greeks(m, call, mp);
+    const auto bs = pricers::AnalyticBS::greeks(m, call);
+    const double rho_q_bs = -call.T * m.S0 * bs.delta;
+
+    REQUIRE_NEAR(g.price, pricers::AnalyticBS::price(m, call), 0.05);
+    REQUIRE_NEAR(g.delta, bs.delta, 5e-3);
+    REQUIRE_NEAR(g.vega,  bs.vega,  0.3);
+    REQUIRE_NEAR(g.rho,   bs.rho,   0.3);
+    REQUIRE_NEAR(g.rho_q, rho_q_bs, 0.3);
+}
@@ -4,10 +4,13 @@
 #include "opt/Option.hpp"
 #include "pricers/BinomialCRR.hpp"
 #include "pricers/AnalyticBS.hpp"
+#include "pricers/BjerksundStensland.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
 
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
 
 static double abs_err(double a, double b) { return std::fabs(a - b); }
 
@@ -56,4 +59,151 @@ TEST(test_american_call_greater_than_european_with_dividends) {
 
     REQUIRE(price_amer >= price_euro_analytic - 1e-4);
     REQUIRE(price_amer >= price_euro_tree + 1e-4);
-}
\ No newline at end of file
+}
+
+struct AmericanCase {
+    opt::Market m;
+    opt::Option o;
+    // Converged CRR: truncated lattice (k = 8), each price the mean of N and N + 1 (the tree
+    // swings between even and odd N), Richardson over N = 100000 and 200000. Good to ~1e-5.
+    double ref;
+};
+
+static std::vector<AmericanCase> american_cases() {
+    using opt::OptionType;
+    using opt::Exercise;
+    return {
+        {{100.0, 0.05, 0.02, 0.20}, {105.0, 1.0, OptionType::Put, Exercise::American},  9.37584789},
+        {{150.0, 0.05, 0.02, 0.20}, {100.0, 1.0, OptionType::Put, Exercise::American},  0.12524202},
+        {{100.0, 0.05, 0.00, 0.30}, {100.0, 0.5, OptionType::Put, Exercise::American},  7.39404107},
+        {{ 90.0, 0.08, 0.00, 0.40}, {100.0, 3.0, OptionType::Put, Exercise::American}, 21.81910290},
+        {{100.0, 0.03, 0.07, 0.25}, { 95.0, 2.0, OptionType::Call, Exercise::American}, 12.61309057},
+        {{110.0, 0.02, 0.06, 0.30}, {100.0, 1.0, OptionType::Call, Exercise::American}, 15.87761186},
+    };
+}
+
+TEST(test_alo_matches_high_resolution_tree) {
+    for (const auto& c : american_cases()) {
+        REQUIRE_NEAR(pricers::AndersenLakeOffengelt::price(c.m, c.o), c.ref, 1e-5);
+        REQUIRE_NEAR(pricers::AndersenLakeOffengelt::price(c.m, c.o, pricers::ALOParams::fast()), c.ref, 5e-4);
+    }
+}
+
+TEST(test_alo_converges_with_node_counts) {
+    // Spectral convergence: the default preset should agree with a much finer solve to ~1e-7
+    pricers::ALOParams fine{48, 16, 96, 128};
+    for (const auto& c : american_cases()) {
+        REQUIRE_NEAR(pricers::AndersenLakeOffengelt::price(c.m, c.o),
+                     pricers::AndersenLakeOffengelt::price(c.m, c.o, fine), 1e-7);
+    }
+}
+
+TEST(test_alo_long_dated_high_rate_put_is_stable) {
+    // FP-B loses contraction here; the solver must fall back rather than diverge
+    opt::Market m{100.0, 0.10, 0.00, 0.15};
+    opt::Option put{100.0, 10.0, opt::OptionType::Put, opt::Exercise::American};
+    pricers::ALOParams fine{48, 32, 96, 128};
+
+    const double alo = pricers::AndersenLakeOffengelt::price(m, put);
+    REQUIRE_NEAR(alo, pricers::AndersenLakeOffengelt::price(m, put, fine), 1e-6);
+
+    opt::Option eu = put;
+    eu.exercise = opt::Exercise::European;
+    REQUIRE(alo > pricers::AnalyticBS::price(m, eu));
+    REQUIRE(alo > put.K - m.S0);
+}
+
+TEST(test_bjerksund_stensland_is_close_lower_bound) {
+    for (const auto& c : american_cases()) {
+        const double bs02 = pricers::BjerksundStensland::price(c.m, c.o);
+
+        opt::Option eu = c.o;
+        eu.exercise = opt::Exercise::European;
+        REQUIRE(bs02 >= pricers::AnalyticBS::price(c.m, eu) - 1e-12);
+        REQUIRE(bs02 <= c.ref + 1e-6);
+        REQUIRE(c.ref - bs02 < 0.01 * c.ref + 1e-3);
+    }
+}
+
+TEST(test_american_call_without_dividends_is_european) {
+    opt::Market m{100.0, 0.05, 0.0, 0.25};
+    opt::Option call{110.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    opt::Option eu = call;
+    eu.exercise = opt::Exercise::European;
+
+    const double bs = pricers::AnalyticBS::price(m, eu);
+    REQUIRE_NEAR(pricers::BjerksundStensland::price(m, call), bs, 1e-10);
+    REQUIRE_NEAR(pricers::AndersenLakeOffengelt::price(m, call), bs, 1e-10);
+}
+
+TEST(test_alo_exercise_boundary_shape) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{100.0, 2.0, opt::OptionType::Put, opt::Exercise::American};
+    const std::vector<double> taus{0.0, 0.1, 0.5, 1.0, 2.0};
+
+    const auto bp = pricers::AndersenLakeOffengelt::exercise_boundary(m, put, taus);
+    REQUIRE_NEAR(bp[0], put.K, 1e-12); // B(0) = K min(1, r/q)
+    for (std::size_t i = 1; i < bp.size(); ++i) REQUIRE(bp[i] < bp[i - 1]);
+
+    // Deep below the boundary the put is worth intrinsic
+    opt::Market deep = m;
+    deep.S0 = 0.9 * bp.back();
+    REQUIRE_NEAR(pricers::AndersenLakeOffengelt::price(deep, put), put.K - deep.S0, 1e-12);
+
+    opt::Option call = put;
+    call.type = opt::OptionType::Call;
+    opt::Market carry{100.0, 0.02, 0.05, 0.20};
+    const auto bc = pricers::AndersenLakeOffengelt::exercise_boundary(carry, call, taus);
+    for (std::size_t i = 1; i < bc.size(); ++i) REQUIRE(bc[i] > bc[i - 1]);
+    REQUIRE(bc[0] >= call.K);
+}
+
+TEST(test_fast_american_pricers_reject_european) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option eu{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European};
+    bool threw_bs = false, threw_alo = false;
+    try {
+        pricers::BjerksundStensland::price(m, eu);
+    } catch (const std::invalid_argument&) {
+        threw_bs = true;
+    }
+    try {
+        pricers::AndersenLakeOffengelt::price(m, eu);
+    } catch (const std::invalid_argument&) {
+        threw_alo = true;
+    }
+    REQUIRE(threw_bs);
+    REQUIRE(threw_alo);
+}
+
+TEST(test_american_layer_roots_subtrees) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const pricers::TreeParams tp{400};
+    std::vector<double> layer;
+
+    pricers::BinomialCRR::price_american_layer(m, put, tp, 0, layer);
+    REQUIRE(layer.size() == 1 && layer[0] == pricers::BinomialCRR::price_american(m, put, tp));
+
+    // Node (stop, i) roots a (N - stop)-step tree at S0 u^(2i - stop) with T - stop dt left
+    const int stop = 10;
+    pricers::BinomialCRR::price_american_layer(m, put, tp, stop, layer);
+    REQUIRE(layer.size() == stop + 1);
+    const double dt = put.T / tp.steps;
+    const double u = std::exp(m.sigma * std::sqrt(dt));
+    for (int i : {0, 4, 10}) {
+        opt::Market sub = m;
+        sub.S0 = m.S0 * std::pow(u, 2 * i - stop);
+        opt::Option rest = put;
+        rest.T = put.T - stop * dt;
+        REQUIRE_NEAR(layer[i], pricers::BinomialCRR::price_american(sub, rest, pricers::TreeParams{tp.steps - stop}), 1e-10);
+    }
+
+    bool threw = false;
+    try {
+        pricers::BinomialCRR::price_american_layer(m, put, tp, tp.steps + 1, layer);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
@@ -0,0 +1,204 @@
+#include "test_framework.hpp"
+
+#include "capi/optpricing.h"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+    // Caller-owned SoA columns, as a numpy or ByteBuffer caller would hold them
+    struct Rows {
+        std::vector<double> S0, K, T, r, q, sigma;
+        std::vector<int32_t> type, exercise, steps;
+
+        void add(double s, double k, double t, double rr, double qq, double v, int32_t ty, int32_t ex, int32_t n = 0) {
+            S0.push_back(s); K.push_back(k); T.push_back(t); r.push_back(rr); q.push_back(qq); sigma.push_back(v);
+            type.push_back(ty); exercise.push_back(ex); steps.push_back(n);
+        }
+        std::size_t size() const { return S0.size(); }
+        op_inputs view() const {
+            return op_inputs{S0.data(), K.data(), T.data(), r.data(), q.data(), sigma.data(),
+                             type.data(), exercise.data(), steps.data()};
+        }
+    };
+
+    struct Out {
+        std::vector<double> price, delta, gamma, vega, theta, rho;
+        std::vector<int32_t> status;
+        explicit Out(std::size_t n) : price(n), delta(n), gamma(n), vega(n), theta(n), rho(n), status(n, -1) {}
+        op_outputs view() {
+            return op_outputs{price.data(), delta.data(), gamma.data(), vega.data(), theta.data(), rho.data(), status.data()};
+        }
+    };
+}
+
+TEST(test_capi_matches_cpp_pricers) {
+    Rows rows;
+    rows.add(100.0, 105.0, 1.5, 0.03, 0.01, 0.25, OP_CALL, OP_EUROPEAN);
+    rows.add(100.0, 95.0, 0.5, 0.03, 0.01, 0.25, OP_PUT, OP_EUROPEAN);
+    rows.add(100.0, 105.0, 1.0, 0.05, 0.02, 0.20, OP_PUT, OP_AMERICAN, 500);
+    rows.add(150.0, 100.0, 1.0, 0.01, 0.10, 0.25, OP_CALL, OP_AMERICAN); // context default N
+
+    op_context* ctx = op_context_create();
+    REQUIRE(ctx != nullptr);
+    REQUIRE(op_context_set_tree_steps(ctx, 300) == OP_OK);
+    const op_inputs in = rows.view();
+    Out out(rows.size());
+    op_outputs o = out.view();
+    REQUIRE(op_price(ctx, rows.size(), &in, &o) == OP_OK);
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        const opt::Market m{rows.S0[i], rows.r[i], rows.q[i], rows.sigma[i]};
+        const opt::Option opt{rows.K[i], rows.T[i], rows.type[i] == OP_CALL ? opt::OptionType::Call : opt::OptionType::Put, opt::Exercise::European};
+        const pricers::Greeks g = pricers::AnalyticBS::greeks(m, opt);
+        REQUIRE(out.status[i] == OP_OK);
+        REQUIRE(out.price[i] == pricers::AnalyticBS::price(m, opt));
+        REQUIRE(out.delta[i] == g.delta);
+        REQUIRE(out.gamma[i] == g.gamma);
+        REQUIRE(out.theta[i] == g.theta);
+    }
+
+    const opt::Market m2{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const pricers::TreeParams tp{500};
+    // Price and Greeks from the one adjoint sweep
+    const pricers::AdjointGreeks a = pricers::BinomialAAD::greeks(m2, put, tp);
+    REQUIRE(out.status[2] == OP_OK);
+    REQUIRE(out.price[2] == a.price);
+    REQUIRE_NEAR(out.price[2], pricers::BinomialCRR::price_american(m2, put, tp), 1e-12);
+    REQUIRE(out.delta[2] == a.delta && out.gamma[2] == a.gamma && out.theta[2] == a.theta);
+
+    const opt::Market m3{150.0, 0.01, 0.10, 0.25};
+    const opt::Option call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    REQUIRE_NEAR(out.price[3], pricers::BinomialCRR::price_american(m3, call, pricers::TreeParams{300}), 1e-12);
+
+    // Engine switch; price-only request leaves the other outputs untouched
+    REQUIRE(op_context_set_american_engine(ctx, OP_ENGINE_ALO_ACCURATE) == OP_OK);
+    std::vector<double> price(rows.size());
+    op_outputs price_only{price.data(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+    REQUIRE(op_price(ctx, rows.size(), &in, &price_only) == OP_OK);
+    REQUIRE(price[2] == pricers::AndersenLakeOffengelt::price(m2, put, pricers::ALOParams::accurate()));
+
+    // ALO Greeks are differences of the ALO price, close to a fine tree's (averaged over an
+    // even and an odd N, as the tree's Greeks swing with the strike's place among the nodes)
+    REQUIRE(op_price(ctx, rows.size(), &in, &o) == OP_OK);
+    const pricers::AdjointGreeks even = pricers::BinomialAAD::greeks(m2, put, pricers::TreeParams{4000});
+    const pricers::AdjointGreeks odd = pricers::BinomialAAD::greeks(m2, put, pricers::TreeParams{4001});
+    REQUIRE(out.price[2] == price[2]);
+    REQUIRE_NEAR(out.delta[2], 0.5 * (even.delta + odd.delta), 1e-3);
+    REQUIRE_NEAR(out.gamma[2], 0.5 * (even.gamma + odd.gamma), 1e-3);
+    REQUIRE_NEAR(out.vega[2], 0.5 * (even.vega + odd.vega), 2e-2);
+    REQUIRE_NEAR(out.theta[2], 0.5 * (even.theta + odd.theta), 2e-2);
+    REQUIRE_NEAR(out.rho[2], 0.5 * (even.rho + odd.rho), 2e-2);
+    op_context_destroy(ctx);
+}
+
+TEST(test_capi_truncated_tree_greeks_unsupported) {
+    Rows rows;
+    rows.add(100.0, 105.0, 1.0, 0.05, 0.02, 0.20, OP_PUT, OP_AMERICAN, 500);
+    rows.add(100.0, 105.0, 1.0, 0.05, 0.02, 0.20, OP_PUT, OP_EUROPEAN);
+
+    op_context* ctx = op_context_create();
+    REQUIRE(op_context_set_truncation(ctx, 6.0) == OP_OK);
+    const op_inputs in = rows.view();
+    Out out(rows.size());
+    op_outputs o = out.view();
+    REQUIRE(op_price(ctx, rows.size(), &in, &o) == OP_ERR_ROWS_FAILED);
+    REQUIRE(out.status[0] == OP_ERR_UNSUPPORTED && std::isnan(out.price[0]));
+    REQUIRE(out.status[1] == OP_OK);
+    REQUIRE(std::string(op_status_string(OP_ERR_UNSUPPORTED)) == "not supported by the engine");
+
+    // The truncated price alone is fine
+    pricers::TreeParams tp{500};
+    tp.truncation_stddevs = 6.0;
+    op_outputs price_only{out.price.data(), nullptr, nullptr, nullptr, nullptr, nullptr, out.status.data()};
+    REQUIRE(op_price(ctx, rows.size(), &in, &price_only) == OP_OK);
+    REQUIRE(out.price[0] == pricers::BinomialCRR::price_american(opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American}, tp));
+    op_context_destroy(ctx);
+}
+
+TEST(test_capi_threads_and_row_failures) {
+    Rows rows;
+    for (int i = 0; i < 5000; ++i) {
+        rows.add(100.0, 60.0 + 0.02 * i, 0.1 + 0.0004 * i, 0.03, 0.01, 0.15 + 0.00005 * i,
+                 (i % 2) ? OP_PUT : OP_CALL, (i % 50 == 0) ? OP_AMERICAN : OP_EUROPEAN, 100);
+    }
+    rows.K[17] = -1.0;   // invalid strike
+    rows.type[99] = 7;   // unknown option type
+
+    op_context* ctx = op_context_create();
+    const op_inputs in = rows.view();
+    Out serial(rows.size()), par(rows.size());
+    op_outputs os = serial.view(), op = par.view();
+    REQUIRE(op_price(ctx, rows.size(), &in, &os) == OP_ERR_ROWS_FAILED);
+    REQUIRE(op_context_set_threads(ctx, 4) == OP_OK);
+    REQUIRE(op_price(ctx, rows.size(), &in, &op) == OP_ERR_ROWS_FAILED);
+
+    REQUIRE(serial.status[17] == OP_ERR_INVALID_INPUT);
+    REQUIRE(serial.status[99] == OP_ERR_INVALID_INPUT);
+    REQUIRE(std::isnan(serial.price[17]) && std::isnan(serial.delta[99]));
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        REQUIRE(par.status[i] == serial.status[i]);
+        if (serial.status[i] == OP_OK) {
+            REQUIRE(par.price[i] == serial.price[i]);
+            REQUIRE(par.vega[i] == serial.vega[i]);
+        }
+    }
+    op_context_destroy(ctx);
+}
+
+TEST(test_capi_implied_vol_round_trip) {
+    Rows rows;
+    rows.add(100.0, 105.0, 1.5, 0.03, 0.01, 0.25, OP_CALL, OP_EUROPEAN);
+    rows.add(100.0, 105.0, 1.0, 0.05, 0.02, 0.20, OP_PUT, OP_AMERICAN, 400);
+    rows.add(100.0, 105.0, 1.0, 0.05, 0.02, 0.20, OP_PUT, OP_EUROPEAN);
+
+    op_context* ctx = op_context_create();
+    REQUIRE(op_context_set_iv_tolerance(ctx, 1e-10) == OP_OK);
+    const op_inputs in = rows.view();
+    std::vector<double> price(rows.size()), iv(rows.size());
+    op_outputs o{price.data(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+    REQUIRE(op_price(ctx, rows.size(), &in, &o) == OP_OK);
+    price[2] = 0.0; // below intrinsic: no implied vol
+
+    std::vector<int32_t> status(rows.size());
+    REQUIRE(op_implied_vol(ctx, rows.size(), &in, price.data(), iv.data(), status.data()) == OP_ERR_ROWS_FAILED);
+    REQUIRE(status[0] == OP_OK && status[1] == OP_OK);
+    REQUIRE_NEAR(iv[0], 0.25, 1e-8);
+    REQUIRE_NEAR(iv[1], 0.20, 1e-6);
+    REQUIRE(status[2] == OP_ERR_INVALID_INPUT && std::isnan(iv[2]));
+    op_context_destroy(ctx);
+}
+
+TEST(test_capi_rejects_null_and_bad_settings) {
+    op_context* ctx = op_context_create();
+    Rows rows;
+    rows.add(100.0, 100.0, 1.0, 0.0, 0.0, 0.2, OP_CALL, OP_EUROPEAN);
+    op_inputs in = rows.view();
+    Out out(1);
+    op_outputs o = out.view();
+
+    REQUIRE(op_price(nullptr, 1, &in, &o) == OP_ERR_NULL_ARGUMENT);
+    REQUIRE(op_price(ctx, 1, nullptr, &o) == OP_ERR_NULL_ARGUMENT);
+    in.sigma = nullptr;
+    REQUIRE(op_price(ctx, 1, &in, &o) == OP_ERR_NULL_ARGUMENT);
+    REQUIRE(out.status[0] == -1); // call-level errors write nothing
+    REQUIRE(op_price(ctx, 0, &in, &o) == OP_OK);
+
+    REQUIRE(op_context_set_tree_steps(ctx, 0) == OP_ERR_INVALID_INPUT);
+    REQUIRE(op_context_set_truncation(ctx, -1.0) == OP_ERR_INVALID_INPUT);
+    REQUIRE(op_context_set_american_engine(ctx, 9) == OP_ERR_INVALID_INPUT);
+    REQUIRE(op_context_set_iv_tolerance(ctx, 0.0) == OP_ERR_INVALID_INPUT);
+    REQUIRE(op_context_set_threads(nullptr, 2) == OP_ERR_NULL_ARGUMENT);
+    REQUIRE(op_abi_version() == OP_ABI_VERSION);
+    op_context_destroy(ctx);
+    op_context_destroy(nullptr);
+}
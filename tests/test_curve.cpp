@@ -0,0 +1,178 @@
+#include "test_framework.hpp"
+
+#include "opt/Curve.hpp"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+static opt::Curve rising_rates(opt::CurveInterp interp) {
+    return opt::Curve({0.5, 1.0, 2.0}, {0.01, 0.03, 0.06}, interp);
+}
+
+TEST(test_curve_integrals) {
+    const opt::Curve flat(0.04);
+    REQUIRE(flat.flat());
+    REQUIRE_NEAR(flat.integral(2.5), 0.1, 1e-15);
+    REQUIRE_NEAR(flat.discount(2.5), std::exp(-0.1), 1e-15);
+
+    // Piecewise flat: r = 1% on (0, 0.5], 3% on (0.5, 1], 6% on (1, 2] and beyond
+    const opt::Curve pf = rising_rates(opt::CurveInterp::PiecewiseFlat);
+    REQUIRE_NEAR(pf.integral(0.25), 0.0025, 1e-15);
+    REQUIRE_NEAR(pf.integral(0.75), 0.005 + 0.0075, 1e-15);
+    REQUIRE_NEAR(pf.integral(3.0), 0.005 + 0.015 + 0.06 + 0.06, 1e-15);
+    REQUIRE(pf.rate(0.5) == 0.01);
+    REQUIRE(pf.rate(0.5000001) == 0.03);
+    REQUIRE_NEAR(pf.zero_rate(2.0), 0.08 / 2.0, 1e-15);
+
+    // Piecewise linear: trapezoids between knots, flat outside
+    const opt::Curve pl = rising_rates(opt::CurveInterp::PiecewiseLinear);
+    REQUIRE_NEAR(pl.rate(0.75), 0.02, 1e-15);
+    REQUIRE_NEAR(pl.integral(0.75), 0.005 + 0.25 * 0.015, 1e-15);
+    REQUIRE_NEAR(pl.integral(2.0), 0.005 + 0.01 + 0.045, 1e-15);
+    REQUIRE_NEAR(pl.integral(2.5), 0.06 + 0.03, 1e-15);
+
+    // Batch lookup is the scalar lookup
+    std::vector<double> T, D(200), I(200);
+    for (int i = 0; i < 200; ++i) T.push_back(0.0125 * i);
+    pl.discount_batch(T.size(), T.data(), D.data());
+    pl.integral_batch(T.size(), T.data(), I.data());
+    for (std::size_t i = 0; i < T.size(); ++i) {
+        REQUIRE(I[i] == pl.integral(T[i]));
+        REQUIRE(D[i] == pl.discount(T[i]));
+    }
+}
+
+TEST(test_curve_bs_uses_integrated_rates) {
+    const opt::Curve r = rising_rates(opt::CurveInterp::PiecewiseLinear);
+    const opt::Curve q({1.0, 3.0}, {0.02, 0.0});
+    for (double T : {0.3, 1.0, 2.5}) {
+        for (auto type : {opt::OptionType::Call, opt::OptionType::Put}) {
+            const opt::Option o{105.0, T, type, opt::Exercise::European};
+            // A European price depends on the rates only through their integrals to expiry
+            const opt::Market flat{100.0, r.zero_rate(T), q.zero_rate(T), 0.25};
+            REQUIRE_NEAR(pricers::AnalyticBS::price(flat, o, r, q), pricers::AnalyticBS::price(flat, o), 1e-12);
+            REQUIRE_NEAR(pricers::AnalyticBS::price(flat, o, opt::Curve(flat.r), opt::Curve(flat.q)),
+                         pricers::AnalyticBS::price(flat, o), 1e-12);
+        }
+    }
+
+    // Batch over curves matches per-contract pricing
+    const std::size_t n = 1000;
+    std::vector<double> S0(n, 100.0), K(n), T(n), sig(n, 0.2), out(n);
+    std::vector<opt::OptionType> type(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        K[i] = 80.0 + 0.04 * i;
+        T[i] = 0.01 + 0.003 * i;
+        type[i] = (i % 3 == 0) ? opt::OptionType::Put : opt::OptionType::Call;
+    }
+    pricers::AnalyticBS::price_batch(n, S0.data(), K.data(), T.data(), r, q, sig.data(), type.data(), out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        const opt::Market m{100.0, 0.0, 0.0, 0.2};
+        REQUIRE_NEAR(out[i], pricers::AnalyticBS::price(m, opt::Option{K[i], T[i], type[i], opt::Exercise::European}, r, q), 1e-12);
+    }
+}
+
+TEST(test_curve_tree_matches_flat_and_converges) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.3};
+    const pricers::TreeParams p{500};
+    const opt::Option eu{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European};
+    const opt::Option am{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const opt::Curve r(m.r), q(m.q);
+
+    // Flat curves reproduce the constant-rate tree
+    REQUIRE_NEAR(pricers::BinomialCRR::price_european(m, eu, p, r, q), pricers::BinomialCRR::price_european(m, eu, p), 1e-10);
+    REQUIRE_NEAR(pricers::BinomialCRR::price_american(m, am, p, r, q), pricers::BinomialCRR::price_american(m, am, p), 1e-10);
+
+    // Term-structure European tree converges to BS on the same curves
+    const opt::Curve rc = rising_rates(opt::CurveInterp::PiecewiseFlat);
+    const opt::Curve qc({0.25, 1.0}, {0.0, 0.03}, opt::CurveInterp::PiecewiseLinear);
+    const pricers::TreeParams fine{2000};
+    for (auto type : {opt::OptionType::Call, opt::OptionType::Put}) {
+        const opt::Option o{95.0, 1.5, type, opt::Exercise::European};
+        REQUIRE_NEAR(pricers::BinomialCRR::price_european(m, o, fine, rc, qc), pricers::AnalyticBS::price(m, o, rc, qc), 2e-3);
+    }
+
+    // A put is worth less at higher rates: the curve price lies between the flat extremes, and
+    // the early exercise premium is non-negative
+    const opt::Market lo{100.0, 0.01, 0.0, 0.3}, hi{100.0, 0.06, 0.0, 0.3};
+    const opt::Curve zero(0.0);
+    const double am_curve = pricers::BinomialCRR::price_american(m, am, p, rc, zero);
+    REQUIRE(am_curve < pricers::BinomialCRR::price_american(lo, am, p));
+    REQUIRE(am_curve > pricers::BinomialCRR::price_american(hi, am, p));
+    REQUIRE(am_curve >= pricers::BinomialCRR::price_european(m, eu, p, rc, zero));
+}
+
+TEST(test_curve_rejects_bad_input) {
+    bool threw_order = false, threw_count = false, threw_time = false;
+    try {
+        opt::Curve c({1.0, 0.5}, {0.01, 0.02});
+    } catch (const std::invalid_argument&) {
+        threw_order = true;
+    }
+    try {
+        opt::Curve c({1.0, 2.0}, {0.01});
+    } catch (const std::invalid_argument&) {
+        threw_count = true;
+    }
+    try {
+        (void)opt::Curve(0.03).integral(-1.0);
+    } catch (const std::invalid_argument&) {
+        threw_time = true;
+    }
+    REQUIRE(threw_order);
+    REQUIRE(threw_count);
+    REQUIRE(threw_time);
+
+    // NaN and infinite times are rejected by every single-maturity lookup
+    const opt::Curve c = rising_rates(opt::CurveInterp::PiecewiseLinear);
+    for (double T : {std::nan(""), std::numeric_limits<double>::infinity()}) {
+        int thrown = 0;
+        try { (void)c.integral(T); } catch (const std::invalid_argument&) { ++thrown; }
+        try { (void)c.discount(T); } catch (const std::invalid_argument&) { ++thrown; }
+        try { (void)c.zero_rate(T); } catch (const std::invalid_argument&) { ++thrown; }
+        try { (void)c.rate(T); } catch (const std::invalid_argument&) { ++thrown; }
+        REQUIRE(thrown == 4);
+    }
+}
+
+TEST(test_curve_clustered_knots) {
+    // 200 knots bunched into the first 1% of a 30-year curve, then one long segment: most
+    // buckets are empty and one holds nearly every knot
+    std::vector<double> t, r;
+    for (int i = 1; i <= 200; ++i) {
+        t.push_back(0.0015 * i);
+        r.push_back(0.01 + 1e-4 * (i % 7));
+    }
+    t.push_back(30.0);
+    r.push_back(0.05);
+    for (auto interp : {opt::CurveInterp::PiecewiseFlat, opt::CurveInterp::PiecewiseLinear}) {
+        const opt::Curve c(t, r, interp);
+        // Every knot, and points between them, against a direct sum over the segments
+        for (int i = 0; i <= 800; ++i) {
+            const double T = (i < 600) ? 0.0005 * i : 0.3 + 0.15 * (i - 600);
+            double I = 0.0, prev_t = 0.0, prev_r = r[0];
+            for (std::size_t k = 0; k < t.size() && prev_t < T; ++k) {
+                const double hi = std::min(T, t[k]);
+                const double h = hi - prev_t;
+                if (interp == opt::CurveInterp::PiecewiseFlat || k == 0) {
+                    I += r[k] * h;
+                } else {
+                    const double slope = (r[k] - prev_r) / (t[k] - prev_t);
+                    I += h * (prev_r + 0.5 * slope * h);
+                }
+                prev_t = t[k];
+                prev_r = r[k];
+            }
+            if (T > t.back()) I += r.back() * (T - t.back());
+            REQUIRE_NEAR(c.integral(T), I, 1e-14);
+            REQUIRE_NEAR(c.discount(T), std::exp(-I), 1e-14);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "test_framework.hpp"
+
+#include "opt/Curve.hpp"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// The region walk and max() agree except where exercise and hold tie to within rounding (deep in
+// the money at r = 0), where either may take a node the other does not
+static bool same_price(double a, double b, double rel) {
+    return std::fabs(a - b) <= rel * std::max(1.0, std::fabs(b));
+}
+
+TEST(test_exercise_region_matches_max_induction) {
+    struct Case { opt::Market m; opt::Option o; };
+    const std::vector<Case> cases{
+        {opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{100.0, 0.05, 0.00, 0.40}, opt::Option{80.0, 2.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{60.0, 0.08, 0.00, 0.15}, opt::Option{100.0, 0.5, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{150.0, 0.01, 0.10, 0.30}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+        {opt::Market{100.0, 0.03, 0.06, 0.25}, opt::Option{110.0, 3.0, opt::OptionType::Call, opt::Exercise::American}},
+        // Never exercised early: the region stays empty
+        {opt::Market{100.0, 0.03, 0.00, 0.25}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+        // r = q = 0: exercise and hold tie deep in the money
+        {opt::Market{100.0, 0.0, 0.0, 0.20}, opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{100.0, 0.0, 0.0, 0.20}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+    };
+
+    for (int N : {1, 2, 7, 500, 1001}) {
+        for (const auto& c : cases) {
+            pricers::TreeParams full{N};
+            pricers::TreeParams region = full;
+            region.exercise_region = true;
+            REQUIRE(same_price(pricers::BinomialCRR::price_american(c.m, c.o, region), pricers::BinomialCRR::price_american(c.m, c.o, full), 1e-13));
+            REQUIRE(same_price(pricers::BinomialCRR::price_american_as<float>(c.m, c.o, region), pricers::BinomialCRR::price_american_as<float>(c.m, c.o, full), 1e-5));
+
+            // Truncated band and rate curves go through the same induction
+            full.truncation_stddevs = region.truncation_stddevs = 6.0;
+            REQUIRE(same_price(pricers::BinomialCRR::price_american(c.m, c.o, region), pricers::BinomialCRR::price_american(c.m, c.o, full), 1e-13));
+            const opt::Curve r({0.5, 1.0, 2.0}, {0.01, 0.03, 0.06}, opt::CurveInterp::PiecewiseLinear);
+            const opt::Curve q(c.m.q);
+            REQUIRE(same_price(pricers::BinomialCRR::price_american(c.m, c.o, region, r, q), pricers::BinomialCRR::price_american(c.m, c.o, full, r, q), 1e-13));
+        }
+    }
+
+    // At r = q = 0 the two inductions differ on many N, but only by rounding
+    for (int N = 51; N <= 1500; N += 7) {
+        for (const auto& c : {cases[6], cases[7]}) {
+            pricers::TreeParams region{N};
+            region.exercise_region = true;
+            REQUIRE(same_price(pricers::BinomialCRR::price_american(c.m, c.o, region), pricers::BinomialCRR::price_american(c.m, c.o, pricers::TreeParams{N}), 1e-13));
+        }
+    }
+}
+
+TEST(test_exercise_region_boundary_tracks_alo) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{100.0, 2.0, opt::OptionType::Put, opt::Exercise::American};
+    const pricers::TreeParams p{2000};
+    pricers::ExerciseBoundary eb;
+    const double price = pricers::BinomialCRR::price_american(m, put, p, eb);
+    REQUIRE(same_price(price, pricers::BinomialCRR::price_american(m, put, p), 1e-13));
+    REQUIRE(eb.t.size() == 2000 && eb.S.size() == 2000);
+
+    // A put boundary rises toward K as expiry nears, and sits within a node spacing of ALO's.
+    // The first steps have too few nodes to reach down to it.
+    REQUIRE(std::isnan(eb.S[0]));
+    const double spacing = std::exp(2.0 * m.sigma * std::sqrt(put.T / p.steps)) - 1.0;
+    for (int k : {500, 1000, 1500, 1990}) {
+        const double alo = pricers::AndersenLakeOffengelt::exercise_boundary(m, put, {put.T - eb.t[k]})[0];
+        REQUIRE(std::fabs(eb.S[k] / alo - 1.0) < spacing);
+    }
+    // Node prices alternate between the two lattice parities, so compare every other step
+    for (std::size_t k = 2; k < eb.S.size(); ++k) {
+        if (!std::isnan(eb.S[k - 2])) REQUIRE(eb.S[k] >= eb.S[k - 2]);
+        REQUIRE(std::isnan(eb.S[k]) || eb.S[k] < put.K);
+    }
+
+    // A call with a dividend yield above the rate is exercised above a boundary that falls
+    // toward K; with q = 0 it is never exercised
+    const opt::Option call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    pricers::BinomialCRR::price_american(opt::Market{100.0, 0.02, 0.05, 0.20}, call, pricers::TreeParams{400}, eb);
+    REQUIRE(std::isnan(eb.S[0]) && eb.S[100] > eb.S[399]);
+    REQUIRE(eb.S[399] > call.K);
+    pricers::BinomialCRR::price_american(opt::Market{100.0, 0.05, 0.0, 0.20}, call, pricers::TreeParams{400}, eb);
+    for (double s : eb.S) REQUIRE(std::isnan(s));
+}
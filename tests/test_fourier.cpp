@@ -0,0 +1,126 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/COSPricer.hpp"
+#include "pricers/CarrMadan.hpp"
+#include "pricers/CharacteristicFunction.hpp"
+#include "util/FFT.hpp"
+#include "util/Math.hpp"
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+// Fang & Oosterlee (2008), Table 4: Heston call, S0 = K = 100, T = 1, r = q = 0
+static const pricers::HestonParams FO_HESTON{0.0175, 1.5768, 0.0398, 0.5751, -0.5711};
+static constexpr double FO_HESTON_CALL = 5.785155450;
+
+static std::vector<double> chain_strikes() {
+    std::vector<double> K;
+    for (int i = 0; i < 200; ++i) K.push_back(60.0 + 0.4 * i);
+    return K;
+}
+
+TEST(test_fft_matches_naive_dft) {
+    const std::size_t n = 64;
+    std::vector<std::complex<double>> x(n);
+    for (std::size_t j = 0; j < n; ++j) x[j] = {std::sin(0.3 * j) + 0.1 * j, std::cos(1.7 * j)};
+
+    std::vector<std::complex<double>> y = x;
+    util::fft(y);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::complex<double> s = 0.0;
+        for (std::size_t j = 0; j < n; ++j) s += x[j] * std::polar(1.0, -2.0 * util::PI * j * k / n);
+        REQUIRE_NEAR(y[k].real(), s.real(), 1e-11);
+        REQUIRE_NEAR(y[k].imag(), s.imag(), 1e-11);
+    }
+    util::fft(y, true);
+    for (std::size_t j = 0; j < n; ++j) REQUIRE_NEAR(std::abs(y[j] - x[j]), 0.0, 1e-13);
+
+    bool threw = false;
+    std::vector<std::complex<double>> bad(12);
+    try {
+        util::fft(bad);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
+
+TEST(test_fourier_bs_matches_analytic) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.25};
+    const double T = 0.75;
+    const pricers::BlackScholesCF cf(m.sigma);
+    const pricers::COSPricer cos(cf, m, T);
+    const auto K = chain_strikes();
+    for (auto type : {opt::OptionType::Call, opt::OptionType::Put}) {
+        const auto cm = pricers::CarrMadan::price_chain(cf, m, T, K, type);
+        const auto cs = cos.price_chain(K, type);
+        for (std::size_t i = 0; i < K.size(); ++i) {
+            const double bs = pricers::AnalyticBS::price(m, opt::Option{K[i], T, type, opt::Exercise::European});
+            REQUIRE_NEAR(cs[i], bs, 1e-10);
+            REQUIRE_NEAR(cm[i], bs, 1e-6);
+        }
+    }
+}
+
+TEST(test_fourier_heston_reference_price) {
+    const pricers::HestonCF cf(FO_HESTON);
+    const opt::Market m{100.0, 0.0, 0.0, 0.0};
+    const pricers::COSPricer cos(cf, m, 1.0);
+    REQUIRE_NEAR(cos.price(100.0, opt::OptionType::Call), FO_HESTON_CALL, 1e-6);
+    const auto cm = pricers::CarrMadan::price_chain(cf, m, 1.0, {100.0}, opt::OptionType::Call);
+    REQUIRE_NEAR(cm[0], FO_HESTON_CALL, 1e-6);
+
+    // The characteristic function is a martingale check: E[S_T / F_T] = phi(-i) = 1
+    const std::complex<double> one = cf(std::complex<double>(0.0, -1.0), 1.0);
+    REQUIRE_NEAR(one.real(), 1.0, 1e-12);
+    REQUIRE_NEAR(one.imag(), 0.0, 1e-12);
+}
+
+TEST(test_fourier_heston_chain_cos_agrees_with_carr_madan) {
+    const pricers::HestonCF cf(FO_HESTON);
+    const opt::Market m{100.0, 0.03, 0.01, 0.0};
+    const auto K = chain_strikes();
+    for (double T : {0.25, 1.0, 3.0}) {
+        const pricers::COSPricer cos(cf, m, T);
+        const auto cs = cos.price_chain(K, opt::OptionType::Put);
+        const auto cm = pricers::CarrMadan::price_chain(cf, m, T, K, opt::OptionType::Put);
+        for (std::size_t i = 0; i < K.size(); ++i) {
+            REQUIRE_NEAR(cs[i], cm[i], 5e-5);
+            // Single-strike and chain paths share the cached coefficients
+            if (i % 37 == 0) REQUIRE_NEAR(cos.price(K[i], opt::OptionType::Put), cs[i], 1e-12);
+        }
+    }
+}
+
+TEST(test_fourier_rejects_bad_input) {
+    bool threw_heston = false, threw_grid = false, threw_strike = false;
+    pricers::HestonParams p = FO_HESTON;
+    p.rho = -1.5;
+    try {
+        pricers::HestonCF cf(p);
+    } catch (const std::invalid_argument&) {
+        threw_heston = true;
+    }
+    const pricers::BlackScholesCF cf(0.2);
+    pricers::CarrMadanParams cp;
+    cp.n = 1000;
+    try {
+        (void)pricers::CarrMadan::price_chain(cf, opt::Market{100.0, 0.0, 0.0, 0.0}, 1.0, {100.0}, opt::OptionType::Call, cp);
+    } catch (const std::invalid_argument&) {
+        threw_grid = true;
+    }
+    const pricers::COSPricer cos(cf, opt::Market{100.0, 0.0, 0.0, 0.0}, 1.0);
+    try {
+        (void)cos.price(-5.0, opt::OptionType::Put);
+    } catch (const std::invalid_argument&) {
+        threw_strike = true;
+    }
+    REQUIRE(threw_heston);
+    REQUIRE(threw_grid);
+    REQUIRE(threw_strike);
+}
@@ -2,14 +2,43 @@
 #include "opt/Types.hpp"
 #include "opt/Payoff.hpp"
 #include "opt/Option.hpp"
+#include "opt/Curve.hpp"
 #include "opt/Market.hpp"
+#include "opt/VolSurface.hpp"
+#include "opt/LocalVol.hpp"
 #include "pricers/AnalyticBS.hpp"
 #include "pricers/BinomialCRR.hpp"
+#include "pricers/LeisenReimer.hpp"
+#include "pricers/BjerksundStensland.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
 #include "pricers/ImpliedVol.hpp"
+#include "pricers/ImpliedVolChain.hpp"
+#include "pricers/ChebyshevSurrogate.hpp"
+#include "pricers/CharacteristicFunction.hpp"
+#include "pricers/CarrMadan.hpp"
+#include "pricers/COSPricer.hpp"
+#include "pricers/AdjointGreeks.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/MonteCarloBS.hpp"
+#include "pricers/MertonJumpDiffusion.hpp"
+#include "risk/Position.hpp"
+#include "risk/ScenarioEngine.hpp"
+#include "risk/OptionBook.hpp"
+#include "risk/PortfolioPricer.hpp"
 #include "pde/CrankNicolson.hpp"
 #include "pde/Tridiagonal.hpp"
+#include "pde/HestonADI.hpp"
 #include "util/Math.hpp"
+#include "util/Quadrature.hpp"
+#include "util/Parallel.hpp"
+#include "util/FFT.hpp"
 #include "util/Args.hpp"
 #include "util/Timer.hpp"
+#include "pricers/ConvergenceStudy.hpp"
+#include "pricers/EngineRouter.hpp"
+#include "pricers/RequestLog.hpp"
+#include "pricers/Replay.hpp"
+#include "pricers/PriceCache.hpp"
+#include "capi/optpricing.h"
 
 int main() { return 0; }
\ No newline at end of file
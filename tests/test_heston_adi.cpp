@@ -0,0 +1,117 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pde/HestonADI.hpp"
+#include "pde/Tridiagonal.hpp"
+#include "pricers/COSPricer.hpp"
+#include "pricers/CharacteristicFunction.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST(test_tridiagonal_solves_match) {
+    const std::vector<double> lo{0.0, -1.0, -0.5, -2.0, -1.0};
+    const std::vector<double> di{4.0, 3.0, 5.0, 6.0, 2.5};
+    const std::vector<double> up{1.0, -0.5, 2.0, 1.0, 0.0};
+    const pde::Tridiagonal t(lo, di, up);
+    const std::vector<double> x{1.0, -2.0, 0.5, 3.0, -1.5};
+    std::vector<double> d(5);
+    for (int i = 0; i < 5; ++i) {
+        d[i] = di[i] * x[i] + (i > 0 ? lo[i] * x[i - 1] : 0.0) + (i < 4 ? up[i] * x[i + 1] : 0.0);
+    }
+    std::vector<double> s = d;
+    t.solve(s.data());
+    for (int i = 0; i < 5; ++i) REQUIRE_NEAR(s[i], x[i], 1e-14);
+
+    // Three right-hand sides side by side (stride 4, one padding column) give the same answers
+    std::vector<double> many(5 * 4, 99.0);
+    for (int i = 0; i < 5; ++i) {
+        for (int k = 0; k < 3; ++k) many[i * 4 + k] = (k + 1) * d[i];
+    }
+    t.solve_many(many.data(), 4, 3);
+    for (int i = 0; i < 5; ++i) {
+        for (int k = 0; k < 3; ++k) REQUIRE_NEAR(many[i * 4 + k], (k + 1) * x[i], 1e-13);
+        REQUIRE(many[i * 4 + 3] == 99.0);
+    }
+
+    bool threw = false;
+    try {
+        pde::Tridiagonal({0.0, 1.0}, {1.0, 1.0}, {1.0, 0.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
+
+TEST(test_heston_adi_american_put_reference) {
+    // Ikonen & Toivanen (2009) benchmark: K = 10, T = 0.25, r = 0.1, v0 = 0.0625
+    const pricers::HestonParams h{0.0625, 5.0, 0.16, 0.9, 0.1};
+    const opt::Option put{10.0, 0.25, opt::OptionType::Put, opt::Exercise::American};
+    const double spots[] = {8.0, 9.0, 10.0, 11.0, 12.0};
+    const double ref[] = {2.000000, 1.107621, 0.520030, 0.213677, 0.082044};
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE_NEAR(pde::HestonADI::price(opt::Market{spots[i], 0.1, 0.0, 0.0}, put, h), ref[i], 2e-4);
+    }
+}
+
+TEST(test_heston_adi_european_matches_cos) {
+    const pricers::HestonParams h{0.04, 1.5, 0.04, 0.5, -0.7};
+    const opt::Market m{100.0, 0.03, 0.01, 0.0};
+    const pricers::HestonCF cf(h);
+    const pricers::COSPricer cos(cf, m, 1.0);
+    for (auto scheme : {pde::ADIScheme::CraigSneyd, pde::ADIScheme::ModifiedCraigSneyd, pde::ADIScheme::HundsdorferVerwer}) {
+        pde::HestonADIParams p;
+        p.scheme = scheme;
+        for (auto type : {opt::OptionType::Put, opt::OptionType::Call}) {
+            for (double K : {80.0, 100.0, 120.0}) {
+                const opt::Option o{K, 1.0, type, opt::Exercise::European};
+                REQUIRE_NEAR(pde::HestonADI::price(m, o, h, p), cos.price(K, type), 5e-3);
+            }
+        }
+    }
+
+    // The early-exercise premium of a put is positive
+    const opt::Option euro{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European};
+    const opt::Option amer{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    REQUIRE(pde::HestonADI::price(m, amer, h) > pde::HestonADI::price(m, euro, h) + 0.01);
+}
+
+TEST(test_heston_adi_threads_bit_identical) {
+    const pricers::HestonParams h{0.04, 1.5, 0.04, 0.5, -0.7};
+    const opt::Market m{100.0, 0.05, 0.02, 0.0};
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    pde::HestonADIParams p;
+    p.spot_nodes = 101;
+    p.var_nodes = 51;
+    p.time_steps = 40;
+    const double serial = pde::HestonADI::price(m, put, h, p);
+    for (unsigned t : {2u, 3u, 8u}) {
+        p.threads = t;
+        REQUIRE(pde::HestonADI::price(m, put, h, p) == serial);
+    }
+}
+
+TEST(test_heston_adi_rejects_bad_inputs) {
+    const pricers::HestonParams h{};
+    const opt::Market m{100.0, 0.05, 0.0, 0.0};
+    const opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    auto rejects = [&](const pricers::HestonParams& hh, const pde::HestonADIParams& p) {
+        try {
+            pde::HestonADI::price(m, put, hh, p);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    pde::HestonADIParams p;
+    p.spot_nodes = 2;
+    REQUIRE(rejects(h, p));
+    p = pde::HestonADIParams{};
+    p.var_max = 0.01;
+    REQUIRE(rejects(h, p));
+    pricers::HestonParams bad = h;
+    bad.rho = -1.5;
+    REQUIRE(rejects(bad, pde::HestonADIParams{}));
+}
@@ -4,9 +4,11 @@
 #include "opt/Option.hpp"
 #include "pricers/AnalyticBS.hpp"
 #include "pricers/ImpliedVol.hpp"
+#include "pricers/BinomialCRR.hpp"
 
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
 static double call_lower_bound(const opt::Market& m, const opt::Option& opt) {
     const double Dr = std::exp(-m.r * opt.T);
@@ -122,4 +124,93 @@ TEST(test_implied_vol_near_lower_bound_returns_small_sigma) {
 
     const double sigma_hat = pricers::ImpliedVol::solve_bs(m, call, target_price, params);
     REQUIRE(sigma_hat <= 1e-6); // should come back extremely small
-}
\ No newline at end of file
+}
+
+// Tree price the American solver is asked to invert (same N and band as AmericanIVParams)
+static double american_tree_price(const opt::Market& m, const opt::Option& opt) {
+    const pricers::AmericanIVParams params;
+    pricers::TreeParams tp;
+    tp.steps = params.steps;
+    tp.truncation_stddevs = params.truncation_stddevs;
+    return pricers::BinomialCRR::price_american(m, opt, tp);
+}
+
+// What callers did before solve_american: bisection with a full tree per probe
+static int naive_bisection_tree_evals(const opt::Market& m_in, const opt::Option& opt, double target) {
+    opt::Market m = m_in;
+    pricers::TreeParams tp;
+    tp.steps = pricers::AmericanIVParams{}.steps;
+    double lo = 0.01, hi = 2.0;
+    int evals = 0;
+    while (hi - lo > 1e-7) {
+        m.sigma = 0.5 * (lo + hi);
+        ++evals;
+        if (pricers::BinomialCRR::price_american(m, opt, tp) < target) lo = m.sigma;
+        else hi = m.sigma;
+    }
+    return evals;
+}
+
+TEST(test_american_implied_vol_recovers_sigma) {
+    const opt::Market markets[] = {{100.0, 0.05, 0.02, 0.20}, {100.0, 0.03, 0.00, 0.50}, {100.0, 0.02, 0.06, 0.30}};
+    const opt::Option options[] = {{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American},
+                                   { 80.0, 0.25, opt::OptionType::Put, opt::Exercise::American},
+                                   {100.0, 2.0, opt::OptionType::Call, opt::Exercise::American}};
+
+    for (int k = 0; k < 3; ++k) {
+        const double target = american_tree_price(markets[k], options[k]);
+
+        const auto fast = pricers::ImpliedVol::solve_american(markets[k], options[k], target);
+        REQUIRE_NEAR(fast.sigma, markets[k].sigma, 1e-7);
+        REQUIRE(fast.tree_evals <= 4);
+
+        pricers::AmericanIVParams ladder;
+        ladder.fast_seed = false;
+        const auto trees = pricers::ImpliedVol::solve_american(markets[k], options[k], target, ladder);
+        REQUIRE_NEAR(trees.sigma, markets[k].sigma, 1e-7);
+        REQUIRE(trees.fast_evals == 0);
+        REQUIRE(trees.tree_evals <= 12); // ~3 per rung, most of them on coarse trees
+    }
+}
+
+TEST(test_american_implied_vol_beats_naive_bisection) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const double target = american_tree_price(m, put);
+
+    const auto res = pricers::ImpliedVol::solve_american(m, put, target);
+    const int naive = naive_bisection_tree_evals(m, put, target);
+    REQUIRE(naive >= 20);
+    REQUIRE(5 * res.tree_evals <= naive);
+}
+
+TEST(test_american_implied_vol_intrinsic_and_bounds) {
+    // Deep ITM put priced at intrinsic: no time value, so the smallest vol is returned
+    opt::Market m{100.0, 0.05, 0.00, 0.15};
+    opt::Option put{130.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const auto res = pricers::ImpliedVol::solve_american(m, put, put.K - m.S0);
+    REQUIRE(res.sigma == pricers::AmericanIVParams{}.sigma_lo);
+    REQUIRE(res.tree_evals == 0);
+
+    bool threw_below = false, threw_above = false, threw_european = false;
+    try {
+        (void)pricers::ImpliedVol::solve_american(m, put, put.K - m.S0 - 1e-3);
+    } catch (const std::invalid_argument&) {
+        threw_below = true;
+    }
+    try {
+        (void)pricers::ImpliedVol::solve_american(m, put, put.K + 1e-3);
+    } catch (const std::invalid_argument&) {
+        threw_above = true;
+    }
+    opt::Option eu = put;
+    eu.exercise = opt::Exercise::European;
+    try {
+        (void)pricers::ImpliedVol::solve_american(m, eu, 31.0);
+    } catch (const std::invalid_argument&) {
+        threw_european = true;
+    }
+    REQUIRE(threw_below);
+    REQUIRE(threw_above);
+    REQUIRE(threw_european);
+}
@@ -0,0 +1,112 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/ImpliedVol.hpp"
+#include "pricers/ImpliedVolChain.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    double bs(const opt::Market& m, double K, double T, opt::OptionType type, double sigma) {
+        opt::Market mm = m;
+        mm.sigma = sigma;
+        return pricers::AnalyticBS::price(mm, opt::Option{K, T, type, opt::Exercise::European});
+    }
+
+    double smile(double K) { return 0.22 + 0.4 * std::pow(std::log(K / 100.0), 2); }
+}
+
+TEST(test_iv_chain_tick_updates_take_one_step) {
+    const opt::Market m{100.0, 0.03, 0.01, 0.0};
+    const double T = 0.5;
+    pricers::ImpliedVolChain chain(m, T);
+    std::vector<double> strikes;
+    for (double K = 70.0; K <= 130.0; K += 5.0) strikes.push_back(K);
+    for (double K : strikes) {
+        const opt::OptionType type = (K < 100.0) ? opt::OptionType::Put : opt::OptionType::Call;
+        chain.add(K, type, bs(m, K, T, type, smile(K)));
+    }
+    REQUIRE(chain.stats().full == strikes.size() && chain.stats().warm == 0);
+    REQUIRE(chain.changed().size() == strikes.size());
+    for (std::size_t i = 0; i < strikes.size(); ++i) REQUIRE_NEAR(chain.sigma(i), smile(strikes[i]), 1e-7);
+    chain.clear_dirty();
+    REQUIRE(chain.dirty().empty() && chain.changed().empty());
+
+    // A tick on every other quote: each one step, each agreeing with a solve from scratch
+    const std::size_t full_before = chain.stats().full;
+    for (int round = 0; round < 20; ++round) {
+        for (std::size_t i = round % 2; i < strikes.size(); i += 2) {
+            chain.update(i, chain.quote(i) + ((round % 3) ? 0.01 : -0.01));
+            const opt::OptionType type = (strikes[i] < 100.0) ? opt::OptionType::Put : opt::OptionType::Call;
+            const opt::Option opt{strikes[i], T, type, opt::Exercise::European};
+            REQUIRE_NEAR(bs(m, strikes[i], T, type, chain.sigma(i)), chain.quote(i), 1e-10);
+            REQUIRE_NEAR(chain.sigma(i), pricers::ImpliedVol::solve_bs(m, opt, chain.quote(i)), 1e-7);
+        }
+    }
+    REQUIRE(chain.stats().full == full_before);
+    REQUIRE(chain.stats().warm == 10 * 7 + 10 * 6);
+
+    // Only the touched quotes are dirty, and an unchanged price is not a re-solve
+    chain.clear_dirty();
+    chain.update(3, chain.quote(3));
+    REQUIRE(chain.dirty().empty());
+    chain.update(3, chain.quote(3) + 0.02);
+    chain.update(5, chain.quote(5) + 1e-12);
+    chain.update(3, chain.quote(3) - 0.01);
+    REQUIRE(chain.dirty().size() == 2 && chain.dirty()[0] == 3 && chain.dirty()[1] == 5);
+    REQUIRE(chain.changed().size() == 1 && chain.changed()[0] == 3);
+}
+
+TEST(test_iv_chain_market_moves_and_fallbacks) {
+    opt::Market m{100.0, 0.02, 0.0, 0.0};
+    const double T = 0.25;
+    pricers::ImpliedVolChain chain(m, T);
+    const double p_atm = bs(m, 100.0, T, opt::OptionType::Call, 0.3);
+    chain.add(100.0, opt::OptionType::Call, p_atm);
+    chain.add(120.0, opt::OptionType::Put, bs(m, 120.0, T, opt::OptionType::Put, 0.35));
+    chain.clear_dirty();
+
+    // Spot moves with quotes held: every quote re-solved, still warm for a small move
+    m.S0 = 100.05;
+    chain.on_market(m);
+    REQUIRE(chain.dirty().size() == 2 && chain.changed().size() == 2);
+    REQUIRE(chain.stats().full == 2 && chain.stats().warm == 2);
+    const opt::Option atm{100.0, T, opt::OptionType::Call, opt::Exercise::European};
+    REQUIRE_NEAR(chain.sigma(0), pricers::ImpliedVol::solve_bs(m, atm, p_atm), 1e-7);
+
+    // A jump too large for one step falls back to the full solve
+    chain.update(0, bs(m, 100.0, T, opt::OptionType::Call, 1.5));
+    REQUIRE(chain.stats().full == 3);
+    REQUIRE_NEAR(chain.sigma(0), 1.5, 1e-7);
+
+    // A quote below intrinsic has no implied vol and comes back once it is valid again
+    chain.clear_dirty();
+    chain.update(1, 1.0);
+    REQUIRE(std::isnan(chain.sigma(1)));
+    REQUIRE(chain.stats().failed == 1);
+    REQUIRE(chain.changed().size() == 1 && chain.changed()[0] == 1);
+    chain.clear_dirty();
+    chain.update(1, bs(m, 120.0, T, opt::OptionType::Put, 0.4));
+    REQUIRE_NEAR(chain.sigma(1), 0.4, 1e-7);
+    REQUIRE(chain.changed().size() == 1);
+
+    bool threw = false;
+    try {
+        chain.update(2, 1.0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    threw = false;
+    try {
+        pricers::ImpliedVolChain bad(m, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
@@ -0,0 +1,127 @@
+#include "test_framework.hpp"
+
+#include "opt/LocalVol.hpp"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "opt/VolSurface.hpp"
+#include "pde/CrankNicolson.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using opt::Exercise;
+using opt::OptionType;
+
+TEST(test_local_vol_flat_matches_closed_forms) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.2};
+    const pde::LocalVolPDE pde(opt::LocalVolSurface::flat(0.2), m, {1.0, 0.25, 0.5});
+    REQUIRE(pde.maturities().size() == 3 && pde.maturities().front() == 0.25);
+
+    std::vector<opt::Option> contracts;
+    for (double T : {0.25, 0.5, 1.0}) {
+        for (double K : {80.0, 90.0, 100.0, 110.0, 120.0}) {
+            contracts.push_back({K, T, OptionType::Call, Exercise::European});
+            contracts.push_back({K, T, OptionType::Put, Exercise::European});
+            contracts.push_back({K, T, OptionType::Put, Exercise::American});
+        }
+    }
+    const std::vector<double> all = pde.price_all(contracts);
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        const opt::Option& o = contracts[i];
+        if (o.exercise == Exercise::European) {
+            // Forward (Dupire) and backward solves both reproduce Black-Scholes
+            const double bs = pricers::AnalyticBS::price(m, o);
+            REQUIRE_NEAR(all[i], bs, 2e-3);
+            REQUIRE_NEAR(pde.price(o), bs, 2e-3);
+        } else {
+            REQUIRE(all[i] == pde.price(o));
+            REQUIRE_NEAR(all[i], pricers::AndersenLakeOffengelt::price(m, o), 2e-3);
+        }
+    }
+
+    // Contracts must sit on the grid's maturities and, for the forward solve, inside its strikes
+    bool threw = false;
+    try {
+        pde.price(opt::Option{100.0, 0.75, OptionType::Put, Exercise::American});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    threw = false;
+    try {
+        pde.price_all({opt::Option{1000.0, 0.25, OptionType::Call, Exercise::European}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
+
+TEST(test_local_vol_time_dependent_rows) {
+    // Row i applies up to its time: 15% vol to t = 0.5, then 30%. Prices at T = 1 follow the
+    // average variance.
+    const opt::LocalVolSurface lv({0.5, 1.0}, {{100.0}, {100.0}}, {{0.15}, {0.30}});
+    REQUIRE(lv.sigma(100.0, 0.5) == 0.15 && lv.sigma(80.0, 0.51) == 0.30 && lv.sigma(120.0, 5.0) == 0.30);
+
+    opt::Market m{100.0, 0.03, 0.0, 0.0};
+    const pde::LocalVolPDE pde(lv, m, {0.5, 1.0});
+    const opt::Option call{105.0, 1.0, OptionType::Call, Exercise::European};
+    m.sigma = std::sqrt(0.5 * 0.15 * 0.15 + 0.5 * 0.30 * 0.30);
+    REQUIRE_NEAR(pde.price_all({call})[0], pricers::AnalyticBS::price(m, call), 2e-3);
+    REQUIRE_NEAR(pde.price(call), pricers::AnalyticBS::price(m, call), 2e-3);
+
+    bool threw = false;
+    try {
+        opt::LocalVolSurface({1.0, 0.5}, {{100.0}, {100.0}}, {{0.2}, {0.2}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
+
+TEST(test_local_vol_dupire_reprices_surface) {
+    // SVI smiles with a negative skew, forwards at r - q = 3%
+    const double r = 0.05, q = 0.02;
+    std::vector<opt::SmileSlice> chain;
+    for (double T : {0.1, 0.25, 0.5, 1.0, 2.0}) {
+        const opt::SVIParams p{0.03 * T, 0.1 * std::sqrt(T), -0.5, 0.02, 0.15};
+        opt::SmileSlice s;
+        s.T = T;
+        s.forward = 100.0 * std::exp((r - q) * T);
+        for (int i = 0; i < 25; ++i) {
+            const double k = -0.8 + 1.6 * i / 24.0;
+            s.strikes.push_back(s.forward * std::exp(k));
+            s.ivs.push_back(std::sqrt(p.w(k) / T));
+        }
+        chain.push_back(s);
+    }
+    const opt::VolSurface iv = opt::VolSurface::calibrate(chain);
+    const opt::LocalVolSurface lv = opt::LocalVolSurface::from_implied(iv, 100.0, r, q);
+    REQUIRE(lv.clamped() == 0);
+    // The skew carries over: local vol falls with spot near the money
+    REQUIRE(lv.sigma(90.0, 1.0) > lv.sigma(100.0, 1.0) && lv.sigma(100.0, 1.0) > lv.sigma(105.0, 1.0));
+
+    const opt::Market m{100.0, r, q, 0.0};
+    const pde::LocalVolPDE pde(lv, m, iv.expiries());
+    std::vector<opt::Option> contracts;
+    for (double T : iv.expiries()) {
+        for (int i = 0; i <= 10; ++i) {
+            const double K = 100.0 * std::exp((r - q) * T + std::sqrt(T) * (-0.5 + 0.1 * i));
+            contracts.push_back({K, T, i < 5 ? OptionType::Put : OptionType::Call, Exercise::European});
+        }
+    }
+    // One forward solve reprices the surface to within 0.1 vol points
+    const std::vector<double> prices = pde.price_all(contracts);
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        const opt::Option& o = contracts[i];
+        opt::Market mi = m;
+        mi.sigma = iv.sigma(o.K, o.T);
+        const double bs = pricers::AnalyticBS::price(mi, o);
+        const double vega = pricers::AnalyticBS::greeks(mi, o).vega;
+        REQUIRE(std::fabs(prices[i] - bs) / vega < 1e-3);
+        // and the backward solve on the same tables agrees with it
+        REQUIRE_NEAR(pde.price(o), prices[i], 5e-3);
+    }
+}
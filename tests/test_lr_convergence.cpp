@@ -0,0 +1,127 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/LeisenReimer.hpp"
+#include "pricers/AnalyticBS.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+static double abs_err(double a, double b) { return std::fabs(a - b); }
+
+// Second-order convergence: doubling N should cut the error by ~4x (allow 3x)
+static void run_lr_convergence_case(const opt::Market& m, const opt::Option& opt,
+                                    const std::vector<int>& Ns,
+                                    double tol_at_101) {
+    const double bs = pricers::AnalyticBS::price(m, opt);
+
+    std::vector<double> errs;
+    for (int N : Ns) {
+        pricers::TreeParams tp;
+        tp.steps = N;
+        errs.push_back(abs_err(pricers::LeisenReimer::price_european(m, opt, tp), bs));
+    }
+    for (std::size_t k = 1; k < errs.size(); ++k) {
+        REQUIRE(errs[k] < errs[k - 1] / 3.0 + 1e-12);
+    }
+
+    pricers::TreeParams lr;
+    lr.steps = 101;
+    pricers::TreeParams crr;
+    crr.steps = 2000;
+    const double lr_err = abs_err(pricers::LeisenReimer::price_european(m, opt, lr), bs);
+    const double crr_err = abs_err(pricers::BinomialCRR::price_european(m, opt, crr), bs);
+
+    REQUIRE(lr_err < tol_at_101);
+    REQUIRE(lr_err < crr_err); // 20x fewer steps, still more accurate than CRR
+}
+
+TEST(test_lr_converges_second_order_call_with_dividends) {
+    opt::Market m{100.0, 0.03, 0.01, 0.20};
+    opt::Option call{105.0, 0.5, opt::OptionType::Call, opt::Exercise::European};
+    run_lr_convergence_case(m, call, {25, 51, 101, 201, 401}, /*tol_at_101=*/1e-4);
+}
+
+TEST(test_lr_converges_second_order_put_with_dividends) {
+    opt::Market m{100.0, 0.03, 0.01, 0.20};
+    opt::Option put{105.0, 1.5, opt::OptionType::Put, opt::Exercise::European};
+    run_lr_convergence_case(m, put, {25, 51, 101, 201, 401}, /*tol_at_101=*/1e-4);
+}
+
+TEST(test_lr_even_steps_round_up_to_odd) {
+    opt::Market m{100.0, 0.03, 0.01, 0.20};
+    opt::Option call{105.0, 0.5, opt::OptionType::Call, opt::Exercise::European};
+
+    pricers::TreeParams even, odd;
+    even.steps = 100;
+    odd.steps = 101;
+    REQUIRE(pricers::LeisenReimer::odd_steps(100) == 101);
+    REQUIRE(pricers::LeisenReimer::price_european(m, call, even) == pricers::LeisenReimer::price_european(m, call, odd));
+}
+
+TEST(test_lr_american_put_vs_crr) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    pricers::TreeParams ref_tp;
+    ref_tp.steps = 2001;
+    const double ref = pricers::LeisenReimer::price_american_richardson(m, put, ref_tp);
+
+    pricers::TreeParams lr;
+    lr.steps = 201;
+    pricers::TreeParams crr;
+    crr.steps = 2000;
+
+    const double lr_plain = pricers::LeisenReimer::price_american(m, put, lr);
+    const double lr_rich = pricers::LeisenReimer::price_american_richardson(m, put, lr);
+    const double crr_price = pricers::BinomialCRR::price_american(m, put, crr);
+
+    REQUIRE(abs_err(lr_rich, ref) < 2e-4);
+    REQUIRE(abs_err(lr_plain, ref) < 3e-3);
+    REQUIRE(abs_err(crr_price, ref) < 5e-3);
+
+    // American >= European on the same tree
+    opt::Option put_euro = put;
+    put_euro.exercise = opt::Exercise::European;
+    REQUIRE(lr_plain >= pricers::LeisenReimer::price_european(m, put_euro, lr) - 1e-12);
+}
+
+TEST(test_lr_american_call_no_dividends_equals_european) {
+    opt::Market m{150.0, 0.05, 0.0, 0.20};
+    opt::Option call_amer{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    opt::Option call_euro{100.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+
+    pricers::TreeParams tp;
+    tp.steps = 201;
+    REQUIRE(abs_err(pricers::LeisenReimer::price_american(m, call_amer, tp),
+                    pricers::LeisenReimer::price_european(m, call_euro, tp)) < 1e-7);
+    REQUIRE(abs_err(pricers::LeisenReimer::price_european(m, call_euro, tp),
+                    pricers::AnalyticBS::price(m, call_euro)) < 1e-4);
+}
+
+TEST(test_lr_tree_params) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    pricers::TreeParams tp{301};
+    const double serial = pricers::LeisenReimer::price_american(m, put, tp);
+
+    // Speed settings of the CRR lattice leave the price unchanged
+    pricers::TreeParams fast = tp;
+    fast.threads = 4;
+    fast.exercise_region = true;
+    REQUIRE(pricers::LeisenReimer::price_american(m, put, fast) == serial);
+
+    bool threw = false;
+    pricers::TreeParams trunc = tp;
+    trunc.truncation_stddevs = 6.0;
+    try {
+        pricers::LeisenReimer::price_american(m, put, trunc);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
@@ -0,0 +1,123 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/MertonJumpDiffusion.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Textbook form: Poisson(lambda (1+k) T) weights on BS with r_n = r - lambda k + n ln(1+k) / T
+    // and sigma_n^2 = sigma^2 + n sigma_j^2 / T, summed to a fixed 120 terms
+    double merton_reference(const opt::Market& m, const opt::Option& o, const pricers::MertonParams& j) {
+        const double k = std::exp(j.mu_j + 0.5 * j.sigma_j * j.sigma_j) - 1.0;
+        const double lq = j.lambda * (1.0 + k) * o.T;
+        double sum = 0.0;
+        double log_fact = 0.0;
+        for (int n = 0; n < 120; ++n) {
+            if (n > 0) log_fact += std::log(static_cast<double>(n));
+            opt::Market mn = m;
+            mn.r = m.r - j.lambda * k + n * std::log(1.0 + k) / o.T;
+            mn.sigma = std::sqrt(m.sigma * m.sigma + n * j.sigma_j * j.sigma_j / o.T);
+            const double weight = std::exp(-lq + n * std::log(lq) - log_fact);
+            sum += weight * pricers::AnalyticBS::price(mn, o);
+        }
+        return sum;
+    }
+}
+
+TEST(test_merton_matches_textbook_series) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const pricers::MertonParams jumps[] = {{0.1, -0.1, 0.15}, {1.0, -0.2, 0.3}, {5.0, 0.05, 0.1}};
+    for (const auto& j : jumps) {
+        for (double T : {0.02, 0.5, 3.0}) {
+            for (double K : {70.0, 100.0, 140.0}) {
+                for (auto type : {opt::OptionType::Call, opt::OptionType::Put}) {
+                    const opt::Option o{K, T, type, opt::Exercise::European};
+                    REQUIRE_NEAR(pricers::MertonJumpDiffusion::price(m, o, j), merton_reference(m, o, j), 1e-10);
+                }
+            }
+        }
+    }
+
+    // No jumps: one term, the BS price
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::European};
+    const pricers::MertonResult r0 = pricers::MertonJumpDiffusion::price_greeks(m, put, pricers::MertonParams{0.0, 0.0, 0.0});
+    REQUIRE(r0.terms == 1);
+    REQUIRE_NEAR(r0.price, pricers::AnalyticBS::price(m, put), 1e-13);
+    REQUIRE_NEAR(r0.greeks.theta, pricers::AnalyticBS::greeks(m, put).theta, 1e-12);
+}
+
+TEST(test_merton_terms_adapt_to_intensity) {
+    const opt::Market m{100.0, 0.03, 0.0, 0.25};
+    const pricers::MertonParams j{0.5, -0.1, 0.2};
+    const opt::Option wing{80.0, 0.02, opt::OptionType::Put, opt::Exercise::European};
+    const opt::Option longer{80.0, 5.0, opt::OptionType::Put, opt::Exercise::European};
+    const int short_terms = pricers::MertonJumpDiffusion::price_greeks(m, wing, j).terms;
+    const int long_terms = pricers::MertonJumpDiffusion::price_greeks(m, longer, j).terms;
+    REQUIRE(short_terms <= 5);
+    REQUIRE(long_terms > short_terms);
+
+    pricers::MertonSeriesParams loose;
+    loose.tolerance = 1e-6;
+    REQUIRE(pricers::MertonJumpDiffusion::price_greeks(m, longer, j, loose).terms < long_terms);
+    REQUIRE_NEAR(pricers::MertonJumpDiffusion::price(m, longer, j, loose), pricers::MertonJumpDiffusion::price(m, longer, j), 1e-6 * 80.0);
+
+    bool threw = false;
+    try {
+        pricers::MertonJumpDiffusion::price(m, longer, pricers::MertonParams{500.0, 0.0, 0.1});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
+
+TEST(test_merton_greeks_match_finite_differences) {
+    const opt::Market m{100.0, 0.04, 0.01, 0.22};
+    const pricers::MertonParams j{0.8, -0.15, 0.25};
+    for (auto type : {opt::OptionType::Call, opt::OptionType::Put}) {
+        for (double K : {85.0, 100.0, 120.0}) {
+            const opt::Option o{K, 0.75, type, opt::Exercise::European};
+            const pricers::Greeks g = pricers::MertonJumpDiffusion::price_greeks(m, o, j).greeks;
+            auto px = [&](opt::Market mm, opt::Option oo) { return pricers::MertonJumpDiffusion::price(mm, oo, j); };
+
+            const double h = 1e-3;
+            opt::Market up = m, dn = m;
+            up.S0 += h; dn.S0 -= h;
+            REQUIRE_NEAR(g.delta, (px(up, o) - px(dn, o)) / (2 * h), 1e-7);
+            REQUIRE_NEAR(g.gamma, (px(up, o) - 2 * px(m, o) + px(dn, o)) / (h * h), 1e-5);
+            // First-order Greeks use a smaller bump: their O(h^2) error is ~1e-4 at h = 1e-3
+            const double e = 1e-4;
+            up = dn = m;
+            up.sigma += e; dn.sigma -= e;
+            REQUIRE_NEAR(g.vega, (px(up, o) - px(dn, o)) / (2 * e), 1e-5);
+            up = dn = m;
+            up.r += e; dn.r -= e;
+            REQUIRE_NEAR(g.rho, (px(up, o) - px(dn, o)) / (2 * e), 1e-5);
+            opt::Option later = o, sooner = o;
+            later.T += e; sooner.T -= e;
+            REQUIRE_NEAR(g.theta, -(px(m, later) - px(m, sooner)) / (2 * e), 1e-5);
+        }
+    }
+}
+
+TEST(test_merton_batch_matches_scalar) {
+    const pricers::MertonParams j{0.3, -0.2, 0.1};
+    std::vector<double> S, K, T, r, q, sig;
+    std::vector<opt::OptionType> type;
+    for (int i = 0; i < 64; ++i) {
+        S.push_back(100.0); K.push_back(60.0 + i); T.push_back(0.01 + 0.02 * i);
+        r.push_back(0.03); q.push_back(0.01); sig.push_back(0.15 + 0.002 * i);
+        type.push_back(i % 2 ? opt::OptionType::Call : opt::OptionType::Put);
+    }
+    std::vector<double> out(S.size());
+    pricers::MertonJumpDiffusion::price_batch(S.size(), S.data(), K.data(), T.data(), r.data(), q.data(), sig.data(), type.data(), j, out.data());
+    for (std::size_t i = 0; i < S.size(); ++i) {
+        const opt::Market m{S[i], r[i], q[i], sig[i]};
+        const opt::Option o{K[i], T[i], type[i], opt::Exercise::European};
+        REQUIRE(out[i] == pricers::MertonJumpDiffusion::price(m, o, j));
+    }
+}
@@ -0,0 +1,129 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "risk/OptionBook.hpp"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+struct BookRow {
+    std::string underlying;
+    opt::Market m;
+    opt::Option o;
+};
+
+static std::vector<BookRow> sample_rows() {
+    using opt::OptionType;
+    using opt::Exercise;
+    return {
+        {"AAA", {100.0, 0.03, 0.01, 0.20}, {105.0, 1.0, OptionType::Call, Exercise::European}},
+        {"BBB", { 50.0, 0.02, 0.00, 0.35}, { 45.0, 0.5, OptionType::Put, Exercise::European}},
+        {"AAA", {100.0, 0.03, 0.01, 0.25}, { 90.0, 2.0, OptionType::Put, Exercise::European}},
+        {"AAA", {100.0, 0.04, 0.02, 0.18}, {100.0, 0.1, OptionType::Call, Exercise::European}},
+        {"BBB", { 50.0, 0.02, 0.00, 0.30}, { 55.0, 1.5, OptionType::Call, Exercise::European}},
+    };
+}
+
+static void require_matches_bs(const risk::OptionBook& book, std::size_t row, const opt::Market& m, const opt::Option& o) {
+    const pricers::Greeks ref = pricers::AnalyticBS::greeks(m, o);
+    const pricers::Greeks g = book.greeks(row);
+    REQUIRE_NEAR(book.price(row), pricers::AnalyticBS::price(m, o), 1e-12);
+    REQUIRE_NEAR(g.delta, ref.delta, 1e-12);
+    REQUIRE_NEAR(g.gamma, ref.gamma, 1e-12);
+    REQUIRE_NEAR(g.vega, ref.vega, 1e-10);
+    REQUIRE_NEAR(g.theta, ref.theta, 1e-10);
+    REQUIRE_NEAR(g.rho, ref.rho, 1e-10);
+}
+
+TEST(test_option_book_matches_analytic_bs_through_ticks) {
+    auto rows = sample_rows();
+    risk::OptionBook book;
+    for (const auto& r : rows) book.add(r.underlying, r.m, r.o);
+    for (std::size_t i = 0; i < rows.size(); ++i) require_matches_bs(book, i, rows[i].m, rows[i].o);
+
+    book.on_spot("AAA", 103.5);
+    book.on_vol("BBB", 0.42);
+    book.on_row_vol(2, 0.31);
+    for (auto& r : rows) {
+        if (r.underlying == "AAA") r.m.S0 = 103.5;
+        else r.m.sigma = 0.42;
+    }
+    rows[2].m.sigma = 0.31;
+    for (std::size_t i = 0; i < rows.size(); ++i) require_matches_bs(book, i, rows[i].m, rows[i].o);
+}
+
+TEST(test_option_book_tracks_dirty_rows) {
+    risk::OptionBook book;
+    for (const auto& r : sample_rows()) book.add(r.underlying, r.m, r.o);
+    REQUIRE(book.dirty_rows().size() == 5); // freshly added rows are dirty
+    book.clear_dirty();
+    REQUIRE(book.dirty_rows().empty());
+
+    const std::size_t aaa = book.underlying_id("AAA");
+    REQUIRE(book.on_spot(aaa, 101.0) == 3);
+    std::vector<std::size_t> dirty = book.dirty_rows();
+    std::sort(dirty.begin(), dirty.end());
+    REQUIRE((dirty == std::vector<std::size_t>{0, 2, 3}));
+
+    // A second tick on the same rows does not duplicate them
+    book.on_spot(aaa, 102.0);
+    book.on_row_vol(1, 0.4);
+    REQUIRE(book.dirty_rows().size() == 4);
+    REQUIRE(book.dirty_rows().back() == 1);
+
+    book.clear_dirty();
+    REQUIRE(book.on_row_vol(4, 0.2) == 1);
+    REQUIRE(book.dirty_rows().size() == 1);
+    REQUIRE(book.spot(aaa) == 102.0);
+}
+
+TEST(test_option_book_prices_only_mode) {
+    risk::OptionBook lean(false);
+    const auto rows = sample_rows();
+    for (const auto& r : rows) lean.add(r.underlying, r.m, r.o);
+    lean.on_spot("BBB", 48.0);
+
+    opt::Market m = rows[1].m;
+    m.S0 = 48.0;
+    REQUIRE_NEAR(lean.price(1), pricers::AnalyticBS::price(m, rows[1].o), 1e-12);
+    REQUIRE(lean.greeks(1).delta == 0.0);
+}
+
+TEST(test_option_book_rejects_bad_input) {
+    risk::OptionBook book;
+    opt::Market m{100.0, 0.03, 0.01, 0.20};
+    book.add("AAA", m, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::European});
+
+    bool threw_american = false, threw_spot = false, threw_unknown = false, threw_row = false;
+    try {
+        book.add("AAA", m, opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American});
+    } catch (const std::invalid_argument&) {
+        threw_american = true;
+    }
+    try {
+        opt::Market other = m;
+        other.S0 = 99.0;
+        book.add("AAA", other, opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European});
+    } catch (const std::invalid_argument&) {
+        threw_spot = true;
+    }
+    try {
+        book.on_spot("ZZZ", 10.0);
+    } catch (const std::invalid_argument&) {
+        threw_unknown = true;
+    }
+    try {
+        (void)book.price(7);
+    } catch (const std::out_of_range&) {
+        threw_row = true;
+    }
+    REQUIRE(threw_american);
+    REQUIRE(threw_spot);
+    REQUIRE(threw_unknown);
+    REQUIRE(threw_row);
+    REQUIRE(book.size() == 1);
+}
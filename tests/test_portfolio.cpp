@@ -0,0 +1,133 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialAAD.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "risk/PortfolioPricer.hpp"
+#include "risk/Position.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // 600 positions over 10 distinct contracts, spread across accounts with mixed quantities
+    std::vector<risk::Position> make_book() {
+        const opt::Market m{100.0, 0.05, 0.02, 0.20};
+        const std::vector<opt::Option> contracts{
+            {90.0, 0.5, opt::OptionType::Call, opt::Exercise::European},
+            {100.0, 0.5, opt::OptionType::Call, opt::Exercise::European},
+            {110.0, 0.5, opt::OptionType::Put, opt::Exercise::European},
+            {100.0, 1.0, opt::OptionType::Put, opt::Exercise::European},
+            {95.0, 0.25, opt::OptionType::Put, opt::Exercise::American},
+            {105.0, 1.0, opt::OptionType::Put, opt::Exercise::American},
+            {100.0, 1.0, opt::OptionType::Call, opt::Exercise::American},
+            {120.0, 2.0, opt::OptionType::Call, opt::Exercise::European},
+            {80.0, 2.0, opt::OptionType::Put, opt::Exercise::European},
+            {100.0, 0.1, opt::OptionType::Call, opt::Exercise::European},
+        };
+        std::vector<risk::Position> book;
+        for (int i = 0; i < 600; ++i) {
+            risk::Position pos;
+            pos.id = "acct" + std::to_string(i % 37) + "/" + std::to_string(i);
+            pos.market = m;
+            pos.option = contracts[(i * 7) % contracts.size()];
+            pos.quantity = (i % 5) - 2.0;
+            book.push_back(pos);
+        }
+        return book;
+    }
+}
+
+TEST(test_portfolio_prices_each_contract_once) {
+    const std::vector<risk::Position> book = make_book();
+    risk::PortfolioParams p;
+    p.tree_steps = 300;
+    const risk::PortfolioResult res = risk::PortfolioPricer(p).price(book);
+    REQUIRE(res.unique_contracts == 10);
+    REQUIRE(res.price.size() == book.size() && res.greeks.size() == book.size());
+
+    double value = 0.0, delta = 0.0, gamma = 0.0, vega = 0.0, theta = 0.0, rho = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        const risk::Position& pos = book[i];
+        if (pos.option.exercise == opt::Exercise::European) {
+            REQUIRE(res.price[i] == pricers::AnalyticBS::price(pos.market, pos.option));
+            REQUIRE(res.greeks[i].gamma == pricers::AnalyticBS::greeks(pos.market, pos.option).gamma);
+        } else {
+            const pricers::AdjointGreeks a = pricers::BinomialAAD::greeks(pos.market, pos.option, pricers::TreeParams{300});
+            REQUIRE(res.price[i] == a.price);
+            REQUIRE(res.greeks[i].delta == a.delta);
+            REQUIRE(res.greeks[i].gamma == a.gamma && res.greeks[i].theta == a.theta);
+        }
+        value += pos.quantity * res.price[i];
+        delta += pos.quantity * res.greeks[i].delta;
+        gamma += pos.quantity * res.greeks[i].gamma;
+        vega += pos.quantity * res.greeks[i].vega;
+        theta += pos.quantity * res.greeks[i].theta;
+        rho += pos.quantity * res.greeks[i].rho;
+        REQUIRE(res.contract[i] == res.contract[(i + 10) % book.size()]);
+    }
+    REQUIRE_NEAR(res.value, value, 1e-9);
+    REQUIRE_NEAR(res.total.delta, delta, 1e-9);
+    REQUIRE_NEAR(res.total.vega, vega, 1e-9);
+
+    // Every total is finite, American contracts included
+    REQUIRE(std::isfinite(res.total.gamma) && std::isfinite(res.total.theta));
+    REQUIRE_NEAR(res.total.gamma, gamma, 1e-9);
+    REQUIRE_NEAR(res.total.theta, theta, 1e-9);
+    REQUIRE_NEAR(res.total.rho, rho, 1e-9);
+}
+
+TEST(test_portfolio_canonicalizes_equivalent_contracts) {
+    const opt::Option amer_call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    const opt::Option euro_call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+    std::vector<risk::Position> book(4);
+    book[0].market = opt::Market{100.0, 0.0, 0.0, 0.2};
+    book[0].option = euro_call;
+    book[1].market = opt::Market{100.0, -0.0, 0.0, 0.2}; // signed zero rate
+    book[1].option = euro_call;
+    book[2].market = opt::Market{100.0, 0.0, -0.0, 0.2};
+    book[2].option = amer_call;                          // no dividends: never exercised early
+    book[3].market = opt::Market{100.0, 0.0, 0.03, 0.2};
+    book[3].option = amer_call;                          // dividends: a tree contract
+
+    risk::PortfolioParams p;
+    p.tree_steps = 200;
+    p.with_greeks = false;
+    risk::PortfolioResult res = risk::PortfolioPricer(p).price(book);
+    REQUIRE(res.unique_contracts == 2);
+    REQUIRE(res.greeks.empty());
+    REQUIRE(res.price[2] == pricers::AnalyticBS::price(book[0].market, euro_call));
+    REQUIRE(res.price[3] == pricers::BinomialCRR::price_american(book[3].market, amer_call, pricers::TreeParams{200}));
+
+    p.merge_american_calls = false;
+    res = risk::PortfolioPricer(p).price(book);
+    REQUIRE(res.unique_contracts == 3);
+    REQUIRE(res.price[2] == pricers::BinomialCRR::price_american(book[2].market, amer_call, pricers::TreeParams{200}));
+}
+
+TEST(test_portfolio_threads_and_errors) {
+    std::vector<risk::Position> book = make_book();
+    risk::PortfolioParams p;
+    p.tree_steps = 200;
+    p.threads = 1;
+    const risk::PortfolioResult serial = risk::PortfolioPricer(p).price(book);
+    p.threads = 4;
+    const risk::PortfolioResult par = risk::PortfolioPricer(p).price(book);
+    REQUIRE(par.price == serial.price);
+    REQUIRE(par.value == serial.value && par.total.delta == serial.total.delta);
+
+    REQUIRE(risk::PortfolioPricer(p).price({}).unique_contracts == 0);
+
+    book[17].option.K = -5.0;
+    bool threw = false;
+    try {
+        risk::PortfolioPricer(p).price(book);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
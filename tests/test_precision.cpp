@@ -0,0 +1,91 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/ImpliedVol.hpp"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+static double rel_err(double a, double b) { return std::fabs(a - b) / std::max(std::fabs(b), 1e-300); }
+
+// Contracts used across the existing test files
+static std::vector<std::pair<opt::Market, opt::Option>> european_contracts() {
+    return {
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}},
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Put, opt::Exercise::European}},
+        {opt::Market{100.0, 0.03, 0.01, 0.25}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}},
+        {opt::Market{120.0, 0.04, 0.02, 0.30}, opt::Option{110.0, 0.8, opt::OptionType::Call, opt::Exercise::European}},
+        {opt::Market{100.0, 0.05, 0.02, 0.35}, opt::Option{90.0, 0.75, opt::OptionType::Put, opt::Exercise::European}},
+    };
+}
+
+static std::vector<std::pair<opt::Market, opt::Option>> american_contracts() {
+    return {
+        {opt::Market{150.0, 0.05, 0.02, 0.20}, opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{150.0, 0.05, 0.02, 0.20}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+        {opt::Market{150.0, 0.01, 0.10, 1.0}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+        {opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+    };
+}
+
+TEST(test_float_bs_and_batch_match_double) {
+    const auto contracts = european_contracts();
+    const std::size_t n = contracts.size();
+
+    std::vector<float> S0(n), K(n), T(n), r(n), q(n), sigma(n), out(n);
+    std::vector<opt::OptionType> type(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& [m, o] = contracts[i];
+        S0[i] = float(m.S0); K[i] = float(o.K); T[i] = float(o.T);
+        r[i] = float(m.r); q[i] = float(m.q); sigma[i] = float(m.sigma); type[i] = o.type;
+    }
+    pricers::AnalyticBS::price_batch<float>(n, S0.data(), K.data(), T.data(), r.data(), q.data(),
+                                            sigma.data(), type.data(), out.data());
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& [m, o] = contracts[i];
+        const double ref = pricers::AnalyticBS::price(m, o);
+        const float single = pricers::AnalyticBS::price_as<float>(m, o);
+        REQUIRE(rel_err(single, ref) < 1e-5);
+        REQUIRE(out[i] == single);
+        REQUIRE(pricers::AnalyticBS::price_as<double>(m, o) == ref);
+    }
+}
+
+TEST(test_float_trees_match_double) {
+    pricers::TreeParams tp;
+    tp.steps = 2000;
+
+    for (const auto& [m, o] : european_contracts()) {
+        const double ref = pricers::BinomialCRR::price_european(m, o, tp);
+        REQUIRE(rel_err(pricers::BinomialCRR::price_european_as<float>(m, o, tp), ref) < 1e-5);
+    }
+    for (const auto& [m, o] : american_contracts()) {
+        const double ref = pricers::BinomialCRR::price_american(m, o, tp);
+        // sigma = 1 stresses the rounding of pu (drift error grows with sigma * sqrt(N))
+        REQUIRE(rel_err(pricers::BinomialCRR::price_american_as<float>(m, o, tp), ref) < 5e-5);
+    }
+}
+
+TEST(test_float_and_mixed_implied_vol) {
+    for (const auto& [m, o] : european_contracts()) {
+        const double target = pricers::AnalyticBS::price(m, o);
+        const double iv_double = pricers::ImpliedVol::solve_bs(m, o, target);
+        const float iv_float = pricers::ImpliedVol::solve_bs_as<float>(m, o, target);
+        const double iv_mixed = pricers::ImpliedVol::solve_bs_mixed(m, o, target);
+
+        REQUIRE_NEAR(iv_float, m.sigma, 1e-5);
+        REQUIRE_NEAR(iv_mixed, m.sigma, 1e-8);
+        REQUIRE_NEAR(iv_mixed, iv_double, 1e-8);
+    }
+
+    // Far below float resolution: the mixed solver hands over to the double solver
+    opt::Market m{100.0, 0.03, 0.0, 0.20};
+    opt::Option call{200.0, 0.5, opt::OptionType::Call, opt::Exercise::European};
+    const double target = pricers::AnalyticBS::price(m, call);
+    REQUIRE_NEAR(pricers::ImpliedVol::solve_bs_mixed(m, call, target), 0.20, 1e-6);
+}
@@ -0,0 +1,110 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/PriceCache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(test_price_cache_hits_return_tree_price) {
+    pricers::PriceCache cache;
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const opt::Option call{105.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+
+    const double direct = pricers::BinomialCRR::price_american(m, put, pricers::TreeParams{500});
+    REQUIRE(cache.price(m, put, 500) == direct);
+    REQUIRE(cache.price(m, put, 500) == direct);
+    REQUIRE(cache.price(m, call, 500) == pricers::BinomialCRR::price_european(m, call, pricers::TreeParams{500}));
+    (void)cache.price(m, put, 501); // N is part of the key
+
+    const pricers::PriceCacheStats st = cache.stats();
+    REQUIRE(st.hits == 1);
+    REQUIRE(st.misses == 3);
+    REQUIRE(st.size == 3);
+
+    cache.clear();
+    REQUIRE(cache.stats().size == 0);
+    REQUIRE(cache.price(m, put, 500) == direct);
+    REQUIRE(cache.stats().misses == 4);
+}
+
+TEST(test_price_cache_quantizes_keys) {
+    pricers::PriceCacheParams p;
+    p.spot_step = 0.01;
+    p.vol_step = 1e-4;
+    pricers::PriceCache cache(p);
+    const opt::Option put{100.0, 0.5, opt::OptionType::Put, opt::Exercise::American};
+
+    // Spots within half a tick share the entry, priced at the rounded spot
+    const double a = cache.price(opt::Market{100.0012, 0.03, 0.0, 0.25003}, put, 300);
+    const double b = cache.price(opt::Market{99.9961, 0.03, 0.0, 0.24996}, put, 300);
+    REQUIRE(a == b);
+    REQUIRE(a == pricers::BinomialCRR::price_american(opt::Market{100.0, 0.03, 0.0, 0.25}, put, pricers::TreeParams{300}));
+    (void)cache.price(opt::Market{100.01, 0.03, 0.0, 0.25}, put, 300);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 2);
+}
+
+TEST(test_price_cache_clock_eviction) {
+    pricers::PriceCacheParams p;
+    p.capacity = 4;
+    p.shards = 1;
+    int calls = 0;
+    pricers::PriceCache cache(p, [&](const opt::Market& m, const opt::Option&, int) {
+        ++calls;
+        return m.S0;
+    });
+    const opt::Option o{100.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+    auto at = [](double S0) { return opt::Market{S0, 0.0, 0.0, 0.2}; };
+
+    for (double S0 : {1.0, 2.0, 3.0, 4.0}) (void)cache.price(at(S0), o, 10);
+    REQUIRE(cache.price(at(1.0), o, 10) == 1.0); // sets 1's reference bit
+    (void)cache.price(at(5.0), o, 10);          // hand skips 1, evicts 2
+    REQUIRE(cache.stats().evictions == 1);
+    REQUIRE(cache.stats().size == 4);
+    REQUIRE(cache.price(at(1.0), o, 10) == 1.0);
+    REQUIRE(calls == 5);
+    (void)cache.price(at(2.0), o, 10);
+    REQUIRE(calls == 6);
+}
+
+TEST(test_price_cache_single_flight_and_errors) {
+    std::atomic<int> calls{0};
+    pricers::PriceCache cache(pricers::PriceCacheParams{}, [&](const opt::Market& m, const opt::Option&, int) {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (m.sigma < 0.0) throw std::invalid_argument("Volatility must be positive.");
+        return 42.0;
+    });
+    const opt::Option o{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const opt::Market m{100.0, 0.05, 0.0, 0.2};
+
+    std::vector<double> got(8, 0.0);
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < got.size(); ++t) pool.emplace_back([&, t] { got[t] = cache.price(m, o, 1000); });
+    for (auto& th : pool) th.join();
+    for (double v : got) REQUIRE(v == 42.0);
+    REQUIRE(calls == 1);
+    const pricers::PriceCacheStats st = cache.stats();
+    REQUIRE(st.misses == 1);
+    REQUIRE(st.hits + st.joins == 7);
+
+    // A failed price propagates and is not cached
+    const opt::Market bad{100.0, 0.05, 0.0, -0.2};
+    int threw = 0;
+    for (int i = 0; i < 2; ++i) {
+        try {
+            (void)cache.price(bad, o, 1000);
+        } catch (const std::invalid_argument&) {
+            ++threw;
+        }
+    }
+    REQUIRE(threw == 2);
+    REQUIRE(calls == 3);
+}
@@ -0,0 +1,156 @@
+#include "test_framework.hpp"
+
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "pricers/ImpliedVol.hpp"
+#include "pricers/Replay.hpp"
+#include "pricers/RequestLog.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<pricers::Request> sample_requests() {
+        const opt::Market m{100.0, 0.05, 0.02, 0.2};
+        std::vector<pricers::Request> reqs;
+        for (int i = 0; i < 30; ++i) {
+            pricers::Request req;
+            req.t_ns = 1000000LL * i;  // 1 ms apart
+            req.market = m;
+            req.option = opt::Option{90.0 + i, 0.5, (i % 2) ? opt::OptionType::Put : opt::OptionType::Call,
+                                     opt::Exercise::European};
+            req.steps = 200;
+            req.engine = static_cast<pricers::RequestEngine>(i % 3);  // bs, crr, lr
+            reqs.push_back(req);
+        }
+        return reqs;
+    }
+}
+
+TEST(test_request_log_round_trip) {
+    const std::string path = temp_path("optpricing_test_requests.bin");
+    std::remove(path.c_str());
+
+    pricers::Request req;
+    req.engine = pricers::RequestEngine::ImpliedVolCRR;
+    req.market = opt::Market{101.5, 0.03, 0.01, 0.25};
+    req.option = opt::Option{105.0, 0.75, opt::OptionType::Put, opt::Exercise::American};
+    req.steps = 500;
+    req.target = 9.125;
+    {
+        pricers::RequestRecorder rec(path);
+        rec.record(req);
+        REQUIRE(rec.recorded() == 1);
+    }
+    {
+        // Reopening appends after the existing records
+        pricers::RequestRecorder rec(path);
+        req.engine = pricers::RequestEngine::BjerksundStensland;
+        rec.record(req);
+    }
+    const std::vector<pricers::Request> back = pricers::RequestLog::read(path);
+    REQUIRE(back.size() == 2);
+    REQUIRE(std::filesystem::file_size(path) == pricers::RequestLog::header_size + 2 * pricers::RequestLog::record_size);
+    REQUIRE(back[0].engine == pricers::RequestEngine::ImpliedVolCRR);
+    REQUIRE(back[1].engine == pricers::RequestEngine::BjerksundStensland);
+    REQUIRE(back[0].t_ns > 0 && back[1].t_ns >= back[0].t_ns);
+    REQUIRE(back[1].market.S0 == 101.5 && back[1].market.sigma == 0.25 && back[1].option.K == 105.0);
+    REQUIRE(back[1].option.exercise == opt::Exercise::American && back[1].option.type == opt::OptionType::Put);
+    REQUIRE(back[1].steps == 500 && back[1].target == 9.125);
+
+    // A torn final record and a foreign file are both rejected
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "xyz";
+    }
+    bool threw = false;
+    try {
+        (void)pricers::RequestLog::read(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a capture file at all";
+    }
+    threw = false;
+    try {
+        pricers::RequestRecorder rec(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    std::remove(path.c_str());
+
+    REQUIRE(pricers::RequestLog::parse_engine("iv-crr") == pricers::RequestEngine::ImpliedVolCRR);
+    for (int e = 0; e < pricers::request_engine_count; ++e) {
+        const auto engine = static_cast<pricers::RequestEngine>(e);
+        REQUIRE(pricers::RequestLog::parse_engine(pricers::RequestLog::engine_name(engine)) == engine);
+    }
+}
+
+TEST(test_request_log_execute_matches_pricers) {
+    pricers::Request req;
+    req.market = opt::Market{100.0, 0.05, 0.02, 0.2};
+    req.option = opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    req.steps = 300;
+    req.engine = pricers::RequestEngine::CRR;
+    REQUIRE(pricers::RequestLog::execute(req) ==
+            pricers::BinomialCRR::price_american(req.market, req.option, pricers::TreeParams{300}));
+
+    req.option.exercise = opt::Exercise::European;
+    req.engine = pricers::RequestEngine::AnalyticBS;
+    const double bs = pricers::RequestLog::execute(req);
+    REQUIRE(bs == pricers::AnalyticBS::price(req.market, req.option));
+
+    req.engine = pricers::RequestEngine::ImpliedVolBS;
+    req.target = bs;
+    REQUIRE_NEAR(pricers::RequestLog::execute(req), 0.2, 1e-7);
+}
+
+TEST(test_replay_reports_per_engine) {
+    std::vector<pricers::Request> reqs = sample_requests();
+    reqs[4].option.K = -1.0;  // crr request that throws
+
+    pricers::ReplayParams p;
+    p.speed = 0.0;
+    const pricers::ReplayResult flat = pricers::Replay::run(reqs, p);
+    REQUIRE(flat.engines.size() == 3);
+    REQUIRE(flat.all.count == 30 && flat.all.failed == 1);
+    REQUIRE(flat.engines[1].engine == pricers::RequestEngine::CRR);
+    REQUIRE(flat.engines[1].count == 10 && flat.engines[1].failed == 1);
+    for (const pricers::ReplayEngineStats& s : flat.engines) {
+        REQUIRE(s.p50_us <= s.p90_us && s.p90_us <= s.p99_us && s.p99_us <= s.max_us);
+        REQUIRE(s.throughput > 0.0);
+    }
+
+    // Original timing: 29 ms of gaps, replayed at 2x on a two-worker daemon stand-in
+    p.speed = 2.0;
+    p.workers = 2;
+    const pricers::ReplayResult timed = pricers::Replay::run(reqs, p);
+    REQUIRE(timed.all.count == 30 && timed.all.failed == 1);
+    REQUIRE(timed.seconds >= 0.0145);
+
+    const std::string csv = pricers::Replay::to_csv(timed);
+    REQUIRE(csv.find("engine,count,failed,throughput") == 0);
+    REQUIRE(csv.find("\ncrr,10,1,") != std::string::npos);
+    REQUIRE(csv.find("\nall,30,1,") != std::string::npos);
+
+    bool threw = false;
+    try {
+        p.speed = -1.0;
+        (void)pricers::Replay::run(reqs, p);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
@@ -0,0 +1,127 @@
+#include "test_framework.hpp"
+
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/EngineRouter.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Fixed costs (roughly one core's calibration) so the routing tests are deterministic
+    pricers::RouterCostModel fixed_costs() {
+        pricers::RouterCostModel c;
+        c.bs_us = 0.05;
+        c.bs02_us = 10.0;
+        c.alo_fast_us = 70.0;
+        c.alo_us = 1000.0;
+        c.crr_fixed_us = 5.0;
+        c.crr_node_ns = 0.7;
+        c.lr_fixed_us = 12.0;
+        c.lr_node_ns = 0.9;
+        return c;
+    }
+}
+
+TEST(test_router_closed_form_when_exact) {
+    const pricers::EngineRouter router(fixed_costs());
+    const opt::Market m{100.0, 0.05, 0.0, 0.25};
+
+    const opt::Option eu{105.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+    const pricers::RoutedPrice a = router.price(m, eu, 1e-12);
+    REQUIRE(a.decision.engine == pricers::RequestEngine::AnalyticBS);
+    REQUIRE(a.decision.meets_target && a.decision.predicted_error == 0.0);
+    REQUIRE(a.price == pricers::AnalyticBS::price(m, eu));
+
+    // An American call without dividends is never exercised early
+    const opt::Option am{105.0, 1.0, opt::OptionType::Call, opt::Exercise::American};
+    const pricers::RoutedPrice b = router.price(m, am, 1e-6);
+    REQUIRE(b.decision.engine == pricers::RequestEngine::AnalyticBS);
+    REQUIRE(b.price == a.price);
+}
+
+TEST(test_router_meets_target_at_least_cost) {
+    const pricers::EngineRouter router(fixed_costs());
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    // kappa below 5, where accurate ALO reaches every target here
+    const opt::Market markets[] = {
+        {100.0, 0.05, 0.02, 0.20},
+        {90.0, 0.03, 0.0, 0.35},
+        {110.0, 0.08, 0.01, 0.20},
+    };
+    for (const opt::Market& m : markets) {
+        const double ref = pricers::AndersenLakeOffengelt::price(m, put, pricers::ALOParams{48, 16, 64, 96});
+        double last_cost = 0.0;
+        for (double tol : {0.05, 5e-3, 1e-4, 2e-5}) {
+            const pricers::RoutedPrice r = router.price(m, put, tol);
+            REQUIRE(r.decision.meets_target);
+            REQUIRE(r.decision.predicted_error <= tol);
+            REQUIRE(std::fabs(r.price - ref) <= tol);
+            // Tighter targets never get cheaper
+            REQUIRE(r.decision.predicted_cost_us >= last_cost);
+            last_cost = r.decision.predicted_cost_us;
+        }
+    }
+
+    // Loose: the smallest CRR tree that meets it; tight: the fast ALO
+    const opt::Market m = markets[0];
+    const pricers::RouteDecision loose = router.route(m, put, 0.05);
+    REQUIRE(loose.engine == pricers::RequestEngine::CRR);
+    const double scale = m.S0 * m.sigma * std::sqrt(put.T);
+    REQUIRE(loose.steps == static_cast<int>(std::ceil(0.15 * scale / 0.05)));
+    REQUIRE(pricers::EngineRouter::predicted_error(m, put, pricers::RequestEngine::CRR, loose.steps - 1) > 0.05);
+    REQUIRE(router.route(m, put, 1e-4).engine == pricers::RequestEngine::ALOFast);
+}
+
+TEST(test_router_steep_boundary_within_target) {
+    const pricers::EngineRouter router(fixed_costs());
+    // kappa ~ 9.7: a put, and the call that mirrors it through put-call symmetry
+    struct Case { opt::Market m; opt::Option o; };
+    const Case cases[] = {
+        {opt::Market{100.0, 0.117, 0.0, 0.155}, opt::Option{100.0, 2.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{106.4, 0.005, 0.117, 0.155}, opt::Option{100.0, 2.0, opt::OptionType::Call, opt::Exercise::American}},
+    };
+    for (const Case& c : cases) {
+        const double ref = pricers::AndersenLakeOffengelt::price(c.m, c.o, pricers::ALOParams{64, 32, 128, 256});
+
+        // The ALO bounds cover the actual errors
+        const double alo = pricers::AndersenLakeOffengelt::price(c.m, c.o);
+        const double fast = pricers::AndersenLakeOffengelt::price(c.m, c.o, pricers::ALOParams::fast());
+        REQUIRE(std::fabs(alo - ref) <= pricers::EngineRouter::predicted_error(c.m, c.o, pricers::RequestEngine::ALO, 0));
+        REQUIRE(std::fabs(fast - ref) <= pricers::EngineRouter::predicted_error(c.m, c.o, pricers::RequestEngine::ALOFast, 0));
+
+        for (double tol : {5e-3, 1e-3}) {
+            const pricers::RoutedPrice r = router.price(c.m, c.o, tol);
+            REQUIRE(r.decision.meets_target);
+            REQUIRE(std::fabs(r.price - ref) <= tol);
+        }
+    }
+}
+
+TEST(test_router_unreachable_target_and_errors) {
+    pricers::RouterParams p;
+    p.max_steps = 2000;
+    const pricers::EngineRouter router(fixed_costs(), p);
+
+    // Low vol and high rate (kappa = 2 r / sigma^2 = 24): the closed forms are poor, and a 1e-6
+    // target needs more tree steps than allowed
+    const opt::Market m{100.0, 0.12, 0.0, 0.10};
+    const opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const pricers::RouteDecision d = router.route(m, put, 1e-6);
+    REQUIRE(!d.meets_target);
+    REQUIRE(d.engine == pricers::RequestEngine::LeisenReimer && d.steps <= 2000);
+    REQUIRE(std::isinf(pricers::EngineRouter::predicted_error(m, put, pricers::RequestEngine::BjerksundStensland, 0)));
+
+    bool threw = false;
+    try {
+        router.route(m, put, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+
+    // The calibration produces a usable model on this machine
+    const pricers::RouterCostModel c = pricers::EngineRouter::calibrate();
+    REQUIRE(c.bs_us > 0.0 && c.bs_us < c.alo_us);
+    REQUIRE(c.crr_node_ns > 0.0 && c.lr_node_ns > 0.0);
+}
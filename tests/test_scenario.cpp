@@ -0,0 +1,107 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/BinomialCRR.hpp"
+#include "risk/ScenarioEngine.hpp"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+static risk::ShockGrid small_grid() {
+    risk::ShockGrid g;
+    g.spot_shocks = {-0.10, -0.05, -0.013, 0.0, 0.02, 0.05, 0.10};
+    g.vol_shocks = {-0.05, 0.0, 0.05};
+    return g;
+}
+
+TEST(test_scenario_european_matches_repricing) {
+    const risk::ShockGrid grid = small_grid();
+    risk::ScenarioEngine engine(grid);
+
+    std::vector<risk::Position> book{
+        {"c1", opt::Market{100.0, 0.03, 0.01, 0.25}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}, 3.0},
+        {"p1", opt::Market{100.0, 0.03, 0.01, 0.25}, opt::Option{95.0, 0.5, opt::OptionType::Put, opt::Exercise::European}, -2.0},
+    };
+    const risk::PnLCube& cube = engine.run(book);
+
+    REQUIRE(cube.n_positions == 2);
+    for (std::size_t p = 0; p < book.size(); ++p) {
+        const double base = pricers::AnalyticBS::price(book[p].market, book[p].option);
+        for (std::size_t v = 0; v < grid.vol_shocks.size(); ++v) {
+            for (std::size_t s = 0; s < grid.spot_shocks.size(); ++s) {
+                opt::Market m = book[p].market;
+                m.S0 *= 1.0 + grid.spot_shocks[s];
+                m.sigma += grid.vol_shocks[v];
+                const double expected = book[p].quantity * (pricers::AnalyticBS::price(m, book[p].option) - base);
+                REQUIRE_NEAR(cube.at(p, v, s), expected, 1e-10);
+            }
+        }
+    }
+}
+
+TEST(test_scenario_american_close_to_per_cell_trees) {
+    const risk::ShockGrid grid = small_grid();
+    risk::ScenarioParams sp;
+    sp.tree_steps = 2000;
+    risk::ScenarioEngine engine(grid, sp);
+
+    const opt::Market m0{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+    const std::vector<double> unit = engine.unit_pnl(m0, put);
+
+    pricers::TreeParams tp;
+    tp.steps = sp.tree_steps;
+    const double base = pricers::BinomialCRR::price_american(m0, put, tp);
+
+    double max_err = 0.0;
+    for (std::size_t v = 0; v < grid.vol_shocks.size(); ++v) {
+        for (std::size_t s = 0; s < grid.spot_shocks.size(); ++s) {
+            opt::Market m = m0;
+            m.S0 *= 1.0 + grid.spot_shocks[s];
+            m.sigma += grid.vol_shocks[v];
+            const double brute = pricers::BinomialCRR::price_american(m, put, tp) - base;
+            max_err = std::max(max_err, std::fabs(unit[v * grid.spot_shocks.size() + s] - brute));
+        }
+    }
+    // Per-cell trees place the strike differently within the lattice, so they differ from the
+    // ladder by the usual CRR oscillation; same budget as the tree convergence tests.
+    REQUIRE(max_err < 5e-3);
+
+    // Zero shock lands exactly on the ladder's centre node
+    REQUIRE_NEAR(unit[1 * grid.spot_shocks.size() + 3], 0.0, 1e-12);
+}
+
+TEST(test_scenario_incremental_rerun) {
+    risk::ScenarioParams sp;
+    sp.tree_steps = 200;
+    risk::ScenarioEngine engine(small_grid(), sp);
+
+    std::vector<risk::Position> book{
+        {"a", opt::Market{100.0, 0.03, 0.01, 0.25}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}, 1.0},
+        {"b", opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American}, 1.0},
+        {"c", opt::Market{50.0, 0.02, 0.00, 0.40}, opt::Option{55.0, 0.25, opt::OptionType::Put, opt::Exercise::European}, 1.0},
+    };
+
+    engine.run(book);
+    REQUIRE(engine.last_run_stats().repriced == 3);
+    const double b_cell = engine.cube().at(1, 2, 0);
+
+    engine.run(book);
+    REQUIRE(engine.last_run_stats().repriced == 0);
+    REQUIRE(engine.last_run_stats().reused == 3);
+
+    // Quantity only rescales cached values
+    book[1].quantity = -4.0;
+    engine.run(book);
+    REQUIRE(engine.last_run_stats().repriced == 0);
+    REQUIRE_NEAR(engine.cube().at(1, 2, 0), -4.0 * b_cell, 1e-12);
+
+    // A contract change reprices just that position
+    book[2].market.S0 = 51.0;
+    engine.run(book);
+    REQUIRE(engine.last_run_stats().repriced == 1);
+    REQUIRE(engine.last_run_stats().reused == 2);
+}
@@ -0,0 +1,207 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/ChebyshevSurrogate.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using pricers::ChebyshevSurrogate;
+
+static double alo_fast(const opt::Market& m, const opt::Option& o) {
+    return pricers::AndersenLakeOffengelt::price(m, o, pricers::ALOParams::fast());
+}
+
+static double alo_fast_boundary(const opt::Market& m, const opt::Option& o) {
+    return pricers::AndersenLakeOffengelt::exercise_boundary(m, o, {o.T}, pricers::ALOParams::fast())[0];
+}
+
+static pricers::SurrogateDomain small_domain() {
+    pricers::SurrogateDomain d;
+    d.moneyness = {0.8, 1.25, 6, 3};
+    d.sigma = {0.15, 0.45, 4, 2};
+    d.T = {0.25, 1.5, 4, 2};
+    d.r = {0.05, 0.05, 0, 1};
+    d.q = {0.01, 0.01, 0, 1};
+    return d;
+}
+
+static ChebyshevSurrogate american_put_surrogate() {
+    pricers::SurrogateBuildParams p;
+    p.exercise_boundary = alo_fast_boundary;
+    return ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, small_domain(), p);
+}
+
+static std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(test_surrogate_european_matches_bs_within_bound) {
+    pricers::SurrogateDomain d = small_domain();
+    d.moneyness.degree = 12;
+    pricers::SurrogateBuildParams p;
+    p.european_control = false; // tabulate the BS price itself
+    const pricers::PricerFn bs = [](const opt::Market& m, const opt::Option& o) { return pricers::AnalyticBS::price(m, o); };
+    const auto s = ChebyshevSurrogate::build(bs, opt::OptionType::Call, opt::Exercise::European, d, p);
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (int i = 0; i < 200; ++i) {
+        opt::Market m{100.0, 0.05, 0.01, 0.15 + 0.3 * u(rng)};
+        opt::Option o{100.0 / (0.8 + 0.45 * u(rng)), 0.25 + 1.25 * u(rng), opt::OptionType::Call, opt::Exercise::European};
+        REQUIRE(s.in_domain(m, o));
+        REQUIRE_NEAR(s.price(m, o) / o.K, pricers::AnalyticBS::price(m, o) / o.K, s.error_bound());
+    }
+    REQUIRE(s.error_bound() < 5e-5);
+}
+
+TEST(test_surrogate_american_put_within_reported_bound) {
+    const auto s = american_put_surrogate();
+    REQUIRE(s.front_fixed());
+    REQUIRE(s.error_bound() < 1e-4);
+
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    double worst = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        opt::Market m{80.0 + 45.0 * u(rng), 0.05, 0.01, 0.15 + 0.3 * u(rng)};
+        opt::Option o{100.0, 0.25 + 1.25 * u(rng), opt::OptionType::Put, opt::Exercise::American};
+        worst = std::fmax(worst, std::fabs(s.price(m, o) - alo_fast(m, o)) / o.K);
+    }
+    // The bound is the worst validation error, so fresh points may exceed it slightly
+    REQUIRE(worst <= 2.0 * s.error_bound());
+
+    // Deep in the exercise region the surrogate returns intrinsic value exactly
+    opt::Market deep{80.0, 0.05, 0.01, 0.15};
+    opt::Option put{100.0, 0.25, opt::OptionType::Put, opt::Exercise::American};
+    REQUIRE_NEAR(s.price(deep, put), 20.0, 1e-12);
+}
+
+TEST(test_surrogate_save_load_roundtrip) {
+    const auto s = american_put_surrogate();
+    const std::string path = temp_path("optpricing_test_surrogate.bin");
+    s.save(path);
+    const auto l = ChebyshevSurrogate::load(path);
+    std::remove(path.c_str()); // the mapping outlives the directory entry
+
+    REQUIRE(l.coefficient_count() == s.coefficient_count());
+    REQUIRE(l.front_fixed());
+    REQUIRE(l.type() == opt::OptionType::Put);
+    REQUIRE(l.exercise() == opt::Exercise::American);
+    REQUIRE(l.error_bound() == s.error_bound());
+    REQUIRE(l.domain().sigma.pieces == 2);
+    for (double x : {0.82, 0.95, 1.0, 1.1, 1.24}) {
+        for (double T : {0.3, 0.9, 1.4}) REQUIRE(l.eval(x, 0.3, T, 0.05, 0.01) == s.eval(x, 0.3, T, 0.05, 0.01));
+    }
+
+    // Corrupt and missing files are rejected
+    const std::string bad = temp_path("optpricing_test_surrogate_bad.bin");
+    {
+        std::ofstream out(bad, std::ios::binary);
+        out << "NOTATABLE and some padding to get past the header size check ................"
+               "................................................................................"
+               "................................................................................";
+    }
+    bool threw_bad = false, threw_missing = false;
+    try {
+        (void)ChebyshevSurrogate::load(bad);
+    } catch (const std::runtime_error&) {
+        threw_bad = true;
+    }
+    std::remove(bad.c_str());
+    try {
+        (void)ChebyshevSurrogate::load(temp_path("optpricing_test_surrogate_missing.bin"));
+    } catch (const std::runtime_error&) {
+        threw_missing = true;
+    }
+    REQUIRE(threw_bad);
+    REQUIRE(threw_missing);
+}
+
+TEST(test_surrogate_falls_back_outside_domain) {
+    auto s = american_put_surrogate();
+    opt::Market m{100.0, 0.05, 0.01, 0.30};
+    opt::Option far{100.0, 3.0, opt::OptionType::Put, opt::Exercise::American};   // T beyond the domain
+    opt::Option call{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}; // wrong type
+    opt::Market other_rate{100.0, 0.03, 0.01, 0.30};                                // off the pinned rate
+    opt::Option put{100.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    REQUIRE(!s.in_domain(m, far));
+    REQUIRE(!s.in_domain(m, call));
+    REQUIRE(!s.in_domain(other_rate, put));
+    REQUIRE(s.price(m, far) == alo_fast(m, far));
+    REQUIRE(s.price(m, call) == alo_fast(m, call));
+    REQUIRE(s.price(other_rate, put) == alo_fast(other_rate, put));
+
+    // A loaded table has no fallback until one is installed
+    const std::string path = temp_path("optpricing_test_surrogate_fallback.bin");
+    s.save(path);
+    auto l = ChebyshevSurrogate::load(path);
+    std::remove(path.c_str());
+    bool threw = false;
+    try {
+        (void)l.price(m, far);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    l.set_fallback(alo_fast);
+    REQUIRE(l.price(m, far) == alo_fast(m, far));
+}
+
+TEST(test_surrogate_parallel_build_is_deterministic) {
+    pricers::SurrogateBuildParams serial;
+    serial.threads = 1;
+    serial.exercise_boundary = alo_fast_boundary;
+    pricers::SurrogateBuildParams parallel = serial;
+    parallel.threads = 4;
+    const auto a = ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, small_domain(), serial);
+    const auto b = ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, small_domain(), parallel);
+    REQUIRE(a.validation_error() == b.validation_error());
+    REQUIRE(a.eval(0.97, 0.22, 0.8, 0.05, 0.01) == b.eval(0.97, 0.22, 0.8, 0.05, 0.01));
+}
+
+TEST(test_surrogate_rejects_bad_domain) {
+    bool threw_pinned = false, threw_pieces = false, threw_boundary = false, threw_carry = false;
+    pricers::SurrogateDomain d = small_domain();
+    d.r = {0.01, 0.05, 0, 1};
+    try {
+        (void)ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, d);
+    } catch (const std::invalid_argument&) {
+        threw_pinned = true;
+    }
+    d = small_domain();
+    d.sigma.pieces = 0;
+    try {
+        (void)ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, d);
+    } catch (const std::invalid_argument&) {
+        threw_pieces = true;
+    }
+    pricers::SurrogateBuildParams p;
+    p.exercise_boundary = alo_fast_boundary;
+    try {
+        (void)ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::European, small_domain(), p);
+    } catch (const std::invalid_argument&) {
+        threw_boundary = true;
+    }
+    // Rate axis at zero: the put is never exercised early, so the table would be European
+    d = small_domain();
+    d.r = {0.0, 0.0, 0, 1};
+    try {
+        (void)ChebyshevSurrogate::build(alo_fast, opt::OptionType::Put, opt::Exercise::American, d);
+    } catch (const std::invalid_argument&) {
+        threw_carry = true;
+    }
+    REQUIRE(threw_pinned);
+    REQUIRE(threw_pieces);
+    REQUIRE(threw_boundary);
+    REQUIRE(threw_carry);
+}
@@ -4,10 +4,15 @@
 #include "opt/Option.hpp"
 #include "pricers/BinomialCRR.hpp"
 #include "pricers/AnalyticBS.hpp"
+#include "pricers/AndersenLakeOffengelt.hpp"
+#include "pricers/ConvergenceStudy.hpp"
+#include "pricers/LeisenReimer.hpp"
 
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 
 static double abs_err(double a, double b) { return std::fabs(a - b); }
 
@@ -59,4 +64,68 @@ TEST(test_tree_converges_to_bs_put_with_dividends) {
 
     // Puts + longer maturity can converge slower; allow a looser tol
     run_convergence_case(m, put, Ns, /*final_tol=*/5e-3, /*final_N=*/2000);
-}
\ No newline at end of file
+}
+
+TEST(test_convergence_study_matches_direct_pricers) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.20};
+    const opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    pricers::ConvergenceParams cp;
+    cp.steps = pricers::ConvergenceStudy::step_range(50, 450, 100);
+    cp.engines = {pricers::TreeEngine::CRR, pricers::TreeEngine::LeisenReimer, pricers::TreeEngine::CRRTruncated};
+    cp.threads = 3;
+    const auto res = pricers::ConvergenceStudy::run(m, put, cp);
+
+    REQUIRE(res.reference_name == "ALO(64,32,128,256)");
+    REQUIRE(res.reference == pricers::AndersenLakeOffengelt::price(m, put, pricers::ALOParams::reference()));
+    REQUIRE(res.points.size() == 15);
+    for (std::size_t i = 0; i < res.points.size(); ++i) {
+        const auto& pt = res.points[i];
+        REQUIRE(pt.steps == 50 + 100 * static_cast<int>(i % 5));
+        pricers::TreeParams tp{pt.steps};
+        double direct = 0.0;
+        if (pt.engine == pricers::TreeEngine::LeisenReimer) {
+            REQUIRE(pt.steps_used == pt.steps + 1);
+            direct = pricers::LeisenReimer::price_american(m, put, tp);
+        } else {
+            if (pt.engine == pricers::TreeEngine::CRRTruncated) tp.truncation_stddevs = cp.truncation_stddevs;
+            direct = pricers::BinomialCRR::price_american(m, put, tp);
+        }
+        REQUIRE(pt.price == direct);
+        REQUIRE(pt.error == pt.price - res.reference);
+        REQUIRE(pt.seconds > 0.0);
+    }
+
+    // One CSV row per point plus the header; European runs are measured against BS
+    const std::string csv = pricers::ConvergenceStudy::to_csv(res);
+    REQUIRE(std::count(csv.begin(), csv.end(), '\n') == 16);
+    REQUIRE(csv.find(",ALO(64,32,128,256)\n") != std::string::npos);
+    const opt::Option call{105.0, 1.0, opt::OptionType::Call, opt::Exercise::European};
+    REQUIRE(pricers::ConvergenceStudy::run(m, call, cp).reference == pricers::AnalyticBS::price(m, call));
+}
+
+TEST(test_convergence_study_rejects_bad_input) {
+    bool threw_range = false, threw_engine = false, threw_steps = false;
+    try {
+        (void)pricers::ConvergenceStudy::step_range(100, 50, 10);
+    } catch (const std::invalid_argument&) {
+        threw_range = true;
+    }
+    try {
+        (void)pricers::ConvergenceStudy::parse_engine("jr");
+    } catch (const std::invalid_argument&) {
+        threw_engine = true;
+    }
+    try {
+        pricers::ConvergenceParams cp;
+        cp.steps = {100, 0};
+        (void)pricers::ConvergenceStudy::run(opt::Market{100.0, 0.05, 0.0, 0.2},
+                                             opt::Option{100.0, 1.0, opt::OptionType::Put, opt::Exercise::European}, cp);
+    } catch (const std::invalid_argument&) {
+        threw_steps = true;
+    }
+    REQUIRE(threw_range);
+    REQUIRE(threw_engine);
+    REQUIRE(threw_steps);
+    REQUIRE(pricers::ConvergenceStudy::parse_engine(pricers::ConvergenceStudy::engine_name(pricers::TreeEngine::CRRTruncated)) == pricers::TreeEngine::CRRTruncated);
+}
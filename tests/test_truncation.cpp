@@ -0,0 +1,66 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <cmath>
+#include <vector>
+
+static double tree_price(const opt::Market& m, const opt::Option& o, const pricers::TreeParams& tp) {
+    return (o.exercise == opt::Exercise::American) ? pricers::BinomialCRR::price_american(m, o, tp)
+                                                   : pricers::BinomialCRR::price_european(m, o, tp);
+}
+
+TEST(test_truncated_lattice_matches_full_tree) {
+    struct Case { opt::Market m; opt::Option o; };
+    const std::vector<Case> cases{
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}},
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Put, opt::Exercise::European}},
+        {opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{150.0, 0.01, 0.10, 1.0}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+        // Strike outside the band: edges are out of the money on one side, deep in on the other
+        {opt::Market{100.0, 0.03, 0.00, 0.10}, opt::Option{200.0, 0.5, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{100.0, 0.03, 0.00, 0.10}, opt::Option{40.0, 0.5, opt::OptionType::Call, opt::Exercise::European}},
+    };
+
+    for (const auto& c : cases) {
+        pricers::TreeParams full;
+        full.steps = 3000;
+        pricers::TreeParams trunc = full;
+        trunc.truncation_stddevs = 8.0;
+
+        REQUIRE_NEAR(tree_price(c.m, c.o, trunc), tree_price(c.m, c.o, full), 1e-9);
+    }
+}
+
+TEST(test_truncated_lattice_error_shrinks_with_band) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    pricers::TreeParams full;
+    full.steps = 2000;
+    const double ref = tree_price(m, put, full);
+
+    double prev = 1e300;
+    for (double k : {3.0, 4.0, 5.0, 6.0}) {
+        pricers::TreeParams tp = full;
+        tp.truncation_stddevs = k;
+        const double err = std::fabs(tree_price(m, put, tp) - ref);
+        REQUIRE(err <= prev);
+        prev = err;
+    }
+    REQUIRE(prev < 1e-6);
+}
+
+TEST(test_truncated_lattice_wide_band_is_full_tree) {
+    opt::Market m{100.0, 0.05, 0.02, 0.20};
+    opt::Option put{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American};
+
+    pricers::TreeParams full;
+    full.steps = 50;
+    pricers::TreeParams wide = full;
+    wide.truncation_stddevs = 100.0; // band wider than the tree
+
+    REQUIRE(tree_price(m, put, wide) == tree_price(m, put, full));
+}
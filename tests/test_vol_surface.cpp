@@ -0,0 +1,167 @@
+#include "test_framework.hpp"
+
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "opt/VolSurface.hpp"
+#include "pricers/AnalyticBS.hpp"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using opt::SVIParams;
+using opt::SmileSlice;
+using opt::VolSurface;
+
+static const double EXPIRIES[] = {0.1, 0.25, 0.5, 1.0, 2.0};
+
+static SVIParams true_svi(double T) {
+    return SVIParams{0.03 * T, 0.1 * std::sqrt(T), -0.5, 0.02, 0.15};
+}
+
+static SmileSlice svi_slice(double T, const SVIParams& p, double noise = 0.0, unsigned seed = 1) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> z(0.0, 1.0);
+    SmileSlice s;
+    s.T = T;
+    s.forward = 100.0 * std::exp(0.02 * T);
+    for (int i = 0; i < 25; ++i) {
+        const double k = -0.8 + 1.6 * i / 24.0;
+        s.strikes.push_back(s.forward * std::exp(k));
+        s.ivs.push_back(std::sqrt(p.w(k) / T) + noise * z(rng));
+    }
+    return s;
+}
+
+static std::vector<SmileSlice> svi_chain(double noise = 0.0) {
+    std::vector<SmileSlice> chain;
+    unsigned seed = 1;
+    for (double T : EXPIRIES) chain.push_back(svi_slice(T, true_svi(T), noise, seed++));
+    return chain;
+}
+
+TEST(test_svi_fit_recovers_parameters) {
+    for (double T : EXPIRIES) {
+        const SVIParams truth = true_svi(T);
+        const auto fit = VolSurface::fit_svi(svi_slice(T, truth));
+        REQUIRE(fit.rmse_vol < 1e-10);
+        REQUIRE_NEAR(fit.params.a, truth.a, 1e-7);
+        REQUIRE_NEAR(fit.params.b, truth.b, 1e-7);
+        REQUIRE_NEAR(fit.params.rho, truth.rho, 1e-7);
+        REQUIRE_NEAR(fit.params.m, truth.m, 1e-7);
+        REQUIRE_NEAR(fit.params.s, truth.s, 1e-7);
+    }
+
+    // Noisy quotes: the fit error sits at the noise level, and a warm start lands on the same fit
+    const SmileSlice noisy = svi_slice(0.5, true_svi(0.5), 5e-4, 9);
+    const auto cold = VolSurface::fit_svi(noisy);
+    REQUIRE(cold.rmse_vol < 1e-3);
+    const SVIParams near = true_svi(0.5);
+    const auto warm = VolSurface::fit_svi(noisy, {}, &near);
+    REQUIRE_NEAR(warm.rmse_vol, cold.rmse_vol, 1e-9);
+}
+
+TEST(test_vol_surface_interpolates_total_variance) {
+    const auto surf = VolSurface::calibrate(svi_chain());
+    REQUIRE(surf.expiries().size() == 5);
+    REQUIRE(surf.calendar_repairs() == 0);
+
+    // On an expiry the cached lookup reproduces the slice
+    for (double T : EXPIRIES) {
+        const SVIParams p = true_svi(T);
+        for (double k = -1.5; k <= 1.5; k += 0.05) {
+            const double K = surf.forward(T) * std::exp(k);
+            REQUIRE_NEAR(surf.sigma(K, T), std::sqrt(p.w(k) / T), 1e-6);
+        }
+    }
+
+    // Between expiries total variance is linear in T at fixed k = ln(K/F(T)); before the first
+    // expiry it scales with T
+    for (double k : {-0.6, 0.0, 0.4}) {
+        const double T = 0.75;
+        const double w = surf.total_variance(surf.forward(T) * std::exp(k), T);
+        REQUIRE_NEAR(w, 0.5 * true_svi(0.5).w(k) + 0.5 * true_svi(1.0).w(k), 1e-8);
+        const double w0 = surf.total_variance(surf.forward(0.05) * std::exp(k), 0.05);
+        REQUIRE_NEAR(w0, 0.5 * true_svi(0.1).w(k), 1e-8);
+    }
+    REQUIRE_NEAR(surf.forward(0.75), 100.0 * std::exp(0.02 * 0.75), 1e-10);
+}
+
+TEST(test_vol_surface_removes_calendar_arbitrage) {
+    // The 1y slice sits below the 6m slice in the wings, so its nodes there are lifted
+    auto chain = svi_chain();
+    chain[3] = svi_slice(1.0, SVIParams{0.03, 0.02, -0.5, 0.02, 0.15});
+    const auto surf = VolSurface::calibrate(chain);
+    REQUIRE(surf.calendar_repairs() > 0);
+    for (double k = -2.5; k <= 2.5; k += 0.01) {
+        double prev = 0.0;
+        for (double T = 0.02; T <= 3.0; T += 0.02) {
+            const double w = surf.total_variance(surf.forward(T) * std::exp(k), T);
+            REQUIRE(w >= prev - 1e-12);
+            prev = w;
+        }
+    }
+}
+
+TEST(test_vol_surface_batch_feeds_pricers) {
+    opt::SVICalibrationParams serial;
+    serial.threads = 1;
+    opt::SVICalibrationParams parallel;
+    parallel.threads = 4;
+    const auto chain = svi_chain(5e-4);
+    const auto surf = VolSurface::calibrate(chain, serial);
+    const auto surf_mt = VolSurface::calibrate(chain, parallel);
+
+    // Warm recalibration from the previous fit lands on the cold fit
+    auto again = VolSurface::calibrate(svi_chain(), serial);
+    again.recalibrate(chain, serial);
+
+    const std::size_t n = 64;
+    std::vector<double> K(n), T(n), sig(n), S0(n, 100.0), r(n, 0.02), q(n, 0.0), out(n);
+    std::vector<opt::OptionType> type(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        K[i] = 70.0 + i;
+        T[i] = 0.05 + 0.04 * i;
+        type[i] = (i % 2) ? opt::OptionType::Put : opt::OptionType::Call;
+    }
+    surf.sigma_batch(n, K.data(), T.data(), sig.data());
+    pricers::AnalyticBS::price_batch(n, S0.data(), K.data(), T.data(), r.data(), q.data(), sig.data(), type.data(), out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(sig[i] == surf.sigma(K[i], T[i]));
+        REQUIRE(sig[i] == surf_mt.sigma(K[i], T[i]));
+        REQUIRE_NEAR(again.sigma(K[i], T[i]), sig[i], 1e-8);
+        const opt::Market m{100.0, 0.02, 0.0, sig[i]};
+        REQUIRE_NEAR(out[i], pricers::AnalyticBS::price(m, opt::Option{K[i], T[i], type[i], opt::Exercise::European}), 1e-10);
+    }
+}
+
+TEST(test_vol_surface_rejects_bad_input) {
+    bool threw_short = false, threw_dup = false, threw_recal = false;
+    SmileSlice s = svi_slice(1.0, true_svi(1.0));
+    s.strikes.resize(4);
+    s.ivs.resize(4);
+    try {
+        (void)VolSurface::fit_svi(s);
+    } catch (const std::invalid_argument&) {
+        threw_short = true;
+    }
+    auto chain = svi_chain();
+    chain[1].T = chain[0].T;
+    try {
+        (void)VolSurface::calibrate(chain);
+    } catch (const std::invalid_argument&) {
+        threw_dup = true;
+    }
+    auto surf = VolSurface::calibrate(svi_chain());
+    chain = svi_chain();
+    chain.pop_back();
+    try {
+        surf.recalibrate(chain);
+    } catch (const std::invalid_argument&) {
+        threw_recal = true;
+    }
+    REQUIRE(threw_short);
+    REQUIRE(threw_dup);
+    REQUIRE(threw_recal);
+}
@@ -0,0 +1,68 @@
+#include "test_framework.hpp"
+
+#include "opt/Curve.hpp"
+#include "opt/Market.hpp"
+#include "opt/Option.hpp"
+#include "pricers/BinomialCRR.hpp"
+
+#include <vector>
+
+static double tree_price(const opt::Market& m, const opt::Option& o, const pricers::TreeParams& tp) {
+    return (o.exercise == opt::Exercise::American) ? pricers::BinomialCRR::price_american(m, o, tp)
+                                                   : pricers::BinomialCRR::price_european(m, o, tp);
+}
+
+TEST(test_wavefront_is_bit_identical_to_serial) {
+    struct Case { opt::Market m; opt::Option o; };
+    const std::vector<Case> cases{
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Call, opt::Exercise::European}},
+        {opt::Market{100.0, 0.03, 0.01, 0.20}, opt::Option{105.0, 1.5, opt::OptionType::Put, opt::Exercise::European}},
+        {opt::Market{100.0, 0.05, 0.02, 0.20}, opt::Option{105.0, 1.0, opt::OptionType::Put, opt::Exercise::American}},
+        {opt::Market{150.0, 0.01, 0.10, 0.30}, opt::Option{100.0, 1.0, opt::OptionType::Call, opt::Exercise::American}},
+    };
+
+    // Odd N leaves a ragged last band and column block; N = 100 is a single tile
+    for (int N : {100, 3001}) {
+        for (const auto& c : cases) {
+            pricers::TreeParams serial;
+            serial.steps = N;
+            const double expected = tree_price(c.m, c.o, serial);
+            // Counts past the cores or the tile columns are capped
+            for (unsigned threads : {2u, 4u, 7u, 100000u}) {
+                pricers::TreeParams par = serial;
+                par.threads = threads;
+                REQUIRE(tree_price(c.m, c.o, par) == expected);
+            }
+        }
+    }
+}
+
+TEST(test_wavefront_float_and_curves_match_serial) {
+    const opt::Market m{100.0, 0.05, 0.02, 0.25};
+    const opt::Option am{100.0, 2.0, opt::OptionType::Put, opt::Exercise::American};
+    const opt::Option eu{100.0, 2.0, opt::OptionType::Call, opt::Exercise::European};
+    pricers::TreeParams serial;
+    serial.steps = 2049;
+    pricers::TreeParams par = serial;
+    par.threads = 3;
+
+    REQUIRE(pricers::BinomialCRR::price_american_as<float>(m, am, par) == pricers::BinomialCRR::price_american_as<float>(m, am, serial));
+    REQUIRE(pricers::BinomialCRR::price_european_as<float>(m, eu, par) == pricers::BinomialCRR::price_european_as<float>(m, eu, serial));
+
+    const opt::Curve r({0.5, 1.0, 2.0}, {0.01, 0.03, 0.06}, opt::CurveInterp::PiecewiseLinear);
+    const opt::Curve q(0.02);
+    REQUIRE(pricers::BinomialCRR::price_american(m, am, par, r, q) == pricers::BinomialCRR::price_american(m, am, serial, r, q));
+    REQUIRE(pricers::BinomialCRR::price_european(m, eu, par, r, q) == pricers::BinomialCRR::price_european(m, eu, serial, r, q));
+
+    // The workspace path reuses the layer across thread counts
+    pricers::TreeWorkspace ws;
+    REQUIRE(pricers::BinomialCRR::price_american(m, am, par, ws) == pricers::BinomialCRR::price_american(m, am, serial));
+    REQUIRE(pricers::BinomialCRR::price_american(m, am, serial, ws) == pricers::BinomialCRR::price_american(m, am, serial));
+
+    // A truncated lattice ignores threads and stays serial
+    pricers::TreeParams trunc = par;
+    trunc.truncation_stddevs = 6.0;
+    pricers::TreeParams trunc_serial = serial;
+    trunc_serial.truncation_stddevs = 6.0;
+    REQUIRE(pricers::BinomialCRR::price_american(m, am, trunc) == pricers::BinomialCRR::price_american(m, am, trunc_serial));
+}